@@ -0,0 +1,8 @@
+# Everything but src/main.cpp as a static library, linked by
+# tools/headless-runner. chatterino-headless.pro builds both.
+
+TARGET   = chatterino-core
+TEMPLATE = lib
+CONFIG  += staticlib
+
+include(chatterino.pri)
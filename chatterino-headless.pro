@@ -0,0 +1,10 @@
+# Builds chatterino-core and tools/headless-runner, which runs the message
+# pipeline without any windows for soak tests and profiling.
+
+TEMPLATE = subdirs
+
+SUBDIRS = core runner
+
+core.file = chatterino-core.pro
+runner.file = tools/headless-runner/headless-runner.pro
+runner.depends = core
@@ -0,0 +1,131 @@
+# Everything chatterino consists of except for src/main.cpp. Included by
+# chatterino.pro, by chatterino-core.pro which builds it as a static library
+# and by projects that link that library (CONFIG += link_chatterino_core),
+# like tools/headless-runner.
+
+QT                += widgets core gui network multimedia svg concurrent
+CONFIG            += communi
+COMMUNI           += core model util
+
+INCLUDEPATH       += $$PWD/src/
+DEFINES           += CHATTERINO
+DEFINES           += AB_CUSTOM_THEME
+DEFINES           += AB_CUSTOM_SETTINGS
+CONFIG            += AB_NOT_STANDALONE
+
+useBreakpad {
+    LIBS += -L$$PWD/lib/qBreakpad/handler/build
+    include($$PWD/lib/qBreakpad/qBreakpad.pri)
+    DEFINES += C_USE_BREAKPAD
+}
+
+# use C++17
+CONFIG += c++17
+
+# C++17 backwards compatability
+win32-msvc* {
+    QMAKE_CXXFLAGS += /std:c++17
+} else {
+    QMAKE_CXXFLAGS += -std=c++17
+}
+
+linux {
+    LIBS += -lrt
+    QMAKE_LFLAGS += -lrt
+
+    # Enable linking libraries using PKGCONFIG += libraryname
+    CONFIG += link_pkgconfig
+}
+
+macx {
+    INCLUDEPATH += /usr/local/include
+    INCLUDEPATH += /usr/local/opt/openssl/include
+    LIBS += -L/usr/local/opt/openssl/lib
+}
+
+macx {
+    LIBS += -L/usr/local/lib
+}
+
+# Set C_DEBUG if it's a debug build
+CONFIG(debug, debug|release) {
+    DEFINES += C_DEBUG
+    DEFINES += QT_DEBUG
+} else {
+    DEFINES += NDEBUG
+}
+
+# Submodules
+include($$PWD/lib/warnings.pri)
+include($$PWD/lib/humanize.pri)
+include($$PWD/lib/libcommuni.pri)
+include($$PWD/lib/websocketpp.pri)
+include($$PWD/lib/wintoast.pri)
+include($$PWD/lib/signals.pri)
+include($$PWD/lib/settings.pri)
+include($$PWD/lib/serialize.pri)
+include($$PWD/lib/winsdk.pri)
+include($$PWD/lib/rapidjson.pri)
+include($$PWD/lib/qtkeychain.pri)
+
+exists( $$OUT_PWD/conanbuildinfo.pri ) {
+    message("Using conan packages")
+    CONFIG += conan_basic_setup
+    include($$OUT_PWD/conanbuildinfo.pri)
+    LIBS += -lGdi32
+}
+else{
+    include($$PWD/lib/boost.pri)
+    include($$PWD/lib/openssl.pri)
+}
+
+# Optional feature: QtWebEngine
+#exists ($(QTDIR)/include/QtWebEngine/QtWebEngine) {
+#    message(Using QWebEngine)
+#    QT += webenginewidgets
+#    DEFINES += "USEWEBENGINE"
+#}
+
+link_chatterino_core {
+    isEmpty(CHATTERINO_CORE_DIR) {
+        CHATTERINO_CORE_DIR = $$OUT_PWD/../..
+    }
+    LIBS += -L$$CHATTERINO_CORE_DIR -lchatterino-core
+    unix:PRE_TARGETDEPS += $$CHATTERINO_CORE_DIR/libchatterino-core.a
+
+    # resources aren't initialized automatically from static libraries
+    RESOURCES += \
+        $$PWD/resources/resources.qrc \
+        $$PWD/resources/resources_autogenerated.qrc
+} else {
+    PRECOMPILED_HEADER = $$PWD/src/PrecompiledHeader.hpp
+    CONFIG            += precompile_header
+
+    include($$PWD/chatterino-sources.pri)
+}
+
+git_commit=$$(GIT_COMMIT)
+git_release=$$(GIT_RELEASE)
+# Git data
+isEmpty(git_commit) {
+git_commit=$$system(git rev-parse HEAD)
+}
+isEmpty(git_release) {
+git_release=$$system(git describe)
+}
+git_hash = $$str_member($$git_commit, 0, 8)
+
+# Passing strings as defines requires you to use this weird triple-escape then quotation mark syntax.
+# https://stackoverflow.com/questions/3348711/add-a-define-to-qmake-with-a-value/18343449#18343449
+DEFINES += CHATTERINO_GIT_COMMIT=\\\"$$git_commit\\\"
+DEFINES += CHATTERINO_GIT_RELEASE=\\\"$$git_release\\\"
+DEFINES += CHATTERINO_GIT_HASH=\\\"$$git_hash\\\"
+
+CONFIG(debug, debug|release) {
+    message("Building Chatterino2 DEBUG")
+} else {
+    message("Building Chatterino2 RELEASE")
+    DEFINES += DEBUG_OFF
+}
+
+message("Injected git values: $$git_commit ($$git_release) $$git_hash")
@@ -1,14 +1,21 @@
 #include "Application.hpp"
 
+#include <QTimer>
 #include <atomic>
+#include <boost/core/demangle.hpp>
 
 #include "common/Args.hpp"
+#include "common/Env.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/commands/CommandController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/notifications/NotificationController.hpp"
+#include "debug/LoadTest.hpp"
+#include "debug/MemoryReport.hpp"
+#include "debug/MessageLatency.hpp"
+#include "debug/StartupTrace.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/chatterino/ChatterinoBadges.hpp"
@@ -39,6 +46,15 @@ namespace chatterino {
 
 static std::atomic<bool> isAppInitialized{false};
 
+namespace {
+    QString singletonName(const Singleton &singleton)
+    {
+        return QString::fromStdString(
+                   boost::core::demangle(typeid(singleton).name()))
+            .remove("chatterino::");
+    }
+}  // namespace
+
 Application *Application::instance = nullptr;
 
 // this class is responsible for handling the workflow of Chatterino
@@ -99,9 +115,17 @@ void Application::initialize(Settings &settings, Paths &paths)
 
     for (auto &singleton : this->singletons_)
     {
+        StartupTraceScope trace(singletonName(*singleton), "singleton");
         singleton->initialize(settings, paths);
     }
 
+    // emojis are parsed on a worker thread while the other singletons are
+    // initialized
+    {
+        StartupTraceScope trace("Emojis::waitUntilLoaded");
+        this->emotes->emojis.waitUntilLoaded();
+    }
+
     // add crash message
     if (getArgs().crashRecovery)
     {
@@ -130,6 +154,24 @@ void Application::initialize(Settings &settings, Paths &paths)
     this->initPubsub();
 }
 
+void Application::initializeHeadless(Settings &settings, Paths &paths)
+{
+    assert(isAppInitialized == false);
+    isAppInitialized = true;
+
+    for (auto &singleton : this->singletons_)
+    {
+        if (singleton.get() == this->windows)
+        {
+            continue;
+        }
+
+        singleton->initialize(settings, paths);
+    }
+
+    this->emotes->emojis.waitUntilLoaded();
+}
+
 int Application::run(QApplication &qtApp)
 {
     assert(isAppInitialized);
@@ -138,6 +180,30 @@ int Application::run(QApplication &qtApp)
 
     this->windows->getMainWindow().show();
 
+    if (StartupTrace::isEnabled())
+    {
+        // runs once the event loop processed the initial show and paint events
+        QTimer::singleShot(0, [] {
+            StartupTrace::write();
+        });
+    }
+
+    if (!getArgs().memoryReportPath.isEmpty())
+    {
+        MemoryReport::startPeriodicDump(getArgs().memoryReportPath, 60000);
+    }
+
+    if (!getArgs().latencyReportPath.isEmpty())
+    {
+        MessageLatency::startPeriodicDump(getArgs().latencyReportPath, 10000);
+    }
+
+    if (!getArgs().loadTestReportPath.isEmpty())
+    {
+        LoadTest::start(getArgs().loadTestReportPath,
+                        getArgs().loadTestDuration);
+    }
+
     getSettings()->betaUpdates.connect(
         [] {
             Updates::instance().checkForUpdates();
@@ -345,7 +411,10 @@ void Application::initPubsub()
         }
     });
 
-    this->twitch.pubsub->start();
+    if (!Env::get().offline)
+    {
+        this->twitch.pubsub->start();
+    }
 
     auto RequestModerationActions = [=]() {
         this->twitch.server->pubsub->unlistenAllModerationActions();
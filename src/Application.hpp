@@ -40,6 +40,8 @@ public:
     Application(Settings &settings, Paths &paths);
 
     void initialize(Settings &settings, Paths &paths);
+    // Initializes everything but the windows, used by tools/headless-runner
+    void initializeHeadless(Settings &settings, Paths &paths);
     void load();
     void save();
 
@@ -13,6 +13,7 @@
 #include "common/Modes.hpp"
 #include "common/NetworkManager.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTrace.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
@@ -161,9 +162,12 @@ namespace {
 
 void runGui(QApplication &a, Paths &paths, Settings &settings)
 {
-    initQt();
-    initResources();
-    initSignalHandler();
+    {
+        StartupTraceScope trace("initQt");
+        initQt();
+        initResources();
+        initSignalHandler();
+    }
 
     settings.restartOnCrash.connect([](const bool &value) {
         restartOnSignal = value;
@@ -213,8 +217,15 @@ void runGui(QApplication &a, Paths &paths, Settings &settings)
         createRunningFile(runningPath);
     }
 
+    auto constructStart = StartupTrace::now();
     Application app(settings, paths);
-    app.initialize(settings, paths);
+    StartupTrace::addEvent("Application::Application", "startup",
+                           constructStart,
+                           StartupTrace::now() - constructStart);
+    {
+        StartupTraceScope trace("Application::initialize");
+        app.initialize(settings, paths);
+    }
     app.run(a);
     app.save();
 
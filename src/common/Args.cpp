@@ -9,6 +9,8 @@
 #include <QStringList>
 #include "common/QLogging.hpp"
 
+#include <algorithm>
+
 namespace chatterino {
 
 Args::Args(const QApplication &app)
@@ -36,6 +38,30 @@ Args::Args(const QApplication &app)
         "specify platform. Only twitch channels are supported at the moment.\n"
         "If platform isn't specified, default is Twitch.",
         "t:channel1;t:channel2;..."));
+    parser.addOption(QCommandLineOption(
+        "trace-startup",
+        "Writes the duration of the startup phases as a Chrome trace to the "
+        "given file.",
+        "file"));
+    parser.addOption(QCommandLineOption(
+        "dump-memory-report",
+        "Writes the debug counters and the memory used by the messages of "
+        "each channel to the given file once a minute.",
+        "file"));
+    parser.addOption(QCommandLineOption(
+        "dump-latency-report",
+        "Writes how long messages take from being sent by twitch to being "
+        "shown, per stage and channel, to the given file every 10 seconds.",
+        "file"));
+    parser.addOption(QCommandLineOption(
+        "load-test",
+        "Measures the message throughput, GUI thread stalls and memory growth, "
+        "writes them to the given file and quits. Meant to be used together "
+        "with tools/replay-server, see tools/run-load-test.sh.",
+        "file"));
+    parser.addOption(QCommandLineOption(
+        "load-test-duration", "Duration of the load test, 60 by default.",
+        "seconds"));
 
     if (!parser.parse(app.arguments()))
     {
@@ -92,6 +118,15 @@ Args::Args(const QApplication &app)
 
     this->printVersion = parser.isSet("v");
     this->crashRecovery = parser.isSet("crash-recovery");
+    this->startupTracePath = parser.value("trace-startup");
+    this->memoryReportPath = parser.value("dump-memory-report");
+    this->latencyReportPath = parser.value("dump-latency-report");
+    this->loadTestReportPath = parser.value("load-test");
+    if (parser.isSet("load-test-duration"))
+    {
+        this->loadTestDuration =
+            std::max(1, parser.value("load-test-duration").toInt());
+    }
 }
 
 static Args *instance = nullptr;
@@ -15,6 +15,11 @@ public:
     bool crashRecovery{};
     bool shouldRunBrowserExtensionHost{};
     bool dontSaveSettings{};
+    QString startupTracePath{};
+    QString memoryReportPath{};
+    QString latencyReportPath{};
+    QString loadTestReportPath{};
+    int loadTestDuration{60};
     QJsonArray channelsToJoin{};
 };
 
@@ -1,6 +1,7 @@
 #include "common/Channel.hpp"
 
 #include "Application.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
@@ -18,6 +19,10 @@
 #include <QNetworkRequest>
 
 namespace chatterino {
+namespace {
+    // roughly one frame
+    constexpr int FLUSH_QUEUED_INTERVAL = 16;
+}  // namespace
 
 //
 // Channel
@@ -27,6 +32,11 @@ Channel::Channel(const QString &name, Type type)
     , name_(name)
     , type_(type)
 {
+    this->flushQueuedTimer_.setSingleShot(true);
+    this->flushQueuedTimer_.setInterval(FLUSH_QUEUED_INTERVAL);
+    QObject::connect(&this->flushQueuedTimer_, &QTimer::timeout, [this] {
+        this->flushQueuedMessages();
+    });
 }
 
 Channel::~Channel()
@@ -74,9 +84,23 @@ LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot()
     return this->messages_.getSnapshot();
 }
 
+int64_t Channel::messageMemoryUsage()
+{
+    auto snapshot = this->getMessageSnapshot();
+
+    int64_t usage = 0;
+    for (size_t i = 0; i < snapshot.size(); i++)
+    {
+        usage += snapshot[i]->memoryUsage();
+    }
+    return usage;
+}
+
 void Channel::addMessage(MessagePtr message,
                          boost::optional<MessageFlags> overridingFlags)
 {
+    this->flushQueuedMessages();
+
     auto app = getApp();
     MessagePtr deleted;
 
@@ -87,6 +111,7 @@ void Channel::addMessage(MessagePtr message,
         app->logging->addMessage(this->name_, message);
     }
 
+    message->latency.recordAdded(this);
     if (this->messages_.pushBack(message, deleted))
     {
         this->messageRemovedFromStart.invoke(deleted);
@@ -95,8 +120,69 @@ void Channel::addMessage(MessagePtr message,
     this->messageAppended.invoke(message, overridingFlags);
 }
 
+void Channel::addMessages(std::vector<MessagePtr> messages, bool log)
+{
+    if (messages.empty())
+    {
+        return;
+    }
+
+    // FOURTF: change this when adding more providers
+    if (log && this->isTwitchChannel())
+    {
+        auto app = getApp();
+        for (const auto &message : messages)
+        {
+            app->logging->addMessage(this->name_, message);
+        }
+    }
+
+    for (const auto &message : messages)
+    {
+        message->latency.recordAdded(this);
+    }
+
+    std::vector<MessagePtr> deleted;
+    this->messages_.pushBack(messages, deleted);
+
+    for (auto &message : deleted)
+    {
+        this->messageRemovedFromStart.invoke(message);
+    }
+
+    this->messagesAppended.invoke(messages);
+}
+
+void Channel::queueMessage(MessagePtr message)
+{
+    assertInGuiThread();
+
+    this->queuedMessages_.push_back(std::move(message));
+
+    if (!this->flushQueuedTimer_.isActive())
+    {
+        this->flushQueuedTimer_.start();
+    }
+}
+
+void Channel::flushQueuedMessages()
+{
+    if (this->queuedMessages_.empty())
+    {
+        return;
+    }
+
+    this->flushQueuedTimer_.stop();
+
+    std::vector<MessagePtr> messages;
+    std::swap(messages, this->queuedMessages_);
+    this->addMessages(std::move(messages));
+}
+
 void Channel::addOrReplaceTimeout(MessagePtr message)
 {
+    this->flushQueuedMessages();
+
     LimitedQueueSnapshot<MessagePtr> snapshot = this->getMessageSnapshot();
     int snapshotLength = snapshot.size();
 
@@ -192,6 +278,8 @@ void Channel::addOrReplaceTimeout(MessagePtr message)
 
 void Channel::disableAllMessages()
 {
+    this->flushQueuedMessages();
+
     LimitedQueueSnapshot<MessagePtr> snapshot = this->getMessageSnapshot();
     int snapshotLength = snapshot.size();
     for (int i = 0; i < snapshotLength; i++)
@@ -221,6 +309,8 @@ void Channel::addMessagesAtStart(std::vector<MessagePtr> &_messages)
 
 void Channel::replaceMessage(MessagePtr message, MessagePtr replacement)
 {
+    this->flushQueuedMessages();
+
     int index = this->messages_.replaceItem(message, replacement);
 
     if (index >= 0)
@@ -231,6 +321,8 @@ void Channel::replaceMessage(MessagePtr message, MessagePtr replacement)
 
 void Channel::replaceMessage(size_t index, MessagePtr replacement)
 {
+    this->flushQueuedMessages();
+
     if (this->messages_.replaceItem(index, replacement))
     {
         this->messageReplaced.invoke(index, replacement);
@@ -239,6 +331,8 @@ void Channel::replaceMessage(size_t index, MessagePtr replacement)
 
 void Channel::deleteMessage(QString messageID)
 {
+    this->flushQueuedMessages();
+
     LimitedQueueSnapshot<MessagePtr> snapshot = this->getMessageSnapshot();
     int snapshotLength = snapshot.size();
 
@@ -261,7 +355,7 @@ bool Channel::canSendMessage() const
     return false;
 }
 
-void Channel::sendMessage(const QString &message)
+void Channel::sendMessage(const QString &message, SendPriority priority)
 {
 }
 
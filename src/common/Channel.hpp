@@ -41,15 +41,21 @@ public:
         Misc
     };
 
+    // Messages typed by the user are sent before automated ones when the
+    // messages have to be queued because of rate limits
+    enum class SendPriority { Interactive, Automated };
+
     explicit Channel(const QString &name, Type type);
     virtual ~Channel();
 
     // SIGNALS
-    pajlada::Signals::Signal<const QString &, const QString &, bool &>
+    pajlada::Signals::Signal<const QString &, const QString &, SendPriority,
+                             bool &>
         sendMessageSignal;
     pajlada::Signals::Signal<MessagePtr &> messageRemovedFromStart;
     pajlada::Signals::Signal<MessagePtr &, boost::optional<MessageFlags>>
         messageAppended;
+    pajlada::Signals::Signal<std::vector<MessagePtr> &> messagesAppended;
     pajlada::Signals::Signal<std::vector<MessagePtr> &> messagesAddedAtStart;
     pajlada::Signals::Signal<size_t, MessagePtr &> messageReplaced;
     pajlada::Signals::NoArgSignal destroyed;
@@ -62,6 +68,8 @@ public:
     bool isTwitchChannel() const;
     virtual bool isEmpty() const;
     LimitedQueueSnapshot<MessagePtr> getMessageSnapshot();
+    // Approximate amount of memory used by the messages in the channel
+    int64_t messageMemoryUsage();
 
     // MESSAGES
     // overridingFlags can be filled in with flags that should be used instead
@@ -70,6 +78,17 @@ public:
     void addMessage(
         MessagePtr message,
         boost::optional<MessageFlags> overridingFlags = boost::none);
+    // Appends all messages at once, listeners are notified once through
+    // messagesAppended. Pass log = false for messages that were already
+    // logged by another channel
+    void addMessages(std::vector<MessagePtr> messages, bool log = true);
+    // Adds the message with the next batch instead of right away. Messages
+    // that arrive within the same frame are appended together so the splits
+    // only lay out and repaint once for all of them.
+    // Must be called from the GUI thread
+    void queueMessage(MessagePtr message);
+    // Appends the queued messages now
+    void flushQueuedMessages();
     void addMessagesAtStart(std::vector<MessagePtr> &messages_);
     void addOrReplaceTimeout(MessagePtr message);
     void disableAllMessages();
@@ -84,7 +103,9 @@ public:
 
     // CHANNEL INFO
     virtual bool canSendMessage() const;
-    virtual void sendMessage(const QString &message);
+    virtual void sendMessage(
+        const QString &message,
+        SendPriority priority = SendPriority::Automated);
     virtual bool isMod() const;
     virtual bool isBroadcaster() const;
     virtual bool hasModRights() const;
@@ -106,6 +127,9 @@ private:
     LimitedQueue<MessagePtr> messages_;
     Type type_;
     QTimer clearCompletionModelTimer_;
+
+    std::vector<MessagePtr> queuedMessages_;
+    QTimer flushQueuedTimer_;
 };
 
 using ChannelPtr = std::shared_ptr<Channel>;
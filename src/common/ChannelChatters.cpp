@@ -65,29 +65,23 @@ void ChannelChatters::addPartedUser(const QString &user)
     }
 }
 
-void ChannelChatters::setChatters(UsernameSet &&set)
+void ChannelChatters::updateChatters(const std::vector<QString> &names)
 {
-    this->chatters_.access()->merge(std::move(set));
+    // one lock, nothing may change the set between the diff and applying it.
+    // Only the names that changed are inserted or erased
+    auto chatters = this->chatters_.access();
+    chatters->apply(chatters->diff(names));
 }
 
 const QColor ChannelChatters::getUserColor(const QString &user)
 {
-    const auto chatterColors = this->chatterColors_.accessConst();
-
-    const auto search = chatterColors->find(user.toLower());
-    if (search == chatterColors->end())
-    {
-        // Returns an invalid color so we can decide not to override `textColor`
-        return QColor();
-    }
-
-    return search->second;
+    // Returns an invalid color so we can decide not to override `textColor`
+    return this->chatterColors_.get(user);
 }
 
 void ChannelChatters::setUserColor(const QString &user, const QColor &color)
 {
-    const auto chatterColors = this->chatterColors_.access();
-    chatterColors->insert_or_assign(user.toLower(), color);
+    this->chatterColors_.set(user, color);
 }
 
 }  // namespace chatterino
@@ -2,6 +2,7 @@
 
 #include "common/Channel.hpp"
 #include "common/UniqueAccess.hpp"
+#include "common/UserColorCache.hpp"
 #include "common/UsernameSet.hpp"
 
 namespace chatterino {
@@ -17,7 +18,10 @@ public:
     void addRecentChatter(const QString &user);
     void addJoinedUser(const QString &user);
     void addPartedUser(const QString &user);
-    void setChatters(UsernameSet &&set);
+    // Replaces the chatters with the given names, which have to be sorted by
+    // CaseInsensitiveLess without duplicates. Only the joins and parts are
+    // applied. Can be called from any thread.
+    void updateChatters(const std::vector<QString> &names);
     const QColor getUserColor(const QString &user);
     void setUserColor(const QString &user, const QColor &color);
 
@@ -26,7 +30,7 @@ private:
 
     // maps 2 char prefix to set of names
     UniqueAccess<UsernameSet> chatters_;
-    UniqueAccess<std::map<QString, QColor>> chatterColors_;
+    UserColorCache chatterColors_;
 
     // combines multiple joins/parts into one message
     UniqueAccess<QStringList> joinedUsers_;
@@ -17,6 +17,9 @@ public:
     const QString twitchServerHost;
     const uint16_t twitchServerPort;
     const bool twitchServerSecure;
+    // Only the twitch irc connection may use the network, all other requests
+    // fail right away. Used for load tests against a local replay server.
+    const bool offline;
 };
 
 }  // namespace chatterino
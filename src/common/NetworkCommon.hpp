@@ -21,4 +21,15 @@ enum class NetworkRequestType {
     Delete,
 };
 
+// When too many requests to one host are running, the queued requests are
+// started in this order
+enum class NetworkRequestPriority {
+    // the user is waiting for it
+    Interactive,
+    // images that are being shown
+    Image,
+    // anything that can wait
+    Background,
+};
+
 }  // namespace chatterino
@@ -1,5 +1,6 @@
 #include "common/NetworkPrivate.hpp"
 
+#include "common/Env.hpp"
 #include "common/NetworkManager.hpp"
 #include "common/NetworkResult.hpp"
 #include "common/Outcome.hpp"
@@ -9,24 +10,82 @@
 #include "util/PostToThread.hpp"
 
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QFile>
+#include <QHash>
 #include <QNetworkReply>
 #include <QtConcurrent>
 #include "common/QLogging.hpp"
 
+#include <array>
+#include <deque>
+#include <vector>
+
 namespace chatterino {
+namespace {
+    auto &networkDataCount = DebugCount::counter("NetworkData");
+    auto &requestsStarted = DebugCount::counter("http request started");
+    auto &requestsSucceeded = DebugCount::counter("http request success");
+    auto &cacheWrittenBytes = DebugCount::counter("network cache written",
+                                                  DebugCount::Unit::Bytes);
+    auto &cacheReadBytes =
+        DebugCount::counter("network cache read", DebugCount::Unit::Bytes);
+    auto &snapshotReadBytes =
+        DebugCount::counter("network snapshot read", DebugCount::Unit::Bytes);
+    auto &snapshotsUnchanged =
+        DebugCount::counter("network snapshot unchanged");
+    auto &requestsCoalesced = DebugCount::counter("http request coalesced");
+    auto &requestsQueued = DebugCount::counter("http request queued");
+
+    // bump this when the format of snapshot files changes
+    constexpr quint32 SNAPSHOT_VERSION = 1;
+
+    // more requests to the same host wait in NetworkScheduler::queued
+    constexpr int MAX_REQUESTS_PER_HOST = 6;
+    constexpr size_t PRIORITY_COUNT = 3;
+
+    // Only used on the network worker thread
+    struct NetworkScheduler {
+        // requests that wait for a running GET request with the same hash
+        QHash<QString, std::vector<std::shared_ptr<NetworkData>>> followers;
+        QHash<QString, int> runningPerHost;
+        std::array<std::deque<std::pair<std::shared_ptr<NetworkData>,
+                                        NetworkWorker *>>,
+                   PRIORITY_COUNT>
+            queued;
+    };
+
+    NetworkScheduler &networkScheduler()
+    {
+        static NetworkScheduler scheduler;
+        return scheduler;
+    }
+
+    // GET requests that nobody needs the reply of can share one reply
+    bool canCoalesce(const NetworkData &data)
+    {
+        return data.requestType_ == NetworkRequestType::Get &&
+               !data.onReplyCreated_ && !data.snapshot_;
+    }
+
+    QString snapshotPath(NetworkData &data)
+    {
+        return getPaths()->cacheDirectory() + "/" + data.getHash() +
+               ".snapshot";
+    }
+}  // namespace
 
 NetworkData::NetworkData()
     : lifetimeManager_(new QObject)
 {
-    DebugCount::increase("NetworkData");
+    networkDataCount.increase();
 }
 
 NetworkData::~NetworkData()
 {
     this->lifetimeManager_->deleteLater();
 
-    DebugCount::decrease("NetworkData");
+    networkDataCount.decrease();
 }
 
 QString NetworkData::getHash()
@@ -44,6 +103,7 @@ QString NetworkData::getHash()
         for (const auto &header : this->request_.rawHeaderList())
         {
             bytes.append(header);
+            bytes.append(this->request_.rawHeader(header));
         }
 
         QByteArray hashBytes(
@@ -66,78 +126,249 @@ void writeToCache(const std::shared_ptr<NetworkData> &data,
 
             if (cachedFile.open(QIODevice::WriteOnly))
             {
-                cachedFile.write(bytes);
+                cacheWrittenBytes.increase(cachedFile.write(bytes));
             }
         });
     }
 }
 
-void loadUncached(const std::shared_ptr<NetworkData> &data)
+// Passes the result of a coalesced request on to a request that waited for
+// it, or fails a request that couldn't be started
+void handleCoalesced(const std::shared_ptr<NetworkData> &data,
+                     QNetworkReply::NetworkError error, int status,
+                     const QByteArray &bytes, bool alreadyCached)
 {
-    DebugCount::increase("http request started");
-
-    NetworkRequester requester;
-    NetworkWorker *worker = new NetworkWorker;
+    auto success = error == QNetworkReply::NetworkError::NoError;
+    if (error == QNetworkReply::NetworkError::OperationCanceledError)
+    {
+        status = NetworkResult::timedoutStatus;
+    }
 
-    worker->moveToThread(&NetworkManager::workerThread);
+    if (success && !alreadyCached)
+    {
+        writeToCache(data, bytes);
+    }
 
-    auto onUrlRequested = [data, worker]() mutable {
-        if (data->hasTimeout_)
+    auto handle = [data, success, result = NetworkResult(bytes, status)] {
+        if (data->hasCaller_ && !data->caller_.get())
         {
-            data->timer_ = new QTimer();
-            data->timer_->setSingleShot(true);
-            data->timer_->start(data->timeoutMS_);
+            return;
         }
 
-        auto reply = [&]() -> QNetworkReply * {
-            switch (data->requestType_)
+        if (success)
+        {
+            requestsSucceeded.increase();
+            if (data->onSuccess_)
             {
-                case NetworkRequestType::Get:
-                    return NetworkManager::accessManager.get(data->request_);
+                data->onSuccess_(result);
+            }
+        }
+        else if (data->onError_)
+        {
+            data->onError_(result);
+        }
+
+        if (data->finally_)
+        {
+            data->finally_();
+        }
+    };
 
-                case NetworkRequestType::Put:
-                    return NetworkManager::accessManager.put(data->request_,
-                                                             data->payload_);
+    if (data->executeConcurrently_)
+    {
+        QtConcurrent::run(std::move(handle));
+    }
+    else
+    {
+        postToThread(std::move(handle));
+    }
+}
 
-                case NetworkRequestType::Delete:
-                    return NetworkManager::accessManager.deleteResource(
-                        data->request_);
+void startRequest(const std::shared_ptr<NetworkData> &data,
+                  NetworkWorker *worker);
 
-                case NetworkRequestType::Post:
-                    if (data->multiPartPayload_)
-                    {
-                        assert(data->payload_.isNull());
+// Frees the slot of a finished request, starts the queued requests that can
+// run now and returns the requests that waited for this one
+std::vector<std::shared_ptr<NetworkData>> finishRequest(
+    const std::shared_ptr<NetworkData> &data)
+{
+    auto &scheduler = networkScheduler();
 
-                        return NetworkManager::accessManager.post(
-                            data->request_, data->multiPartPayload_);
-                    }
-                    else
-                    {
-                        return NetworkManager::accessManager.post(
-                            data->request_, data->payload_);
-                    }
+    auto host = data->request_.url().host();
+    if (--scheduler.runningPerHost[host] <= 0)
+    {
+        scheduler.runningPerHost.remove(host);
+    }
+
+    std::vector<std::shared_ptr<NetworkData>> followers;
+    if (canCoalesce(*data))
+    {
+        followers = scheduler.followers.take(data->getHash());
+    }
+
+    // higher priorities first, in the order they were queued
+    for (auto &queue : scheduler.queued)
+    {
+        for (auto it = queue.begin(); it != queue.end();)
+        {
+            if (scheduler.runningPerHost.value(
+                    it->first->request_.url().host()) >= MAX_REQUESTS_PER_HOST)
+            {
+                ++it;
+                continue;
             }
-            return nullptr;
-        }();
 
-        if (reply == nullptr)
+            auto next = std::move(*it);
+            it = queue.erase(it);
+            startRequest(next.first, next.second);
+        }
+    }
+
+    return followers;
+}
+
+void startRequest(const std::shared_ptr<NetworkData> &data,
+                  NetworkWorker *worker)
+{
+    requestsStarted.increase();
+    networkScheduler().runningPerHost[data->request_.url().host()]++;
+
+    if (data->hasTimeout_)
+    {
+        data->timer_ = new QTimer();
+        data->timer_->setSingleShot(true);
+        data->timer_->start(data->timeoutMS_);
+    }
+
+    auto reply = [&]() -> QNetworkReply * {
+        switch (data->requestType_)
         {
-            qCDebug(chatterinoCommon) << "Unhandled request type";
-            return;
+            case NetworkRequestType::Get:
+                return NetworkManager::accessManager.get(data->request_);
+
+            case NetworkRequestType::Put:
+                return NetworkManager::accessManager.put(data->request_,
+                                                         data->payload_);
+
+            case NetworkRequestType::Delete:
+                return NetworkManager::accessManager.deleteResource(
+                    data->request_);
+
+            case NetworkRequestType::Post:
+                if (data->multiPartPayload_)
+                {
+                    assert(data->payload_.isNull());
+
+                    return NetworkManager::accessManager.post(
+                        data->request_, data->multiPartPayload_);
+                }
+                else
+                {
+                    return NetworkManager::accessManager.post(
+                        data->request_, data->payload_);
+                }
         }
+        return nullptr;
+    }();
+
+    if (reply == nullptr)
+    {
+        qCDebug(chatterinoCommon) << "Unhandled request type";
 
-        if (data->timer_ != nullptr && data->timer_->isActive())
+        // nothing will finish this request, neither the requests waiting for
+        // it nor the queue may be left hanging
+        auto followers = finishRequest(data);
+        followers.insert(followers.begin(), data);
+        for (const auto &request : followers)
         {
-            QObject::connect(
-                data->timer_, &QTimer::timeout, worker, [reply, data]() {
-                    qCDebug(chatterinoCommon) << "Aborted!";
-                    reply->abort();
+            handleCoalesced(request,
+                            QNetworkReply::NetworkError::ProtocolUnknownError,
+                            0, {}, true);
+        }
+
+        delete data->timer_;
+        data->timer_ = nullptr;
+        worker->deleteLater();
+        return;
+    }
+
+    if (data->timer_ != nullptr && data->timer_->isActive())
+    {
+        QObject::connect(
+            data->timer_, &QTimer::timeout, worker, [reply, data]() {
+                qCDebug(chatterinoCommon) << "Aborted!";
+                reply->abort();
+
+                if (data->onError_)
+                {
+                    postToThread([data] {
+                        data->onError_(NetworkResult(
+                            {}, NetworkResult::timedoutStatus));
+                    });
+                }
+
+                if (data->finally_)
+                {
+                    postToThread([data] {
+                        data->finally_();
+                    });
+                }
+            });
+    }
+
+    if (data->onReplyCreated_)
+    {
+        data->onReplyCreated_(reply);
+    }
+
+    if (data->timer_ != nullptr)
+    {
+        QObject::connect(reply, &QNetworkReply::finished, data->timer_,
+                         &QObject::deleteLater);
+    }
+
+    QObject::connect(
+        reply, &QNetworkReply::finished, worker, [data, reply, worker]() {
+            auto error = reply->error();
+            auto status =
+                reply->attribute(QNetworkRequest::HttpStatusCodeAttribute)
+                    .toInt();
+            auto bytes = error == QNetworkReply::NetworkError::NoError
+                             ? reply->readAll()
+                             : QByteArray();
+            auto etag = reply->rawHeader("ETag");
+            auto lastModified = reply->rawHeader("Last-Modified");
+            reply->deleteLater();
+
+            auto cached = data->cache_;
+            for (const auto &follower : finishRequest(data))
+            {
+                handleCoalesced(follower, error, status, bytes, cached);
+                cached = cached || follower->cache_;
+            }
+
+            auto handleReply = [data, error, status, bytes, etag,
+                                lastModified]() mutable {
+                if (data->hasCaller_ && !data->caller_.get())
+                {
+                    return;
+                }
+
+                // TODO(pajlada): A reply was received, kill the timeout timer
+                if (error != QNetworkReply::NetworkError::NoError)
+                {
+                    if (error ==
+                        QNetworkReply::NetworkError::OperationCanceledError)
+                    {
+                        // Operation cancelled, most likely timed out
+                        return;
+                    }
 
                     if (data->onError_)
                     {
-                        postToThread([data] {
-                            data->onError_(NetworkResult(
-                                {}, NetworkResult::timedoutStatus));
+                        // TODO: Should this always be run on the GUI thread?
+                        postToThread([data, status] {
+                            data->onError_(NetworkResult({}, status));
                         });
                     }
 
@@ -147,107 +378,203 @@ void loadUncached(const std::shared_ptr<NetworkData> &data)
                             data->finally_();
                         });
                     }
-                });
-        }
-
-        if (data->onReplyCreated_)
-        {
-            data->onReplyCreated_(reply);
-        }
-
-        auto handleReply = [data, reply]() mutable {
-            if (data->hasCaller_ && !data->caller_.get())
-            {
-                return;
-            }
+                    return;
+                }
 
-            // TODO(pajlada): A reply was received, kill the timeout timer
-            if (reply->error() != QNetworkReply::NetworkError::NoError)
-            {
-                if (reply->error() ==
-                    QNetworkReply::NetworkError::OperationCanceledError)
+                // the snapshot that was passed to onSuccess is still current
+                auto unchanged = data->snapshot_ && status == 304;
+                if (unchanged)
                 {
-                    // Operation cancelled, most likely timed out
-                    return;
+                    snapshotsUnchanged.increase();
+                }
+                else if (data->snapshot_)
+                {
+                    writeSnapshot(data, bytes, etag, lastModified);
                 }
 
-                if (data->onError_)
+                writeToCache(data, bytes);
+
+                NetworkResult result(bytes, status);
+
+                requestsSucceeded.increase();
+                // log("starting {}", data->request_.url().toString());
+                if (data->onSuccess_ && !unchanged)
                 {
-                    auto status = reply->attribute(
-                        QNetworkRequest::HttpStatusCodeAttribute);
-                    // TODO: Should this always be run on the GUI thread?
-                    postToThread([data, code = status.toInt()] {
-                        data->onError_(NetworkResult({}, code));
-                    });
+                    if (data->executeConcurrently_)
+                        QtConcurrent::run(
+                            [onSuccess = std::move(data->onSuccess_),
+                             result = std::move(result)] {
+                                onSuccess(result);
+                            });
+                    else
+                        data->onSuccess_(result);
                 }
+                // log("finished {}", data->request_.url().toString());
 
                 if (data->finally_)
                 {
-                    postToThread([data] {
+                    if (data->executeConcurrently_)
+                        QtConcurrent::run(
+                            [finally = std::move(data->finally_)] {
+                                finally();
+                            });
+                    else
                         data->finally_();
-                    });
                 }
-                return;
+            };
+
+            if (data->executeConcurrently_ || isGuiThread())
+            {
+                handleReply();
+                delete worker;
             }
+            else
+            {
+                postToThread(
+                    [worker, cb = std::move(handleReply)]() mutable {
+                        cb();
+                        delete worker;
+                    });
+            }
+        });
+}
 
-            QByteArray bytes = reply->readAll();
-            writeToCache(data, bytes);
+void writeSnapshot(const std::shared_ptr<NetworkData> &data,
+                   const QByteArray &bytes, const QByteArray &etag,
+                   const QByteArray &lastModified)
+{
+    QtConcurrent::run([path = snapshotPath(*data), bytes, etag, lastModified] {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return;
+        }
 
-            auto status =
-                reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+        QDataStream stream(&file);
+        stream << SNAPSHOT_VERSION << etag << lastModified << qCompress(bytes);
+        cacheWrittenBytes.increase(file.size());
+    });
+}
+
+// Passes the stored snapshot to onSuccess and makes the request conditional,
+// so the server only sends the response again if it changed.
+// Runs on the thread pool, before the request is made
+void loadSnapshot(const std::shared_ptr<NetworkData> &data)
+{
+    // the hash is computed before the conditional headers are added
+    QFile file(snapshotPath(*data));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
 
-            NetworkResult result(bytes, status.toInt());
+    QDataStream stream(&file);
+    quint32 version = 0;
+    QByteArray etag;
+    QByteArray lastModified;
+    QByteArray compressed;
+    stream >> version;
+    if (version != SNAPSHOT_VERSION)
+    {
+        return;
+    }
+    stream >> etag >> lastModified >> compressed;
 
-            DebugCount::increase("http request success");
-            // log("starting {}", data->request_.url().toString());
-            if (data->onSuccess_)
+    auto bytes = qUncompress(compressed);
+    if (stream.status() != QDataStream::Ok || bytes.isEmpty())
+    {
+        return;
+    }
+    snapshotReadBytes.increase(file.size());
+
+    if (data->onSuccess_)
+    {
+        NetworkResult result(bytes, 200);
+
+        if (data->executeConcurrently_)
+        {
+            // run right here rather than in another task, so it finishes
+            // before the onSuccess of the reply can start
+            if (!data->hasCaller_ || data->caller_.get())
             {
-                if (data->executeConcurrently_)
-                    QtConcurrent::run([onSuccess = std::move(data->onSuccess_),
-                                       result = std::move(result)] {
-                        onSuccess(result);
-                    });
-                else
-                    data->onSuccess_(result);
+                data->onSuccess_(result);
             }
-            // log("finished {}", data->request_.url().toString());
+        }
+        else
+        {
+            postToThread([data, result]() {
+                if (data->hasCaller_ && !data->caller_.get())
+                {
+                    return;
+                }
 
-            reply->deleteLater();
+                data->onSuccess_(result);
+            });
+        }
+    }
+
+    if (!etag.isEmpty())
+    {
+        data->request_.setRawHeader("If-None-Match", etag);
+    }
+    if (!lastModified.isEmpty())
+    {
+        data->request_.setRawHeader("If-Modified-Since", lastModified);
+    }
+}
+
+void loadUncached(const std::shared_ptr<NetworkData> &data)
+{
+    if (Env::get().offline)
+    {
+        if (data->onError_)
+        {
+            postToThread([data] {
+                data->onError_(
+                    NetworkResult({}, NetworkResult::offlineStatus));
+            });
+        }
+
+        if (data->finally_)
+        {
+            postToThread([data] {
+                data->finally_();
+            });
+        }
+        return;
+    }
+
+    NetworkRequester requester;
+    NetworkWorker *worker = new NetworkWorker;
 
-            if (data->finally_)
+    worker->moveToThread(&NetworkManager::workerThread);
+
+    auto onUrlRequested = [data, worker]() mutable {
+        auto &scheduler = networkScheduler();
+
+        if (canCoalesce(*data))
+        {
+            auto hash = data->getHash();
+            auto running = scheduler.followers.find(hash);
+            if (running != scheduler.followers.end())
             {
-                if (data->executeConcurrently_)
-                    QtConcurrent::run([finally = std::move(data->finally_)] {
-                        finally();
-                    });
-                else
-                    data->finally_();
+                requestsCoalesced.increase();
+                running->push_back(data);
+                delete worker;
+                return;
             }
-        };
+            scheduler.followers.insert(hash, {});
+        }
 
-        if (data->timer_ != nullptr)
+        auto host = data->request_.url().host();
+        if (scheduler.runningPerHost.value(host) >= MAX_REQUESTS_PER_HOST)
         {
-            QObject::connect(reply, &QNetworkReply::finished, data->timer_,
-                             &QObject::deleteLater);
+            requestsQueued.increase();
+            scheduler.queued[size_t(data->priority_)].push_back({data, worker});
+            return;
         }
 
-        QObject::connect(
-            reply, &QNetworkReply::finished, worker,
-            [data, handleReply, worker]() mutable {
-                if (data->executeConcurrently_ || isGuiThread())
-                {
-                    handleReply();
-                    delete worker;
-                }
-                else
-                {
-                    postToThread(
-                        [worker, cb = std::move(handleReply)]() mutable {
-                            cb();
-                            delete worker;
-                        });
-                }
-            });
+        startRequest(data, worker);
     };
 
     QObject::connect(&requester, &NetworkRequester::requestUrl, worker,
@@ -271,6 +598,7 @@ void loadCached(const std::shared_ptr<NetworkData> &data)
     {
         // XXX: check if bytes is empty?
         QByteArray bytes = cachedFile.readAll();
+        cacheReadBytes.increase(bytes.size());
         NetworkResult result(bytes, 200);
 
         if (data->onSuccess_)
@@ -327,6 +655,25 @@ void loadCached(const std::shared_ptr<NetworkData> &data)
 
 void load(const std::shared_ptr<NetworkData> &data)
 {
+    if (data->snapshot_)
+    {
+        // the snapshot adds the conditional headers, so the request is only
+        // made once it was read
+        QtConcurrent::run([data] {
+            loadSnapshot(data);
+
+            if (data->cache_)
+            {
+                loadCached(data);
+            }
+            else
+            {
+                loadUncached(data);
+            }
+        });
+        return;
+    }
+
     if (data->cache_)
     {
         QtConcurrent::run(loadCached, data);
@@ -39,6 +39,7 @@ struct NetworkData {
     bool hasCaller_{};
     QObjectRef<QObject> caller_;
     bool cache_{};
+    bool snapshot_{};
     bool executeConcurrently_{};
 
     NetworkReplyCreatedCallback onReplyCreated_;
@@ -47,6 +48,7 @@ struct NetworkData {
     NetworkFinallyCallback finally_;
 
     NetworkRequestType requestType_ = NetworkRequestType::Get;
+    NetworkRequestPriority priority_ = NetworkRequestPriority::Interactive;
 
     QByteArray payload_;
     // lifetime secured by lifetimeManager_
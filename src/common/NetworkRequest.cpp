@@ -48,6 +48,12 @@ NetworkRequest NetworkRequest::type(NetworkRequestType newRequestType) &&
     return std::move(*this);
 }
 
+NetworkRequest NetworkRequest::priority(NetworkRequestPriority priority) &&
+{
+    this->data->priority_ = priority;
+    return std::move(*this);
+}
+
 NetworkRequest NetworkRequest::caller(const QObject *caller) &&
 {
     if (caller)
@@ -166,16 +172,23 @@ NetworkRequest NetworkRequest::cache() &&
     return std::move(*this);
 }
 
+NetworkRequest NetworkRequest::snapshot() &&
+{
+    this->data->snapshot_ = true;
+    return std::move(*this);
+}
+
 void NetworkRequest::execute()
 {
     this->executed_ = true;
 
     // Only allow caching for GET request
-    if (this->data->cache_ &&
+    if ((this->data->cache_ || this->data->snapshot_) &&
         this->data->requestType_ != NetworkRequestType::Get)
     {
         qCDebug(chatterinoCommon) << "Can only cache GET requests!";
         this->data->cache_ = false;
+        this->data->snapshot_ = false;
     }
 
     // Can not have a caller and be concurrent at the same time.
@@ -38,6 +38,9 @@ public:
     ~NetworkRequest();
 
     NetworkRequest type(NetworkRequestType newRequestType) &&;
+    /// Identical GET requests that are running at the same time share one
+    /// reply, the priority only matters while waiting for a free connection.
+    NetworkRequest priority(NetworkRequestPriority priority) &&;
 
     NetworkRequest onReplyCreated(NetworkReplyCreatedCallback cb) &&;
     NetworkRequest onError(NetworkErrorCallback cb) &&;
@@ -46,6 +49,12 @@ public:
 
     NetworkRequest payload(const QByteArray &payload) &&;
     NetworkRequest cache() &&;
+    /// Stores the response on disk. The next time, the stored one is read on
+    /// the thread pool and passed to onSuccess before the request is made,
+    /// like any other result. The request is
+    /// then sent with If-None-Match/If-Modified-Since and onSuccess is only
+    /// called a second time if the response changed.
+    NetworkRequest snapshot() &&;
     /// NetworkRequest makes sure that the `caller` object still exists when the
     /// callbacks are executed. Cannot be used with concurrent() since we can't
     /// make sure that the object doesn't get deleted while the callback is
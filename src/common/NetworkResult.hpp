@@ -23,6 +23,7 @@ public:
     int status() const;
 
     static constexpr int timedoutStatus = -2;
+    static constexpr int offlineStatus = -3;
 
 private:
     QByteArray data_;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace chatterino {
+
+/// Holds a value that is built once, replaced rarely and read often, from any
+/// thread. Reading it is a single atomic load of a shared_ptr.
+///
+/// Readers keep the value they got alive, a replaced value is freed once the
+/// last of them is done with it.
+template <typename T>
+class Published : boost::noncopyable
+{
+public:
+    /// Returns nullptr if nothing was published yet
+    std::shared_ptr<const T> get() const
+    {
+        return std::atomic_load(&this->current_);
+    }
+
+    void publish(std::shared_ptr<const T> value)
+    {
+        std::atomic_store(&this->current_, std::move(value));
+    }
+
+private:
+    std::shared_ptr<const T> current_;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,238 @@
+#include "common/UserColorCache.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+namespace {
+    auto &lookups = DebugCount::counter("user color cache lookups");
+    auto &hits = DebugCount::counter("user color cache hits");
+    auto &entries = DebugCount::counter("user color cache entries");
+    auto &evictions = DebugCount::counter("user color cache evictions");
+
+    // slot: 1 bit filled, 39 bits fingerprint, 24 bits color
+    constexpr uint64_t FILLED = 1ull << 63;
+    constexpr int FINGERPRINT_SHIFT = 24;
+    constexpr uint64_t FINGERPRINT_MASK = (1ull << 39) - 1;
+    constexpr uint64_t COLOR_MASK = 0xffffff;
+
+    size_t roundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    uint64_t fingerprintOfHash(uint64_t hash)
+    {
+        return hash >> (64 - 39);
+    }
+
+    uint64_t fingerprintOfSlot(uint64_t slot)
+    {
+        return (slot >> FINGERPRINT_SHIFT) & FINGERPRINT_MASK;
+    }
+}  // namespace
+
+UserColorCache::Table::Table(size_t capacity)
+    : mask(capacity - 1)
+    , slots(new std::atomic<uint64_t>[capacity])
+    , referenced(new std::atomic<bool>[capacity])
+    , clockHands(new uint8_t[capacity / GROUP_SIZE]())
+{
+    for (size_t i = 0; i < capacity; i++)
+    {
+        this->slots[i].store(0, std::memory_order_relaxed);
+        this->referenced[i].store(false, std::memory_order_relaxed);
+    }
+}
+
+UserColorCache::UserColorCache(size_t maxCapacity)
+    : maxCapacity_(std::max(GROUP_SIZE, roundUpToPowerOfTwo(maxCapacity)))
+{
+    this->tables_.push_back(std::make_unique<Table>(
+        std::min(INITIAL_CAPACITY, this->maxCapacity_)));
+    this->table_.store(this->tables_.back().get(), std::memory_order_release);
+}
+
+UserColorCache::~UserColorCache()
+{
+    entries.decrease(this->size());
+}
+
+uint64_t UserColorCache::hash(const QString &user)
+{
+    // FNV-1a, lower casing on the fly saves us a copy of the name
+    uint64_t hash = 14695981039346656037ull;
+    for (auto c : user)
+    {
+        hash ^= c.toLower().unicode();
+        hash *= 1099511628211ull;
+    }
+
+    // the last characters barely change the high bits, which pick the group
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+QColor UserColorCache::get(const QString &user) const
+{
+    lookups.increase();
+
+    auto fingerprint = fingerprintOfHash(UserColorCache::hash(user));
+    const auto &table = *this->table_.load(std::memory_order_acquire);
+    auto group = fingerprint & table.mask & ~(GROUP_SIZE - 1);
+
+    for (size_t i = group; i < group + GROUP_SIZE; i++)
+    {
+        auto slot = table.slots[i].load(std::memory_order_relaxed);
+        if (slot != 0 && fingerprintOfSlot(slot) == fingerprint)
+        {
+            // only write when needed so the cache line stays shared
+            if (!table.referenced[i].load(std::memory_order_relaxed))
+            {
+                table.referenced[i].store(true, std::memory_order_relaxed);
+            }
+
+            hits.increase();
+            return QColor::fromRgb(QRgb(slot & COLOR_MASK));
+        }
+    }
+
+    return QColor();
+}
+
+void UserColorCache::set(const QString &user, const QColor &color)
+{
+    auto fingerprint = fingerprintOfHash(UserColorCache::hash(user));
+    auto value = color.isValid() ? FILLED |
+                                       (fingerprint << FINGERPRINT_SHIFT) |
+                                       (uint64_t(color.rgb()) & COLOR_MASK)
+                                 : 0;
+
+    std::lock_guard<std::mutex> lock(this->writeMutex_);
+
+    auto *table = this->table_.load(std::memory_order_relaxed);
+    auto group = fingerprint & table->mask & ~(GROUP_SIZE - 1);
+
+    // already cached
+    for (size_t i = group; i < group + GROUP_SIZE; i++)
+    {
+        auto slot = table->slots[i].load(std::memory_order_relaxed);
+        if (slot != 0 && fingerprintOfSlot(slot) == fingerprint)
+        {
+            if (slot != value)
+            {
+                table->slots[i].store(value, std::memory_order_relaxed);
+            }
+            if (value == 0)
+            {
+                this->size_.fetch_sub(1, std::memory_order_relaxed);
+                entries.decrease();
+            }
+            return;
+        }
+    }
+
+    if (value == 0)
+    {
+        return;
+    }
+
+    while (true)
+    {
+        // free slot
+        for (size_t i = group; i < group + GROUP_SIZE; i++)
+        {
+            if (table->slots[i].load(std::memory_order_relaxed) == 0)
+            {
+                table->referenced[i].store(true, std::memory_order_relaxed);
+                table->slots[i].store(value, std::memory_order_relaxed);
+                this->size_.fetch_add(1, std::memory_order_relaxed);
+                entries.increase();
+                return;
+            }
+        }
+
+        if (table->mask + 1 >= this->maxCapacity_)
+        {
+            break;
+        }
+
+        this->grow();
+        table = this->table_.load(std::memory_order_relaxed);
+        group = fingerprint & table->mask & ~(GROUP_SIZE - 1);
+    }
+
+    // evict the first slot that wasn't looked up since the hand last passed
+    // it, this takes at most two rounds
+    auto &hand = table->clockHands[group / GROUP_SIZE];
+    while (true)
+    {
+        auto i = group + hand;
+        hand = (hand + 1) % GROUP_SIZE;
+
+        if (table->referenced[i].load(std::memory_order_relaxed))
+        {
+            table->referenced[i].store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        table->referenced[i].store(true, std::memory_order_relaxed);
+        table->slots[i].store(value, std::memory_order_relaxed);
+        evictions.increase();
+        return;
+    }
+}
+
+void UserColorCache::grow()
+{
+    const auto &old = *this->table_.load(std::memory_order_relaxed);
+    auto table = std::make_unique<Table>((old.mask + 1) * 2);
+
+    // the group of every entry is either the same or the one right after
+    // the old table's end, neither can be full
+    for (size_t i = 0; i <= old.mask; i++)
+    {
+        auto slot = old.slots[i].load(std::memory_order_relaxed);
+        if (slot == 0)
+        {
+            continue;
+        }
+
+        auto group =
+            fingerprintOfSlot(slot) & table->mask & ~(GROUP_SIZE - 1);
+        for (auto j = group; j < group + GROUP_SIZE; j++)
+        {
+            if (table->slots[j].load(std::memory_order_relaxed) == 0)
+            {
+                table->slots[j].store(slot, std::memory_order_relaxed);
+                table->referenced[j].store(
+                    old.referenced[i].load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+
+    this->table_.store(table.get(), std::memory_order_release);
+    this->tables_.push_back(std::move(table));
+}
+
+size_t UserColorCache::capacity() const
+{
+    return this->table_.load(std::memory_order_acquire)->mask + 1;
+}
+
+size_t UserColorCache::size() const
+{
+    return this->size_.load(std::memory_order_relaxed);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QColor>
+#include <QString>
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+/// Bounded cache of user name colors, used by ChannelChatters.
+///
+/// Names are stored as 64 bit hashes of their lower case form, a slot packs
+/// 39 bits of that hash together with the color into one atomic word. That
+/// makes reads lock free and keeps the memory use bounded no matter how many
+/// users talk in a channel.
+/// Every name can only live in one group of 8 slots. The table starts small
+/// and doubles whenever a group is full, until it reaches the maximum
+/// capacity. From then on full groups are evicted with the CLOCK algorithm,
+/// names that were looked up recently get a second chance.
+///
+/// Reads are lock free, writes are serialized by a mutex.
+class UserColorCache : boost::noncopyable
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 8192;
+    static constexpr size_t INITIAL_CAPACITY = 128;
+
+    // maxCapacity gets rounded up to a power of two
+    explicit UserColorCache(size_t maxCapacity = DEFAULT_CAPACITY);
+    ~UserColorCache();
+
+    // Returns an invalid color if the user isn't cached
+    QColor get(const QString &user) const;
+    // Setting an invalid color removes the user
+    void set(const QString &user, const QColor &color);
+
+    size_t capacity() const;
+    size_t size() const;
+
+private:
+    static constexpr size_t GROUP_SIZE = 8;
+
+    struct Table {
+        explicit Table(size_t capacity);
+
+        size_t mask;
+        // 0 is an empty slot, filled slots have their highest bit set
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+        std::unique_ptr<std::atomic<bool>[]> referenced;
+        // next slot of every group to look at when evicting
+        std::unique_ptr<uint8_t[]> clockHands;
+    };
+
+    // case insensitive
+    static uint64_t hash(const QString &user);
+
+    // Moves all entries into a table twice the size
+    void grow();
+
+    size_t maxCapacity_;
+    std::atomic<Table *> table_{nullptr};
+    std::atomic<size_t> size_{0};
+
+    std::mutex writeMutex_;
+    // Readers may still use a replaced table, so they're only freed with the
+    // cache. All of them together are smaller than the current one.
+    std::vector<std::unique_ptr<Table>> tables_;
+};
+
+}  // namespace chatterino
@@ -1,5 +1,8 @@
 #include "UsernameSet.hpp"
 
+#include "util/StringPool.hpp"
+
+#include <iterator>
 #include <tuple>
 
 namespace chatterino {
@@ -73,8 +76,9 @@ std::pair<UsernameSet::Iterator, bool> UsernameSet::insert(const QString &value)
         return pair;
     }
 
-    this->insertPrefix(value);
-    return this->items.insert(value);
+    auto interned = StringPool::intern(value);
+    this->insertPrefix(interned);
+    return this->items.insert(std::move(interned));
 }
 
 std::pair<UsernameSet::Iterator, bool> UsernameSet::insert(QString &&value)
@@ -85,6 +89,7 @@ std::pair<UsernameSet::Iterator, bool> UsernameSet::insert(QString &&value)
         return pair;
     }
 
+    value = StringPool::intern(value);
     this->insertPrefix(value);
     return this->items.insert(std::move(value));
 }
@@ -102,22 +107,74 @@ bool UsernameSet::contains(const QString &value) const
     return this->items.count(value) == 1;
 }
 
-void UsernameSet::merge(UsernameSet &&set)
+void UsernameSet::erase(const QString &value)
+{
+    auto it = this->items.find(value);
+    if (it == this->items.end())
+    {
+        return;
+    }
+
+    // names with the same prefix are next to each other
+    Prefix prefix(*it);
+    auto first = this->firstKeyForPrefix.find(prefix);
+    if (first != this->firstKeyForPrefix.end() &&
+        first->second.compare(*it, Qt::CaseInsensitive) == 0)
+    {
+        auto next = std::next(it);
+        if (next != this->items.end() && prefix.isStartOf(*next))
+        {
+            first->second = *next;
+        }
+        else
+        {
+            this->firstKeyForPrefix.erase(first);
+        }
+    }
+
+    this->items.erase(it);
+}
+
+UsernameSet::Diff UsernameSet::diff(const std::vector<QString> &names) const
 {
-    for (auto it = this->items.begin(); it != this->items.end();)
+    CaseInsensitiveLess less;
+    Diff diff;
+
+    auto it = this->items.begin();
+    auto name = names.begin();
+    while (it != this->items.end() || name != names.end())
     {
-        auto iter = set.items.find(*it);
-        if (iter == set.items.end())
+        if (name == names.end() ||
+            (it != this->items.end() && less(*it, *name)))
         {
-            it = this->items.erase(it);
+            diff.parted.push_back(*it);
+            ++it;
+        }
+        else if (it == this->items.end() || less(*name, *it))
+        {
+            diff.joined.push_back(*name);
+            ++name;
         }
         else
         {
             ++it;
+            ++name;
         }
     }
-    this->items.merge(set.items);
-    this->firstKeyForPrefix = set.firstKeyForPrefix;
+
+    return diff;
+}
+
+void UsernameSet::apply(Diff &&diff)
+{
+    for (const auto &name : diff.parted)
+    {
+        this->erase(name);
+    }
+    for (auto &name : diff.joined)
+    {
+        this->insert(std::move(name));
+    }
 }
 
 //
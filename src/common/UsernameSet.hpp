@@ -4,6 +4,7 @@
 #include <functional>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 namespace chatterino {
 
@@ -54,6 +55,11 @@ public:
     using Iterator = std::set<QString>::iterator;
     using ConstIterator = std::set<QString>::const_iterator;
 
+    struct Diff {
+        std::vector<QString> joined;
+        std::vector<QString> parted;
+    };
+
     class Range
     {
     public:
@@ -77,7 +83,14 @@ public:
     std::pair<Iterator, bool> insert(QString &&value);
 
     bool contains(const QString &value) const;
-    void merge(UsernameSet &&set);
+    void erase(const QString &value);
+
+    /// Names to insert and erase to end up with exactly the given names.
+    /// names must be sorted by CaseInsensitiveLess and must not contain any
+    /// duplicates. Takes one walk over both, no matter how few names changed.
+    Diff diff(const std::vector<QString> &names) const;
+    /// Only touches the names in the diff, the rest of the set stays as is
+    void apply(Diff &&diff);
 
 private:
     void insertPrefix(const QString &string);
@@ -0,0 +1,128 @@
+#include "controllers/filters/FilterCache.hpp"
+
+#include "Application.hpp"
+#include "controllers/filters/FilterRecord.hpp"
+#include "messages/Message.hpp"
+#include "providers/twitch/TwitchIrcServer.hpp"
+#include "singletons/Settings.hpp"
+
+namespace chatterino {
+namespace {
+    // Message::filterCache: 16 bit generation, 24 bits for the filters that
+    // ran and 24 bits for the filters that passed
+    constexpr int SLOT_COUNT = 24;
+    constexpr int EVALUATED_SHIFT = 24;
+    constexpr int GENERATION_SHIFT = 48;
+
+    // FilterRecord::cacheKey_: 16 bit generation, 16 bit slot
+    constexpr uint32_t NO_SLOT = 0xffff;
+
+    // generation 0 is never used, it marks messages that have an empty cache
+    uint16_t currentGeneration = 0;
+
+    // the watching channel the cached results were computed with
+    std::weak_ptr<Channel> cachedWatchingChannel;
+
+    uint16_t keyGeneration(uint32_t key)
+    {
+        return uint16_t(key >> 16);
+    }
+
+    uint32_t keySlot(uint32_t key)
+    {
+        return key & 0xffff;
+    }
+
+    uint16_t cacheGeneration(uint64_t cache)
+    {
+        return uint16_t(cache >> GENERATION_SHIFT);
+    }
+}  // namespace
+
+void FilterCache::initialize()
+{
+    static bool initialized = false;
+    if (initialized)
+    {
+        return;
+    }
+    initialized = true;
+
+    assignSlots();
+    getCSettings().filterRecords.delayedItemsChanged.connect([] {
+        FilterCache::assignSlots();
+    });
+}
+
+void FilterCache::assignSlots()
+{
+    currentGeneration =
+        currentGeneration == 0xffff ? 1 : uint16_t(currentGeneration + 1);
+
+    auto records = getCSettings().filterRecords.readOnly();
+    for (size_t i = 0; i < records->size(); i++)
+    {
+        auto slot = i < SLOT_COUNT ? uint32_t(i) : NO_SLOT;
+        (*records)[i]->cacheKey_ = (uint32_t(currentGeneration) << 16) | slot;
+    }
+}
+
+boost::optional<bool> FilterCache::get(const FilterRecord &record,
+                                       const Message &message)
+{
+    // channel.watching of every message may have changed. Checked here
+    // rather than on getChannelChanged, splits reload their messages on
+    // that signal and might run before us.
+    auto watching = getApp()->twitch.server->watchingChannel.get();
+    if (watching != cachedWatchingChannel.lock())
+    {
+        cachedWatchingChannel = watching;
+        assignSlots();
+    }
+
+    auto key = record.cacheKey_;
+    auto cache = message.filterCache;
+    if (keySlot(key) == NO_SLOT ||
+        cacheGeneration(cache) != keyGeneration(key))
+    {
+        return boost::none;
+    }
+
+    auto bit = uint64_t(1) << keySlot(key);
+    if (!(cache & (bit << EVALUATED_SHIFT)))
+    {
+        return boost::none;
+    }
+    return bool(cache & bit);
+}
+
+void FilterCache::set(const FilterRecord &record, const Message &message,
+                      bool passed)
+{
+    auto key = record.cacheKey_;
+    if (keySlot(key) == NO_SLOT)
+    {
+        return;
+    }
+
+    auto generation = keyGeneration(key);
+    auto &cache = message.filterCache;
+    if (cacheGeneration(cache) != generation)
+    {
+        // the results are from filters that changed since
+        cache = uint64_t(generation) << GENERATION_SHIFT;
+    }
+
+    auto bit = uint64_t(1) << keySlot(key);
+    cache |= bit << EVALUATED_SHIFT;
+    if (passed)
+    {
+        cache |= bit;
+    }
+    else
+    {
+        cache &= ~bit;
+    }
+}
+
+}  // namespace chatterino
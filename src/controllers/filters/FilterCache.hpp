@@ -0,0 +1,39 @@
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+
+namespace chatterino {
+
+class FilterRecord;
+struct Message;
+
+/// Remembers the results of the filters in Message::filterCache so every
+/// filter runs at most once per message, no matter how many splits or
+/// searches use it.
+///
+/// Every filter gets one of 24 slots in the cache, the slots are assigned
+/// again and all cached results are dropped whenever the filters change.
+/// Filters beyond the 24th aren't cached. The results are also dropped when
+/// the watching channel changes, channel.watching depends on it.
+/// Must be used from the GUI thread, like the filters themselves.
+class FilterCache
+{
+public:
+    // Assigns the slots and reassigns them when the filters change.
+    // Calling it again does nothing
+    static void initialize();
+
+    // The cached result of the filter for the message, none if the filter
+    // didn't run on it yet
+    static boost::optional<bool> get(const FilterRecord &record,
+                                     const Message &message);
+    static void set(const FilterRecord &record, const Message &message,
+                    bool passed);
+
+private:
+    static void assignSlots();
+};
+
+}  // namespace chatterino
@@ -15,6 +15,8 @@
 
 namespace chatterino {
 
+class FilterCache;
+
 class FilterRecord
 {
 public:
@@ -76,6 +78,11 @@ private:
     QUuid id_;
 
     std::unique_ptr<filterparser::FilterParser> parser_;
+
+    // where the results of this filter are cached on the messages, assigned
+    // by the FilterCache
+    friend class FilterCache;
+    mutable uint32_t cacheKey_ = 0xffff;
 };
 
 using FilterRecordPtr = std::shared_ptr<FilterRecord>;
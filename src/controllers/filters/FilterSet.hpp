@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/filters/FilterCache.hpp"
 #include "controllers/filters/FilterRecord.hpp"
 #include "singletons/Settings.hpp"
 
@@ -10,6 +11,8 @@ class FilterSet
 public:
     FilterSet()
     {
+        FilterCache::initialize();
+
         this->listener_ =
             getCSettings().filterRecords.delayedItemsChanged.connect([this] {
                 this->reloadFilters();
@@ -18,6 +21,8 @@ public:
 
     FilterSet(const QList<QUuid> &filterIds)
     {
+        FilterCache::initialize();
+
         auto filters = getCSettings().filterRecords.readOnly();
         for (const auto &f : *filters)
         {
@@ -41,10 +46,24 @@ public:
         if (this->filters_.size() == 0)
             return true;
 
-        filterparser::ContextMap context = filterparser::buildContextMap(m);
-        for (const auto &f : this->filters_.values())
+        // the context is only built if a filter has to run
+        boost::optional<filterparser::ContextMap> context;
+        for (const auto &f : this->filters_)
         {
-            if (!f->valid() || !f->filter(context))
+            if (!f->valid())
+                return false;
+
+            auto passed = FilterCache::get(*f, *m);
+            if (!passed)
+            {
+                if (!context)
+                    context = filterparser::buildContextMap(m);
+
+                passed = f->filter(*context);
+                FilterCache::set(*f, *m, *passed);
+            }
+
+            if (!*passed)
                 return false;
         }
 
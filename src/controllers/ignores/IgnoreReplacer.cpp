@@ -0,0 +1,377 @@
+#include "controllers/ignores/IgnoreReplacer.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <tuple>
+
+namespace chatterino {
+namespace {
+    // Backreferences and recursion refer to groups by number, named groups
+    // must be unique, verbs must come first and \Q quotes until \E. None of
+    // them survive being wrapped into an alternation with other patterns.
+    const QRegularExpression STANDALONE_SYNTAX(
+        R"(\\[1-9gkQ]|\(\?(P?<[A-Za-z_]|P[=>]|'|[-+]?\d|R|&)|\(\*)");
+
+    ushort fold(QChar c)
+    {
+        return c.toCaseFolded().unicode();
+    }
+
+    QRegularExpression::PatternOptions regexOptions(bool isCaseSensitive)
+    {
+        if (isCaseSensitive)
+        {
+            return QRegularExpression::UseUnicodePropertiesOption;
+        }
+        return QRegularExpression::CaseInsensitiveOption |
+               QRegularExpression::UseUnicodePropertiesOption;
+    }
+}  // namespace
+
+struct IgnoreReplacer::RegexCursor {
+    // -1 for the combined regex
+    int rule = -1;
+    bool exhausted = false;
+    Match match;
+};
+
+IgnoreReplacer::IgnoreReplacer(std::vector<Rule> rules)
+    : rules_(std::move(rules))
+{
+    this->nodes_.emplace_back();
+    this->regexes_.resize(this->rules_.size());
+
+    QStringList combinedParts;
+    for (int i = 0; i < int(this->rules_.size()); i++)
+    {
+        const auto &rule = this->rules_[i];
+        if (rule.pattern.isEmpty())
+        {
+            continue;
+        }
+
+        if (!rule.isRegex)
+        {
+            this->addLiteral(i);
+            continue;
+        }
+
+        auto &regex = this->regexes_[i];
+        regex = QRegularExpression(rule.pattern,
+                                   regexOptions(rule.isCaseSensitive));
+        if (!regex.isValid())
+        {
+            continue;
+        }
+        regex.optimize();
+
+        // a rule matching nothing would be taken at every position of the
+        // combined regex, hiding the rules after it
+        if (rule.pattern.contains(STANDALONE_SYNTAX) ||
+            regex.match(QString()).hasMatch())
+        {
+            this->separateRules_.push_back(i);
+            continue;
+        }
+
+        combinedParts.append((rule.isCaseSensitive ? "(?-i:" : "(?i:") +
+                             rule.pattern + ")");
+        this->combinedRules_.push_back(i);
+    }
+
+    this->linkLiterals();
+
+    if (!this->combinedRules_.empty())
+    {
+        this->combined_ = QRegularExpression(
+            combinedParts.join('|'),
+            QRegularExpression::UseUnicodePropertiesOption);
+        if (this->combined_.isValid())
+        {
+            this->combined_.optimize();
+        }
+        else
+        {
+            // some syntax we didn't think of, match them one by one
+            this->separateRules_.insert(this->separateRules_.end(),
+                                        this->combinedRules_.begin(),
+                                        this->combinedRules_.end());
+            std::sort(this->separateRules_.begin(),
+                      this->separateRules_.end());
+            this->combinedRules_.clear();
+        }
+    }
+}
+
+bool IgnoreReplacer::empty() const
+{
+    return this->literals_.empty() && this->combinedRules_.empty() &&
+           this->separateRules_.empty();
+}
+
+void IgnoreReplacer::addLiteral(int rule)
+{
+    const auto &pattern = this->rules_[rule].pattern;
+
+    int node = 0;
+    for (auto c : pattern)
+    {
+        auto folded = fold(c);
+        auto next = this->child(node, folded);
+        if (next == -1)
+        {
+            next = int(this->nodes_.size());
+            this->nodes_.emplace_back();
+
+            auto &children = this->nodes_[node].children;
+            children.insert(
+                std::lower_bound(children.begin(), children.end(),
+                                 std::make_pair(folded, 0)),
+                std::make_pair(folded, next));
+        }
+        node = next;
+    }
+
+    this->nodes_[node].literals.push_back(int(this->literals_.size()));
+    this->literals_.push_back(
+        {pattern, rule, this->rules_[rule].isCaseSensitive});
+}
+
+void IgnoreReplacer::linkLiterals()
+{
+    // breadth first, the fail links of shorter prefixes are needed first
+    std::deque<int> queue;
+    for (const auto &child : this->nodes_[0].children)
+    {
+        queue.push_back(child.second);
+    }
+
+    while (!queue.empty())
+    {
+        auto node = queue.front();
+        queue.pop_front();
+
+        for (const auto &child : this->nodes_[node].children)
+        {
+            auto fail = this->nodes_[node].fail;
+            while (fail != 0 && this->child(fail, child.first) == -1)
+            {
+                fail = this->nodes_[fail].fail;
+            }
+            auto target = this->child(fail, child.first);
+            if (target == -1 || target == child.second)
+            {
+                target = 0;
+            }
+
+            auto &next = this->nodes_[child.second];
+            next.fail = target;
+            next.outputLink = this->nodes_[target].literals.empty()
+                                  ? this->nodes_[target].outputLink
+                                  : target;
+
+            queue.push_back(child.second);
+        }
+    }
+}
+
+int IgnoreReplacer::child(int node, ushort c) const
+{
+    const auto &children = this->nodes_[node].children;
+    auto it = std::lower_bound(children.begin(), children.end(),
+                               std::make_pair(c, 0));
+    if (it == children.end() || it->first != c)
+    {
+        return -1;
+    }
+    return it->second;
+}
+
+std::vector<IgnoreReplacer::Match> IgnoreReplacer::findLiterals(
+    const QString &text) const
+{
+    std::vector<Match> matches;
+    if (this->literals_.empty())
+    {
+        return matches;
+    }
+
+    int node = 0;
+    for (int i = 0; i < text.size(); i++)
+    {
+        auto c = fold(text[i]);
+        int next;
+        while ((next = this->child(node, c)) == -1 && node != 0)
+        {
+            node = this->nodes_[node].fail;
+        }
+        node = next == -1 ? 0 : next;
+
+        for (int output = this->nodes_[node].literals.empty()
+                              ? this->nodes_[node].outputLink
+                              : node;
+             output != -1; output = this->nodes_[output].outputLink)
+        {
+            for (auto index : this->nodes_[output].literals)
+            {
+                const auto &literal = this->literals_[index];
+                auto start = i + 1 - literal.pattern.size();
+                if (literal.isCaseSensitive &&
+                    text.midRef(start, literal.pattern.size()) !=
+                        literal.pattern)
+                {
+                    continue;
+                }
+                matches.push_back(
+                    {start, int(literal.pattern.size()), literal.rule});
+            }
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const auto &a, const auto &b) {
+        return std::tie(a.start, a.rule) < std::tie(b.start, b.rule);
+    });
+    return matches;
+}
+
+IgnoreReplacer::Match IgnoreReplacer::findRegex(const QString &text, int from,
+                                                RegexCursor &cursor) const
+{
+    if (cursor.exhausted || cursor.match.start >= from)
+    {
+        return cursor.match;
+    }
+
+    while (from <= text.size())
+    {
+        const auto &regex =
+            cursor.rule == -1 ? this->combined_ : this->regexes_[cursor.rule];
+        auto match = regex.match(text, from);
+        if (!match.hasMatch())
+        {
+            break;
+        }
+
+        Match found{match.capturedStart(), match.capturedLength(),
+                    cursor.rule};
+        if (cursor.rule == -1)
+        {
+            // the first alternative matching at that position is the one the
+            // combined regex took. Empty matches are ignored anyway, so an
+            // alternative that can match nothing mustn't hide the next ones
+            for (auto rule : this->combinedRules_)
+            {
+                auto anchored = this->regexes_[rule].match(
+                    text, found.start, QRegularExpression::NormalMatch,
+                    QRegularExpression::AnchoredMatchOption);
+                if (anchored.hasMatch() && anchored.capturedLength() > 0)
+                {
+                    found.length = anchored.capturedLength();
+                    found.rule = rule;
+                    break;
+                }
+            }
+        }
+
+        if (found.rule != -1 && found.length > 0)
+        {
+            cursor.match = found;
+            return found;
+        }
+        from = found.start + 1;
+    }
+
+    cursor.exhausted = true;
+    cursor.match = Match{};
+    return cursor.match;
+}
+
+QString IgnoreReplacer::replacement(const QString &text,
+                                    const Match &match) const
+{
+    const auto &rule = this->rules_[match.rule];
+    if (!rule.isRegex)
+    {
+        return rule.replace;
+    }
+
+    // replacing in the match only keeps \1 style references working
+    auto replaced = text.mid(match.start, match.length);
+    replaced.replace(this->regexes_[match.rule], rule.replace);
+    return replaced;
+}
+
+std::vector<IgnoreReplacer::Edit> IgnoreReplacer::replace(QString &text) const
+{
+    std::vector<Edit> edits;
+    if (this->empty())
+    {
+        return edits;
+    }
+
+    auto literals = this->findLiterals(text);
+    auto nextLiteral = literals.begin();
+
+    std::vector<RegexCursor> cursors;
+    if (!this->combinedRules_.empty())
+    {
+        cursors.push_back(RegexCursor{});
+    }
+    for (auto rule : this->separateRules_)
+    {
+        cursors.push_back(RegexCursor{rule});
+    }
+
+    QString result;
+    int position = 0;
+    while (true)
+    {
+        while (nextLiteral != literals.end() && nextLiteral->start < position)
+        {
+            ++nextLiteral;
+        }
+
+        Match best;
+        if (nextLiteral != literals.end())
+        {
+            best = *nextLiteral;
+        }
+        for (auto &cursor : cursors)
+        {
+            auto match = this->findRegex(text, position, cursor);
+            if (match.start != -1 &&
+                (best.start == -1 ||
+                 std::tie(match.start, match.rule) <
+                     std::tie(best.start, best.rule)))
+            {
+                best = match;
+            }
+        }
+        if (best.start == -1)
+        {
+            break;
+        }
+
+        if (result.isEmpty())
+        {
+            result.reserve(text.size());
+        }
+        result += text.midRef(position, best.start - position);
+
+        auto replacement = this->replacement(text, best);
+        edits.push_back({best.start, best.length, int(result.size()),
+                         int(replacement.size()), best.rule});
+        result += replacement;
+
+        position = best.start + best.length;
+    }
+
+    if (!edits.empty())
+    {
+        result += text.midRef(position);
+        text = std::move(result);
+    }
+    return edits;
+}
+
+}  // namespace chatterino
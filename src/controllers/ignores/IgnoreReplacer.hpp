@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QRegularExpression>
+#include <QString>
+
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// Runs the replacements of many ignored phrases over a message in one pass.
+/// All plain patterns are found by a single Aho-Corasick scan and most regexes
+/// by one combined regex, so the cost barely grows with the number of rules.
+///
+/// Matches never overlap: the one starting first wins, then the rule listed
+/// first. Replaced text isn't matched again and matches of zero length are
+/// ignored.
+class IgnoreReplacer
+{
+public:
+    struct Rule {
+        QString pattern;
+        bool isRegex;
+        bool isCaseSensitive;
+        QString replace;
+    };
+
+    struct Edit {
+        // replaced range in the original text
+        int from;
+        int length;
+        // the replacement in the new text
+        int newFrom;
+        int newLength;
+        // index of the rule in the vector passed to the constructor
+        int rule;
+    };
+
+    /// Rules with an empty or invalid pattern never match
+    explicit IgnoreReplacer(std::vector<Rule> rules);
+
+    bool empty() const;
+
+    /// Replaces all matches in text, returns the edits sorted by position
+    std::vector<Edit> replace(QString &text) const;
+
+private:
+    struct Match {
+        int start = -1;
+        int length = 0;
+        int rule = -1;
+    };
+    struct Literal {
+        QString pattern;
+        int rule;
+        bool isCaseSensitive;
+    };
+    struct Node {
+        // sorted by the case folded character
+        std::vector<std::pair<ushort, int>> children;
+        int fail = 0;
+        // closest node on the fail chain which ends a literal
+        int outputLink = -1;
+        // indices into literals_ ending in this node
+        std::vector<int> literals;
+    };
+    struct RegexCursor;
+
+    void addLiteral(int rule);
+    void linkLiterals();
+    int child(int node, ushort c) const;
+
+    std::vector<Match> findLiterals(const QString &text) const;
+    Match findRegex(const QString &text, int from, RegexCursor &cursor) const;
+    QString replacement(const QString &text, const Match &match) const;
+
+    std::vector<Rule> rules_;
+    std::vector<QRegularExpression> regexes_;
+
+    std::vector<Literal> literals_;
+    std::vector<Node> nodes_;
+
+    // regexes that are safe to match as one alternation, in rule order
+    QRegularExpression combined_;
+    std::vector<int> combinedRules_;
+    // regexes with backreferences, the group numbers change when combined
+    std::vector<int> separateRules_;
+};
+
+}  // namespace chatterino
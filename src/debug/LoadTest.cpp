@@ -0,0 +1,182 @@
+#include "debug/LoadTest.hpp"
+
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "debug/MemoryReport.hpp"
+#include "debug/MessageLatency.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTimer>
+
+#include <algorithm>
+#include <memory>
+
+namespace chatterino {
+namespace {
+    // the GUI thread is expected to wake up this often
+    constexpr int PROBE_INTERVAL = 10;
+    // delays longer than this count as a stall
+    constexpr int STALL_THRESHOLD = 50;
+
+    auto &receivedMessages =
+        DebugCount::counter("twitch irc messages received");
+
+    struct LoadTestState {
+        QString reportPath;
+
+        QElapsedTimer elapsed;
+        qint64 lastProbe = 0;
+
+        int stallCount = 0;
+        qint64 totalStallMs = 0;
+        qint64 maxStallMs = 0;
+
+        int64_t startReceived = 0;
+        int64_t lastReceived = 0;
+        QJsonArray receivedPerSecond;
+
+        qint64 startResident = 0;
+        QJsonObject startMemory;
+
+        void probe()
+        {
+            auto now = this->elapsed.elapsed();
+            auto delay = now - this->lastProbe - PROBE_INTERVAL;
+            this->lastProbe = now;
+
+            if (delay > STALL_THRESHOLD)
+            {
+                this->stallCount++;
+                this->totalStallMs += delay;
+                this->maxStallMs = std::max(this->maxStallMs, delay);
+            }
+        }
+
+        void sample()
+        {
+            auto received = receivedMessages.value();
+            this->receivedPerSecond.append(
+                double(received - this->lastReceived));
+            this->lastReceived = received;
+        }
+
+        QJsonObject report() const
+        {
+            auto seconds = double(this->elapsed.elapsed()) / 1000;
+            auto received = receivedMessages.value() - this->startReceived;
+
+            auto endMemory = MemoryReport::toJson();
+
+            // growth of every byte counter
+            QJsonObject growth;
+            auto startBytes = this->startMemory.value("bytes").toObject();
+            auto endBytes = endMemory.value("bytes").toObject();
+            for (auto it = endBytes.begin(); it != endBytes.end(); ++it)
+            {
+                growth.insert(it.key(), it.value().toDouble() -
+                                            startBytes.value(it.key())
+                                                .toDouble());
+            }
+
+            auto endResident = MemoryReport::residentBytes();
+
+            return QJsonObject{
+                {"duration", seconds},
+                {"messagesReceived", double(received)},
+                {"messagesPerSecond", double(received) / seconds},
+                {"receivedPerSecond", this->receivedPerSecond},
+                {"latency", MessageLatency::toJson()},
+                {"guiThread",
+                 QJsonObject{
+                     {"stalls", this->stallCount},
+                     {"totalStallMs", double(this->totalStallMs)},
+                     {"maxStallMs", double(this->maxStallMs)},
+                 }},
+                {"memory",
+                 QJsonObject{
+                     {"startResident", double(this->startResident)},
+                     {"endResident", double(endResident)},
+                     {"residentGrowth",
+                      this->startResident < 0 || endResident < 0
+                          ? QJsonValue()
+                          : double(endResident - this->startResident)},
+                     {"counterGrowth", growth},
+                     {"start", this->startMemory},
+                     {"end", endMemory},
+                 }},
+            };
+        }
+
+        void finish()
+        {
+            auto report = this->report();
+
+            qCInfo(chatterinoBenchmark).noquote()
+                << QString("Load test: %1 messages/s, %2 GUI thread stalls "
+                           "(%3 ms total, %4 ms max)")
+                       .arg(report.value("messagesPerSecond").toDouble(), 0,
+                            'f', 0)
+                       .arg(this->stallCount)
+                       .arg(this->totalStallMs)
+                       .arg(this->maxStallMs);
+
+            QFile file(this->reportPath);
+            if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            {
+                file.write(QJsonDocument(report).toJson());
+            }
+            else
+            {
+                qCWarning(chatterinoBenchmark)
+                    << "Unable to write load test report to"
+                    << this->reportPath;
+            }
+
+            QCoreApplication::quit();
+        }
+    };
+}  // namespace
+
+void LoadTest::start(const QString &reportPath, int durationSeconds)
+{
+    assertInGuiThread();
+
+    auto *parent = QCoreApplication::instance();
+    auto state = std::make_shared<LoadTestState>();
+
+    state->reportPath = reportPath;
+    state->startReceived = state->lastReceived = receivedMessages.value();
+    state->startResident = MemoryReport::residentBytes();
+    state->startMemory = MemoryReport::toJson();
+    state->elapsed.start();
+
+    auto *probeTimer = new QTimer(parent);
+    probeTimer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(probeTimer, &QTimer::timeout, [state] {
+        state->probe();
+    });
+    probeTimer->start(PROBE_INTERVAL);
+
+    auto *sampleTimer = new QTimer(parent);
+    QObject::connect(sampleTimer, &QTimer::timeout, [state] {
+        state->sample();
+    });
+    sampleTimer->start(1000);
+
+    QTimer::singleShot(durationSeconds * 1000, parent,
+                       [state, probeTimer, sampleTimer] {
+                           probeTimer->stop();
+                           sampleTimer->stop();
+                           state->finish();
+                       });
+
+    qCInfo(chatterinoBenchmark)
+        << "Running load test for" << durationSeconds << "seconds";
+}
+
+}  // namespace chatterino
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QString>
+
+namespace chatterino {
+
+/// Measures how well the app keeps up with incoming messages and writes a
+/// report once the test is over. Enabled with --load-test, usually against the
+/// local replay server in tools/replay-server.
+///
+/// The report contains the received irc messages per second, how long the GUI
+/// thread was blocked and how much the memory grew during the test.
+class LoadTest
+{
+public:
+    // Starts measuring, writes the report to reportPath after
+    // durationSeconds and quits the application.
+    // Must be called from the GUI thread
+    static void start(const QString &reportPath, int durationSeconds);
+};
+
+}  // namespace chatterino
@@ -0,0 +1,130 @@
+#include "debug/MemoryReport.hpp"
+
+#include "Application.hpp"
+#include "common/Channel.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "providers/twitch/TwitchIrcServer.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTimer>
+
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#    include <unistd.h>
+#endif
+
+namespace chatterino {
+
+std::vector<MemoryReport::ChannelUsage> MemoryReport::channelUsage()
+{
+    assertInGuiThread();
+
+    std::vector<ChannelUsage> usage;
+
+    auto *app = getApp();
+    if (app == nullptr || app->twitch2 == nullptr)
+    {
+        return usage;
+    }
+
+    app->twitch2->forEachChannelAndSpecialChannels([&usage](ChannelPtr chan) {
+        usage.push_back({chan->getName(), chan->getMessageSnapshot().size(),
+                         chan->messageMemoryUsage()});
+    });
+
+    std::sort(usage.begin(), usage.end(), [](const auto &a, const auto &b) {
+        return a.bytes > b.bytes;
+    });
+
+    return usage;
+}
+
+QString MemoryReport::getText(size_t maxChannels)
+{
+    auto text = DebugCount::getDebugText();
+
+    auto channels = channelUsage();
+    if (channels.empty())
+    {
+        return text;
+    }
+
+    text += "\nmessages per channel:\n";
+    for (size_t i = 0; i < channels.size() && i < maxChannels; i++)
+    {
+        const auto &channel = channels[i];
+        text += QString("%1: %2 (%3 messages)\n")
+                    .arg(channel.name)
+                    .arg(DebugCount::formatBytes(channel.bytes))
+                    .arg(channel.messageCount);
+    }
+    if (channels.size() > maxChannels)
+    {
+        text += QString("%1 more\n").arg(channels.size() - maxChannels);
+    }
+
+    return text;
+}
+
+int64_t MemoryReport::residentBytes()
+{
+#ifdef Q_OS_LINUX
+    QFile file("/proc/self/statm");
+    if (file.open(QIODevice::ReadOnly))
+    {
+        auto fields = file.readAll().split(' ');
+        if (fields.size() >= 2)
+        {
+            return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+    }
+#endif
+    return -1;
+}
+
+QJsonObject MemoryReport::toJson()
+{
+    QJsonArray channels;
+    for (const auto &channel : channelUsage())
+    {
+        channels.append(QJsonObject{
+            {"name", channel.name},
+            {"messages", double(channel.messageCount)},
+            {"bytes", double(channel.bytes)},
+        });
+    }
+
+    auto report = DebugCount::toJson();
+    report.insert("time",
+                  QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert("channels", channels);
+    return report;
+}
+
+void MemoryReport::startPeriodicDump(const QString &path, int intervalMs)
+{
+    auto *timer = new QTimer(QCoreApplication::instance());
+
+    QObject::connect(timer, &QTimer::timeout, [path] {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qCWarning(chatterinoApp)
+                << "Unable to write memory report to" << path;
+            return;
+        }
+
+        file.write(QJsonDocument(MemoryReport::toJson()).toJson());
+    });
+
+    timer->start(intervalMs);
+}
+
+}  // namespace chatterino
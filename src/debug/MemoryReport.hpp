@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+
+/// Combines the debug counters with the memory used by the messages of every
+/// twitch channel. Used by the DebugPopup and by --dump-memory-report.
+/// Must be used from the GUI thread.
+class MemoryReport
+{
+public:
+    struct ChannelUsage {
+        QString name;
+        size_t messageCount;
+        int64_t bytes;
+    };
+
+    // Channels sorted by the memory used by their messages, largest first
+    static std::vector<ChannelUsage> channelUsage();
+
+    // Resident memory of the process, -1 if unknown
+    static int64_t residentBytes();
+
+    static QString getText(size_t maxChannels = 10);
+    static QJsonObject toJson();
+
+    // Writes toJson() to the given file every intervalMs milliseconds
+    static void startPeriodicDump(const QString &path, int intervalMs);
+};
+
+}  // namespace chatterino
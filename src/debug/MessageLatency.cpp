@@ -0,0 +1,339 @@
+#include "debug/MessageLatency.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QMap>
+#include <QTimer>
+#include <QtAlgorithms>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+namespace {
+    const char *const STAGE_NAMES[MessageLatency::STAGE_COUNT] = {
+        "received", "built", "added", "laid out", "painted",
+    };
+
+    // anything slower is counted as this
+    constexpr int64_t MAX_LATENCY = (int64_t(1) << 22) - 1;
+
+    std::atomic<int64_t> backlogCount{0};
+
+    struct Registry {
+        MessageLatency::StageHistograms total;
+
+        std::mutex mutex;
+        // deque never moves its elements, traces keep pointers to them
+        std::deque<MessageLatency::StageHistograms> channels;
+        QMap<QString, MessageLatency::StageHistograms *> byName;
+    };
+
+    Registry &registry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    MessageLatency::StageHistograms &channelHistograms(const QString &name)
+    {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        auto it = r.byName.find(name);
+        if (it != r.byName.end())
+        {
+            return **it;
+        }
+
+        r.channels.emplace_back();
+        r.byName.insert(name, &r.channels.back());
+        return r.channels.back();
+    }
+
+    QJsonObject stagesToJson(const MessageLatency::StageHistograms &stages)
+    {
+        QJsonObject object;
+        for (int i = 0; i < MessageLatency::STAGE_COUNT; i++)
+        {
+            object.insert(STAGE_NAMES[i], stages[i].toJson());
+        }
+        return object;
+    }
+
+    QString summary(const MessageLatency::Histogram &histogram)
+    {
+        return QString("%1 / %2 / %3 ms")
+            .arg(histogram.percentile(50))
+            .arg(histogram.percentile(99))
+            .arg(histogram.max());
+    }
+}  // namespace
+
+//
+// Histogram
+//
+int MessageLatency::Histogram::bucketIndex(int64_t ms)
+{
+    if (ms < 8)
+    {
+        return int(ms);
+    }
+
+    // 3 <= exponent <= 21
+    int exponent = 63 - qCountLeadingZeroBits(quint64(ms));
+    return 8 * (exponent - 2) + int((ms >> (exponent - 3)) & 7);
+}
+
+int64_t MessageLatency::Histogram::bucketUpperBound(int index)
+{
+    if (index < 8)
+    {
+        return index;
+    }
+
+    int exponent = index / 8 + 2;
+    int64_t width = int64_t(1) << (exponent - 3);
+    return (8 + index % 8) * width + width - 1;
+}
+
+void MessageLatency::Histogram::record(int64_t ms)
+{
+    // the clocks of twitch and the user might not agree
+    ms = std::max<int64_t>(0, std::min(ms, MAX_LATENCY));
+
+    this->buckets_[bucketIndex(ms)].fetch_add(1, std::memory_order_relaxed);
+    this->count_.fetch_add(1, std::memory_order_relaxed);
+
+    auto max = this->max_.load(std::memory_order_relaxed);
+    while (ms > max && !this->max_.compare_exchange_weak(
+                           max, ms, std::memory_order_relaxed))
+    {
+    }
+}
+
+int64_t MessageLatency::Histogram::count() const
+{
+    return this->count_.load(std::memory_order_relaxed);
+}
+
+int64_t MessageLatency::Histogram::max() const
+{
+    return this->max_.load(std::memory_order_relaxed);
+}
+
+int64_t MessageLatency::Histogram::percentile(double percent) const
+{
+    // the buckets might change while we're reading them, sum them up instead
+    // of trusting count_
+    std::array<uint32_t, BUCKET_COUNT> buckets;
+    int64_t total = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        buckets[i] = this->buckets_[i].load(std::memory_order_relaxed);
+        total += buckets[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    auto target = std::max<int64_t>(
+        1, int64_t(std::ceil(double(total) * percent / 100)));
+
+    int64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += buckets[i];
+        if (seen >= target)
+        {
+            return std::min(bucketUpperBound(i), this->max());
+        }
+    }
+    return this->max();
+}
+
+QJsonObject MessageLatency::Histogram::toJson() const
+{
+    return QJsonObject{
+        {"count", double(this->count())},
+        {"p50", double(this->percentile(50))},
+        {"p90", double(this->percentile(90))},
+        {"p99", double(this->percentile(99))},
+        {"max", double(this->max())},
+    };
+}
+
+//
+// Trace
+//
+MessageLatency::Trace::~Trace()
+{
+    auto bit = uint8_t(1 << int(Stage::Added));
+    if (this->channel_ != nullptr &&
+        !(this->recorded_.load(std::memory_order_relaxed) & bit))
+    {
+        backlogCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void MessageLatency::Trace::start(const QString &channelName,
+                                  const Channel *target, int64_t sentAt,
+                                  int64_t receivedAt)
+{
+    if (sentAt <= 0 || this->channel_ != nullptr)
+    {
+        return;
+    }
+
+    this->sentAt_ = sentAt;
+    this->channel_ = &channelHistograms(channelName);
+    this->target_ = target;
+    backlogCount.fetch_add(1, std::memory_order_relaxed);
+
+    this->record(Stage::Received, receivedAt);
+}
+
+void MessageLatency::Trace::record(Stage stage) const
+{
+    if (this->channel_ == nullptr)
+    {
+        return;
+    }
+
+    this->record(stage, QDateTime::currentMSecsSinceEpoch());
+}
+
+void MessageLatency::Trace::recordAdded(const Channel *channel) const
+{
+    if (this->channel_ == nullptr || channel != this->target_)
+    {
+        return;
+    }
+
+    this->record(Stage::Added, QDateTime::currentMSecsSinceEpoch());
+}
+
+void MessageLatency::Trace::record(Stage stage, int64_t now) const
+{
+    auto bit = uint8_t(1 << int(stage));
+    if (this->recorded_.fetch_or(bit, std::memory_order_relaxed) & bit)
+    {
+        return;
+    }
+
+    if (stage == Stage::Added)
+    {
+        backlogCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    auto latency = now - this->sentAt_;
+    registry().total[int(stage)].record(latency);
+    (*this->channel_)[int(stage)].record(latency);
+}
+
+//
+// MessageLatency
+//
+int64_t MessageLatency::backlog()
+{
+    return backlogCount.load(std::memory_order_relaxed);
+}
+
+QString MessageLatency::getText(size_t maxChannels)
+{
+    auto &r = registry();
+
+    QString text = "latency since sent (p50 / p99 / max):\n";
+    for (int i = 0; i < STAGE_COUNT; i++)
+    {
+        text += QString("%1: %2\n")
+                    .arg(STAGE_NAMES[i])
+                    .arg(summary(r.total[i]));
+    }
+    text += QString("backlog: %1 messages\n").arg(backlog());
+
+    std::vector<std::pair<QString, const StageHistograms *>> channels;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto it = r.byName.begin(); it != r.byName.end(); it++)
+        {
+            channels.emplace_back(it.key(), it.value());
+        }
+    }
+    if (channels.empty())
+    {
+        return text;
+    }
+
+    // the channels that are furthest behind
+    const auto added = int(Stage::Added);
+    std::sort(channels.begin(), channels.end(),
+              [added](const auto &a, const auto &b) {
+                  return (*a.second)[added].percentile(99) >
+                         (*b.second)[added].percentile(99);
+              });
+
+    text += "\nadded per channel:\n";
+    for (size_t i = 0; i < channels.size() && i < maxChannels; i++)
+    {
+        text += QString("%1: %2\n")
+                    .arg(channels[i].first)
+                    .arg(summary((*channels[i].second)[added]));
+    }
+    if (channels.size() > maxChannels)
+    {
+        text += QString("%1 more\n").arg(channels.size() - maxChannels);
+    }
+
+    return text;
+}
+
+QJsonObject MessageLatency::toJson()
+{
+    auto &r = registry();
+
+    QJsonObject channels;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto it = r.byName.begin(); it != r.byName.end(); it++)
+        {
+            channels.insert(it.key(), stagesToJson(*it.value()));
+        }
+    }
+
+    return QJsonObject{
+        {"time", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {"backlog", double(backlog())},
+        {"total", stagesToJson(r.total)},
+        {"channels", channels},
+    };
+}
+
+void MessageLatency::startPeriodicDump(const QString &path, int intervalMs)
+{
+    auto *timer = new QTimer(QCoreApplication::instance());
+
+    QObject::connect(timer, &QTimer::timeout, [path] {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qCWarning(chatterinoApp)
+                << "Unable to write latency report to" << path;
+            return;
+        }
+
+        file.write(QJsonDocument(MessageLatency::toJson()).toJson());
+    });
+
+    timer->start(intervalMs);
+}
+
+}  // namespace chatterino
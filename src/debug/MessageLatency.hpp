@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace chatterino {
+
+class Channel;
+
+/// Histograms of how long live twitch messages take from being sent by twitch
+/// (tmi-sent-ts) to reaching each stage of our pipeline, in total and per
+/// channel. Shown in the DebugPopup and written by --dump-latency-report.
+///
+/// Recording a stage only takes a few relaxed atomic operations and every
+/// message records a stage once, no matter how many splits show it.
+class MessageLatency
+{
+public:
+    enum class Stage : uint8_t {
+        // handed to us by communi, reading the socket and parsing the message
+        // happen in there
+        Received,
+        // built by the TwitchMessageBuilder
+        Built,
+        // appended to the channel it was received in
+        Added,
+        // laid out by the first split showing it
+        LaidOut,
+        // painted by the first split showing it
+        Painted,
+    };
+    static constexpr int STAGE_COUNT = 5;
+
+    /// Log-linear histogram of milliseconds. Every power of two is split into
+    /// 8 buckets, so the reported values are at most 12.5% too high.
+    class Histogram : boost::noncopyable
+    {
+    public:
+        void record(int64_t ms);
+
+        int64_t count() const;
+        int64_t max() const;
+        // upper bound of the bucket containing the percentile (0 - 100)
+        int64_t percentile(double percent) const;
+
+        QJsonObject toJson() const;
+
+    private:
+        // 8 exact buckets for 0 - 7 ms, then 8 per power of two up to ~70 min
+        static constexpr int BUCKET_COUNT = 160;
+
+        static int bucketIndex(int64_t ms);
+        static int64_t bucketUpperBound(int index);
+
+        std::array<std::atomic<uint32_t>, BUCKET_COUNT> buckets_{};
+        std::atomic<int64_t> count_{0};
+        std::atomic<int64_t> max_{0};
+    };
+
+    using StageHistograms = std::array<Histogram, STAGE_COUNT>;
+
+    /// Carried by every message. Does nothing unless it was started, which
+    /// only happens for live messages.
+    class Trace : boost::noncopyable
+    {
+    public:
+        // Leaves the backlog if the message never reached its channel
+        ~Trace();
+
+        // Records the Received stage. target is only compared against, the
+        // message counts as added once it reaches that channel.
+        void start(const QString &channelName, const Channel *target,
+                   int64_t sentAt, int64_t receivedAt);
+        // Records the stage if it wasn't recorded for this message yet, use
+        // recordAdded for Stage::Added
+        void record(Stage stage) const;
+        // Records Stage::Added if channel is the one the message was
+        // received in, other channels showing it (e.g. mentions) don't count
+        void recordAdded(const Channel *channel) const;
+
+    private:
+        void record(Stage stage, int64_t now) const;
+
+        int64_t sentAt_ = 0;
+        StageHistograms *channel_ = nullptr;
+        const Channel *target_ = nullptr;
+        mutable std::atomic<uint8_t> recorded_{0};
+    };
+
+    // messages that were received but not appended to their channel yet
+    static int64_t backlog();
+
+    static QString getText(size_t maxChannels = 5);
+    static QJsonObject toJson();
+
+    // Writes toJson() to the given file every intervalMs milliseconds
+    static void startPeriodicDump(const QString &path, int intervalMs);
+};
+
+}  // namespace chatterino
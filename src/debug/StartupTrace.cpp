@@ -0,0 +1,160 @@
+#include "debug/StartupTrace.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+namespace {
+    struct TraceEvent {
+        QString name;
+        QString category;
+        qint64 start;
+        qint64 duration;
+        quintptr thread;
+        QString detail;
+    };
+
+    struct TraceState {
+        std::atomic<bool> enabled{false};
+        QString outputPath;
+        QElapsedTimer timer;
+        quintptr guiThread{};
+
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+    };
+
+    TraceState &state()
+    {
+        static TraceState state;
+        return state;
+    }
+
+    quintptr currentThreadId()
+    {
+        return reinterpret_cast<quintptr>(QThread::currentThreadId());
+    }
+}  // namespace
+
+void StartupTrace::enable(const QString &outputPath)
+{
+    auto &s = state();
+
+    s.outputPath = outputPath;
+    s.guiThread = currentThreadId();
+    s.timer.start();
+    s.enabled = true;
+}
+
+bool StartupTrace::isEnabled()
+{
+    return state().enabled;
+}
+
+qint64 StartupTrace::now()
+{
+    return state().timer.nsecsElapsed() / 1000;
+}
+
+void StartupTrace::addEvent(const QString &name, const QString &category,
+                            qint64 startUs, qint64 durationUs,
+                            const QString &detail)
+{
+    auto &s = state();
+    if (!s.enabled)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.events.push_back(
+        {name, category, startUs, durationUs, currentThreadId(), detail});
+}
+
+void StartupTrace::write()
+{
+    auto &s = state();
+    if (!s.enabled)
+    {
+        return;
+    }
+
+    QJsonArray traceEvents;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        // the gui thread is always shown at the top
+        std::map<quintptr, int> threadIndices{{s.guiThread, 0}};
+
+        for (const auto &event : s.events)
+        {
+            auto thread = threadIndices
+                              .emplace(event.thread, int(threadIndices.size()))
+                              .first->second;
+
+            QJsonObject obj;
+            obj.insert("name", event.name);
+            obj.insert("cat", event.category);
+            obj.insert("ph", "X");
+            obj.insert("ts", double(event.start));
+            obj.insert("dur", double(event.duration));
+            obj.insert("pid", 1);
+            obj.insert("tid", thread);
+            if (!event.detail.isEmpty())
+            {
+                obj.insert("args", QJsonObject{{"detail", event.detail}});
+            }
+            traceEvents.append(obj);
+        }
+    }
+
+    QFile file(s.outputPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCWarning(chatterinoBenchmark)
+            << "Unable to write startup trace to" << s.outputPath;
+        return;
+    }
+
+    file.write(QJsonDocument(QJsonObject{{"traceEvents", traceEvents}})
+                   .toJson(QJsonDocument::Compact));
+
+    qCDebug(chatterinoBenchmark) << "Wrote startup trace to" << s.outputPath;
+}
+
+StartupTraceScope::StartupTraceScope(const QString &name,
+                                     const QString &category,
+                                     const QString &detail)
+    : enabled_(StartupTrace::isEnabled())
+{
+    if (this->enabled_)
+    {
+        this->name_ = name;
+        this->category_ = category;
+        this->detail_ = detail;
+        this->start_ = StartupTrace::now();
+    }
+}
+
+StartupTraceScope::~StartupTraceScope()
+{
+    if (this->enabled_)
+    {
+        StartupTrace::addEvent(this->name_, this->category_, this->start_,
+                               StartupTrace::now() - this->start_,
+                               this->detail_);
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QString>
+#include <boost/noncopyable.hpp>
+
+namespace chatterino {
+
+/// Records how long the phases of the startup take and writes them as a
+/// Chrome trace (chrome://tracing or https://ui.perfetto.dev) to the file
+/// passed with --trace-startup.
+/// Recording does nothing unless tracing has been enabled.
+/// This class is thread safe.
+class StartupTrace
+{
+public:
+    static void enable(const QString &outputPath);
+    static bool isEnabled();
+
+    // microseconds since tracing was enabled
+    static qint64 now();
+
+    static void addEvent(const QString &name, const QString &category,
+                         qint64 startUs, qint64 durationUs,
+                         const QString &detail = QString());
+
+    // Writes all events recorded so far to the output path
+    static void write();
+};
+
+/// Records the lifetime of the guard as one startup trace event
+class StartupTraceScope : boost::noncopyable
+{
+public:
+    StartupTraceScope(const QString &name,
+                      const QString &category = QStringLiteral("startup"),
+                      const QString &detail = QString());
+    ~StartupTraceScope();
+
+private:
+    bool enabled_;
+    qint64 start_{};
+    QString name_;
+    QString category_;
+    QString detail_;
+};
+
+}  // namespace chatterino
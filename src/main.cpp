@@ -10,6 +10,7 @@
 #include "common/Modes.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
+#include "debug/StartupTrace.hpp"
 #include "providers/IvrApi.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/api/Kraken.hpp"
@@ -47,6 +48,11 @@ int main(int argc, char **argv)
     }
     else
     {
+        if (!getArgs().startupTracePath.isEmpty())
+        {
+            StartupTrace::enable(getArgs().startupTracePath);
+        }
+
         IvrApi::initialize();
         Helix::initialize();
         Kraken::initialize();
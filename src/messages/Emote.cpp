@@ -1,8 +1,29 @@
 #include "Emote.hpp"
 
+#include "util/DebugCount.hpp"
+
 #include <unordered_map>
 
 namespace chatterino {
+namespace {
+    auto &emoteMapBytes =
+        DebugCount::counter("emote map bytes", DebugCount::Unit::Bytes);
+
+    int64_t emoteMapMemoryUsage(const EmoteMap &map)
+    {
+        // bucket array plus one node per emote
+        int64_t usage = int64_t(map.bucket_count()) * sizeof(void *);
+        for (const auto &item : map)
+        {
+            usage += sizeof(void *) + sizeof(EmoteName) + sizeof(EmotePtr) +
+                     sizeof(Emote) +
+                     int64_t(item.first.string.capacity() +
+                             item.second->tooltip.string.capacity()) *
+                         sizeof(QChar);
+        }
+        return usage;
+    }
+}  // namespace
 
 bool operator==(const Emote &a, const Emote &b)
 {
@@ -25,6 +46,18 @@ EmotePtr cachedOrMakeEmotePtr(Emote &&emote, const EmoteMap &cache)
     return std::make_shared<Emote>(std::move(emote));
 }
 
+std::shared_ptr<const EmoteMap> makeEmoteMapPtr(EmoteMap &&map)
+{
+    auto usage = emoteMapMemoryUsage(map);
+    emoteMapBytes.increase(usage);
+
+    return std::shared_ptr<const EmoteMap>(
+        new EmoteMap(std::move(map)), [usage](const EmoteMap *map) {
+            emoteMapBytes.decrease(usage);
+            delete map;
+        });
+}
+
 EmotePtr cachedOrMakeEmotePtr(
     Emote &&emote,
     std::unordered_map<EmoteId, std::weak_ptr<const Emote>> &cache,
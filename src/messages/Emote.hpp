@@ -30,6 +30,10 @@ using EmotePtr = std::shared_ptr<const Emote>;
 class EmoteMap : public std::unordered_map<EmoteName, EmotePtr>
 {
 };
+
+// Moves the map into a shared pointer. The approximate memory used by the map
+// is accounted in the debug counters while it's alive.
+std::shared_ptr<const EmoteMap> makeEmoteMapPtr(EmoteMap &&map);
 using EmoteIdMap = std::unordered_map<EmoteId, EmotePtr>;
 using WeakEmoteMap = std::unordered_map<EmoteName, std::weak_ptr<const Emote>>;
 using WeakEmoteIdMap = std::unordered_map<EmoteId, std::weak_ptr<const Emote>>;
@@ -22,21 +22,36 @@
 
 namespace chatterino {
 namespace detail {
+    namespace {
+        auto &imageCount = DebugCount::counter("images");
+        auto &animatedImageCount = DebugCount::counter("animated images");
+        auto &frameBytes =
+            DebugCount::counter("image frame bytes", DebugCount::Unit::Bytes);
+    }  // namespace
+
     // Frames
     Frames::Frames()
     {
-        DebugCount::increase("images");
+        imageCount.increase();
     }
 
     Frames::Frames(const QVector<Frame<QPixmap>> &frames)
         : items_(frames)
     {
         assertInGuiThread();
-        DebugCount::increase("images");
+        imageCount.increase();
+
+        for (const auto &frame : this->items_)
+        {
+            this->memoryUsage_ += int64_t(frame.image.width()) *
+                                  frame.image.height() *
+                                  frame.image.depth() / 8;
+        }
+        frameBytes.increase(this->memoryUsage_);
 
         if (this->animated())
         {
-            DebugCount::increase("animated images");
+            animatedImageCount.increase();
 
             this->gifTimerConnection_ =
                 getApp()->emotes->gifTimer.signal.connect([this] {
@@ -66,11 +81,12 @@ namespace detail {
     Frames::~Frames()
     {
         assertInGuiThread();
-        DebugCount::decrease("images");
+        imageCount.decrease();
+        frameBytes.decrease(this->memoryUsage_);
 
         if (this->animated())
         {
-            DebugCount::decrease("animated images");
+            animatedImageCount.decrease();
         }
 
         this->gifTimerConnection_.disconnect();
@@ -374,6 +390,7 @@ int Image::height() const
 void Image::actuallyLoad()
 {
     NetworkRequest(this->url().string)
+        .priority(NetworkRequestPriority::Image)
         .concurrent()
         .cache()
         .onSuccess([weak = weakOf(this)](auto result) -> Outcome {
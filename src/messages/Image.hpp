@@ -37,6 +37,7 @@ namespace detail {
     private:
         void processOffset();
         QVector<Frame<QPixmap>> items_;
+        int64_t memoryUsage_{0};
         int index_{0};
         int durationOffset_{0};
         pajlada::Signals::Connection gifTimerConnection_;
@@ -56,33 +56,23 @@ public:
     {
         std::lock_guard<std::mutex> lock(this->mutex_);
 
-        auto lastChunk = this->chunks_->back();
+        return this->pushBackUnlocked(item, deleted);
+    }
 
-        if (lastChunk->size() <= this->lastChunkEnd_)
-        {
-            // Last chunk is full, create a new one and rebuild our chunk vector
-            auto newVector = std::make_shared<ChunkVector>();
+    // pushes all items while taking the lock once
+    // the items that were removed from the start are appended to deleted
+    void pushBack(const std::vector<T> &items, std::vector<T> &deleted)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
 
-            // copy chunks
-            for (auto &chunk : *this->chunks_)
+        for (const auto &item : items)
+        {
+            T removed;
+            if (this->pushBackUnlocked(item, removed))
             {
-                newVector->push_back(chunk);
+                deleted.push_back(std::move(removed));
             }
-
-            // push back new chunk
-            auto newChunk = std::make_shared<Chunk>();
-            newChunk->resize(this->chunkSize_);
-            newVector->push_back(newChunk);
-
-            // replace current chunk vector
-            this->chunks_ = newVector;
-            this->lastChunkEnd_ = 0;
-            lastChunk = this->chunks_->back();
         }
-
-        lastChunk->at(this->lastChunkEnd_++) = item;
-
-        return this->deleteFirstItem(deleted);
     }
 
     // returns a vector with all the accepted items
@@ -229,6 +219,37 @@ public:
     }
 
 private:
+    bool pushBackUnlocked(const T &item, T &deleted)
+    {
+        auto lastChunk = this->chunks_->back();
+
+        if (lastChunk->size() <= this->lastChunkEnd_)
+        {
+            // Last chunk is full, create a new one and rebuild our chunk vector
+            auto newVector = std::make_shared<ChunkVector>();
+
+            // copy chunks
+            for (auto &chunk : *this->chunks_)
+            {
+                newVector->push_back(chunk);
+            }
+
+            // push back new chunk
+            auto newChunk = std::make_shared<Chunk>();
+            newChunk->resize(this->chunkSize_);
+            newVector->push_back(newChunk);
+
+            // replace current chunk vector
+            this->chunks_ = newVector;
+            this->lastChunkEnd_ = 0;
+            lastChunk = this->chunks_->back();
+        }
+
+        lastChunk->at(this->lastChunkEnd_++) = item;
+
+        return this->deleteFirstItem(deleted);
+    }
+
     qsizetype space() const
     {
         size_t totalSize = 0;
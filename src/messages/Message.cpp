@@ -10,16 +10,64 @@
 using SBHighlight = chatterino::ScrollbarHighlight;
 
 namespace chatterino {
+namespace {
+    auto &messageCount = DebugCount::counter("messages");
+    auto &messageBytes =
+        DebugCount::counter("message bytes", DebugCount::Unit::Bytes);
+    auto &elementBytes =
+        DebugCount::counter("message element bytes", DebugCount::Unit::Bytes);
+
+    int64_t stringBytes(const QString &string)
+    {
+        return int64_t(string.capacity()) * sizeof(QChar);
+    }
+}  // namespace
 
 Message::Message()
     : parseTime(QTime::currentTime())
 {
-    DebugCount::increase("messages");
+    messageCount.increase();
 }
 
 Message::~Message()
 {
-    DebugCount::decrease("messages");
+    messageCount.decrease();
+    messageBytes.decrease(this->memoryUsage_);
+    elementBytes.decrease(this->elementsMemoryUsage_);
+}
+
+int64_t Message::memoryUsage() const
+{
+    return this->memoryUsage_ + this->elementsMemoryUsage_;
+}
+
+void Message::updateMemoryUsage()
+{
+    messageBytes.decrease(this->memoryUsage_);
+    elementBytes.decrease(this->elementsMemoryUsage_);
+
+    this->memoryUsage_ =
+        sizeof(Message) + stringBytes(this->id) +
+        stringBytes(this->searchText) + stringBytes(this->lowercaseSearchText) +
+        stringBytes(this->messageText) + stringBytes(this->loginName) +
+        stringBytes(this->displayName) + stringBytes(this->localizedName) +
+        stringBytes(this->timeoutUser) + stringBytes(this->channelName) +
+        int64_t(this->badges.capacity()) * sizeof(Badge);
+    for (const auto &info : this->badgeInfos)
+    {
+        this->memoryUsage_ += stringBytes(info.first) +
+                              stringBytes(info.second) + 2 * sizeof(QString);
+    }
+
+    this->elementsMemoryUsage_ =
+        int64_t(this->elements.capacity()) * sizeof(this->elements[0]);
+    for (const auto &element : this->elements)
+    {
+        this->elementsMemoryUsage_ += element->memoryUsage();
+    }
+
+    messageBytes.increase(this->memoryUsage_);
+    elementBytes.increase(this->elementsMemoryUsage_);
 }
 
 SBHighlight Message::getScrollBarHighlight() const
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/FlagsEnum.hpp"
+#include "debug/MessageLatency.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
 #include "widgets/helper/ScrollbarHighlight.hpp"
 
@@ -55,6 +56,9 @@ struct Message : boost::noncopyable {
     QTime parseTime;
     QString id;
     QString searchText;
+    // searchText in lowercase, filled in when the message is released by its
+    // builder
+    QString lowercaseSearchText;
     QString messageText;
     QString loginName;
     QString displayName;
@@ -67,8 +71,21 @@ struct Message : boost::noncopyable {
     std::shared_ptr<QColor> highlightColor;
     uint32_t count = 1;
     std::vector<std::unique_ptr<MessageElement>> elements;
+    // only started for live twitch messages
+    MessageLatency::Trace latency;
+    // results of the filters that ran on this message, see FilterCache
+    mutable uint64_t filterCache = 0;
 
     ScrollbarHighlight getScrollBarHighlight() const;
+
+    // Approximate amount of memory used by the message and its elements.
+    // It's calculated when the message is released by its builder.
+    int64_t memoryUsage() const;
+    void updateMemoryUsage();
+
+private:
+    int64_t memoryUsage_ = 0;
+    int64_t elementsMemoryUsage_ = 0;
 };
 
 using MessagePtr = std::shared_ptr<const Message>;
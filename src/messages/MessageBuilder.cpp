@@ -381,6 +381,8 @@ MessagePtr MessageBuilder::release()
 {
     std::shared_ptr<Message> ptr;
     this->message_.swap(ptr);
+    ptr->lowercaseSearchText = ptr->searchText.toLower();
+    ptr->updateMemoryUsage();
     return ptr;
 }
 
@@ -443,43 +445,48 @@ void MessageBuilder::addLink(const QString &origLink,
     auto linkElement = Link(Link::Url, matchedLink);
 
     auto textColor = MessageColor(MessageColor::Link);
+    auto resolveLinkInfo = std::make_shared<std::function<void()>>();
     auto linkMELowercase =
-        this->emplace<TextElement>(lowercaseLinkString,
-                                   MessageElementFlag::LowercaseLink, textColor)
+        this->emplace<LinkElement>(lowercaseLinkString,
+                                   MessageElementFlag::LowercaseLink, textColor,
+                                   resolveLinkInfo)
             ->setLink(linkElement);
     auto linkMEOriginal =
-        this->emplace<TextElement>(origLink, MessageElementFlag::OriginalLink,
-                                   textColor)
+        this->emplace<LinkElement>(origLink, MessageElementFlag::OriginalLink,
+                                   textColor, resolveLinkInfo)
             ->setLink(linkElement);
 
-    LinkResolver::getLinkInfo(
-        matchedLink, nullptr,
-        [weakMessage = this->weakOf(), linkMELowercase, linkMEOriginal,
-         matchedLink](QString tooltipText, Link originalLink,
-                      ImagePtr thumbnail) {
-            auto shared = weakMessage.lock();
-            if (!shared)
-            {
-                return;
-            }
-            if (!tooltipText.isEmpty())
-            {
-                linkMELowercase->setTooltip(tooltipText);
-                linkMEOriginal->setTooltip(tooltipText);
-            }
-            if (originalLink.value != matchedLink &&
-                !originalLink.value.isEmpty())
-            {
-                linkMELowercase->setLink(originalLink)->updateLink();
-                linkMEOriginal->setLink(originalLink)->updateLink();
-            }
-            linkMELowercase->setThumbnail(thumbnail);
-            linkMELowercase->setThumbnailType(
-                MessageElement::ThumbnailType::Link_Thumbnail);
-            linkMEOriginal->setThumbnail(thumbnail);
-            linkMEOriginal->setThumbnailType(
-                MessageElement::ThumbnailType::Link_Thumbnail);
-        });
+    // called once the link gets laid out for the first time
+    *resolveLinkInfo = [weakMessage = this->weakOf(), linkMELowercase,
+                        linkMEOriginal, matchedLink] {
+        LinkResolver::getLinkInfo(
+            matchedLink, nullptr,
+            [weakMessage, linkMELowercase, linkMEOriginal, matchedLink](
+                QString tooltipText, Link originalLink, ImagePtr thumbnail) {
+                auto shared = weakMessage.lock();
+                if (!shared)
+                {
+                    return;
+                }
+                if (!tooltipText.isEmpty())
+                {
+                    linkMELowercase->setTooltip(tooltipText);
+                    linkMEOriginal->setTooltip(tooltipText);
+                }
+                if (originalLink.value != matchedLink &&
+                    !originalLink.value.isEmpty())
+                {
+                    linkMELowercase->setLink(originalLink)->updateLink();
+                    linkMEOriginal->setLink(originalLink)->updateLink();
+                }
+                linkMELowercase->setThumbnail(thumbnail);
+                linkMELowercase->setThumbnailType(
+                    MessageElement::ThumbnailType::Link_Thumbnail);
+                linkMEOriginal->setThumbnail(thumbnail);
+                linkMEOriginal->setThumbnailType(
+                    MessageElement::ThumbnailType::Link_Thumbnail);
+            });
+    };
 }
 
 TextElement *MessageBuilder::emplaceSystemTextAndUpdate(const QString &text,
@@ -18,17 +18,30 @@ namespace {
         "(\u0003(\\d{1,2})?(,(\\d{1,2}))?|\u000f)",
         QRegularExpression::UseUnicodePropertiesOption);
 
+    auto &elementCount = DebugCount::counter("message elements");
+
+    int64_t stringBytes(const QString &string)
+    {
+        return int64_t(string.capacity()) * sizeof(QChar);
+    }
+
 }  // namespace
 
 MessageElement::MessageElement(MessageElementFlags flags)
     : flags_(flags)
 {
-    DebugCount::increase("message elements");
+    elementCount.increase();
 }
 
 MessageElement::~MessageElement()
 {
-    DebugCount::decrease("message elements");
+    elementCount.decrease();
+}
+
+int64_t MessageElement::memoryUsage() const
+{
+    return sizeof(MessageElement) + stringBytes(this->text_) +
+           stringBytes(this->link_.value) + stringBytes(this->tooltip_);
 }
 
 MessageElement *MessageElement::setLink(const Link &link)
@@ -157,6 +170,12 @@ EmotePtr EmoteElement::getEmote() const
     return this->emote_;
 }
 
+int64_t EmoteElement::memoryUsage() const
+{
+    return MessageElement::memoryUsage() + sizeof(EmoteElement) -
+           sizeof(MessageElement) + this->textElement_->memoryUsage();
+}
+
 void EmoteElement::addToContainer(MessageLayoutContainer &container,
                                   MessageElementFlags flags)
 {
@@ -285,6 +304,18 @@ TextElement::TextElement(const QString &text, MessageElementFlags flags,
     }
 }
 
+int64_t TextElement::memoryUsage() const
+{
+    auto usage = MessageElement::memoryUsage() + sizeof(TextElement) -
+                 sizeof(MessageElement) +
+                 int64_t(this->words_.capacity()) * sizeof(Word);
+    for (const auto &word : this->words_)
+    {
+        usage += stringBytes(word.text);
+    }
+    return usage;
+}
+
 void TextElement::addToContainer(MessageLayoutContainer &container,
                                  MessageElementFlags flags)
 {
@@ -386,6 +417,38 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
     }
 }
 
+// LINK
+LinkElement::LinkElement(
+    const QString &text, MessageElementFlags flags, const MessageColor &color,
+    std::shared_ptr<std::function<void()>> resolveLinkInfo)
+    : TextElement(text, flags, color)
+    , resolveLinkInfo_(std::move(resolveLinkInfo))
+{
+}
+
+int64_t LinkElement::memoryUsage() const
+{
+    return TextElement::memoryUsage() + sizeof(LinkElement) -
+           sizeof(TextElement);
+}
+
+void LinkElement::addToContainer(MessageLayoutContainer &container,
+                                 MessageElementFlags flags)
+{
+    if (this->resolveLinkInfo_ && flags.hasAny(this->getFlags()))
+    {
+        // the other element of the link shares the function
+        if (auto resolve = std::move(*this->resolveLinkInfo_))
+        {
+            *this->resolveLinkInfo_ = nullptr;
+            resolve();
+        }
+        this->resolveLinkInfo_.reset();
+    }
+
+    TextElement::addToContainer(container, flags);
+}
+
 // TIMESTAMP
 TimestampElement::TimestampElement(QTime time)
     : MessageElement(MessageElementFlag::Timestamp)
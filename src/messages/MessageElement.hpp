@@ -11,6 +11,7 @@
 #include <QTime>
 #include <boost/noncopyable.hpp>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <pajlada/signals/signalholder.hpp>
 #include <vector>
@@ -160,6 +161,9 @@ public:
     virtual void addToContainer(MessageLayoutContainer &container,
                                 MessageElementFlags flags) = 0;
 
+    // Approximate amount of memory used by the element
+    virtual int64_t memoryUsage() const;
+
     pajlada::Signals::NoArgSignal linkChanged;
 
 protected:
@@ -214,6 +218,7 @@ public:
 
     void addToContainer(MessageLayoutContainer &container,
                         MessageElementFlags flags) override;
+    int64_t memoryUsage() const override;
 
 private:
     MessageColor color_;
@@ -226,6 +231,25 @@ private:
     std::vector<Word> words_;
 };
 
+// text of a link, its link info is only resolved once the link gets laid out,
+// messages that are never shown don't cause any requests
+class LinkElement : public TextElement
+{
+public:
+    // resolveLinkInfo is shared between the elements of one link and is
+    // called once, by the first of them that gets laid out
+    LinkElement(const QString &text, MessageElementFlags flags,
+                const MessageColor &color,
+                std::shared_ptr<std::function<void()>> resolveLinkInfo);
+
+    void addToContainer(MessageLayoutContainer &container,
+                        MessageElementFlags flags) override;
+    int64_t memoryUsage() const override;
+
+private:
+    std::shared_ptr<std::function<void()>> resolveLinkInfo_;
+};
+
 // contains emote data and will pick the emote based on :
 //   a) are images for the emote type enabled
 //   b) which size it wants
@@ -236,6 +260,7 @@ public:
 
     void addToContainer(MessageLayoutContainer &container,
                         MessageElementFlags flags_) override;
+    int64_t memoryUsage() const override;
     EmotePtr getEmote() const;
 
 protected:
@@ -9,6 +9,7 @@
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/StreamerMode.hpp"
+#include "util/StringPool.hpp"
 
 namespace chatterino {
 
@@ -110,7 +111,7 @@ void SharedMessageBuilder::parseUsernameColor()
 void SharedMessageBuilder::parseUsername()
 {
     // username
-    this->userName = this->ircMessage->nick();
+    this->userName = StringPool::intern(this->ircMessage->nick());
 
     this->message().loginName = this->userName;
 }
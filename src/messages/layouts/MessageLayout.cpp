@@ -5,6 +5,7 @@
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
+#include "messages/layouts/PixmapPool.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
@@ -13,8 +14,11 @@
 
 #include <QApplication>
 #include <QDebug>
+#include <QFontDatabase>
+#include <QImage>
 #include <QPainter>
 #include <QThread>
+#include <QtConcurrent>
 #include <QtGlobal>
 
 #define MARGIN_LEFT (int)(8 * this->scale)
@@ -27,6 +31,9 @@ namespace chatterino {
 
 namespace {
 
+    // fewer outdated buffers are drawn in the GUI thread
+    constexpr size_t MIN_THREADED_BUFFERS = 4;
+
     QColor blendColors(const QColor &base, const QColor &apply)
     {
         const qreal &alpha = apply.alphaF();
@@ -36,18 +43,38 @@ namespace {
                        base.blueF() * (1 - alpha) + apply.blueF() * alpha);
         return result;
     }
+
+    auto &layoutCount = DebugCount::counter("message layout");
+    auto &layoutBytes =
+        DebugCount::counter("message layout bytes", DebugCount::Unit::Bytes);
+    auto &bufferCount = DebugCount::counter("message drawing buffers");
+    auto &bufferBytes = DebugCount::counter("message drawing buffer bytes",
+                                            DebugCount::Unit::Bytes);
+    auto &rasterizedBuffers =
+        DebugCount::counter("message drawing buffers rasterized in threads");
+
+    int64_t pixmapBytes(const QPixmap &pixmap)
+    {
+        return int64_t(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    }
 }  // namespace
 
 MessageLayout::MessageLayout(MessagePtr message)
     : message_(message)
     , container_(std::make_shared<MessageLayoutContainer>())
 {
-    DebugCount::increase("message layout");
+    layoutCount.increase();
+    layoutBytes.increase(sizeof(MessageLayout) +
+                         sizeof(MessageLayoutContainer));
 }
 
 MessageLayout::~MessageLayout()
 {
-    DebugCount::decrease("message layout");
+    this->deleteBuffer();
+
+    layoutCount.decrease();
+    layoutBytes.decrease(sizeof(MessageLayout) +
+                         sizeof(MessageLayoutContainer));
 }
 
 const Message *MessageLayout::getMessage()
@@ -163,32 +190,23 @@ void MessageLayout::actuallyLayout(int width, MessageElementFlags flags)
     {
         this->flags.set(MessageLayoutFlag::Collapsed);
     }
+
+    this->message_->latency.record(MessageLatency::Stage::LaidOut);
 }
 
 // Painting
 void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
                           Selection &selection, bool isLastReadMessage,
-                          bool isWindowFocused, bool isMentions)
+                          bool isWindowFocused, bool isMentions,
+                          PixmapPool &pool)
 {
     auto app = getApp();
     QPixmap *pixmap = this->buffer_.get();
 
-    // create new buffer if required
+    // take a new buffer if required
     if (!pixmap)
     {
-#if defined(Q_OS_MACOS) || defined(Q_OS_LINUX)
-        pixmap = new QPixmap(int(width * painter.device()->devicePixelRatioF()),
-                             int(container_->getHeight() *
-                                 painter.device()->devicePixelRatioF()));
-        pixmap->setDevicePixelRatio(painter.device()->devicePixelRatioF());
-#else
-        pixmap =
-            new QPixmap(width, std::max(16, this->container_->getHeight()));
-#endif
-
-        this->buffer_ = std::shared_ptr<QPixmap>(pixmap);
-        this->bufferValid_ = false;
-        DebugCount::increase("message drawing buffers");
+        pixmap = this->takeBuffer(painter, width, pool);
     }
 
     if (!this->bufferValid_ || !selection.isEmpty())
@@ -196,8 +214,9 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
         this->updateBuffer(pixmap, messageIndex, selection);
     }
 
-    // draw on buffer
-    painter.drawPixmap(0, y, *pixmap);
+    // draw on buffer, pooled buffers are larger than the message
+    painter.drawPixmap(QPointF(0, y), *pixmap,
+                       QRectF(QPointF(0, 0), this->bufferSize_));
     //    painter.drawPixmap(0, y, this->container.width,
     //    this->container.getHeight(), *pixmap);
 
@@ -207,7 +226,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     // draw disabled
     if (this->message_->flags.has(MessageFlag::Disabled))
     {
-        painter.fillRect(0, y, pixmap->width(), pixmap->height(),
+        painter.fillRect(QRect(QPoint(0, y), this->bufferSize_),
                          app->themes->messages.disabled);
         //        painter.fillRect(0, y, pixmap->width(), pixmap->height(),
         //                         QBrush(QColor(64, 64, 64, 64)));
@@ -215,7 +234,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
 
     if (this->message_->flags.has(MessageFlag::RecentMessage))
     {
-        painter.fillRect(0, y, pixmap->width(), pixmap->height(),
+        painter.fillRect(QRect(QPoint(0, y), this->bufferSize_),
                          app->themes->messages.disabled);
     }
 
@@ -225,7 +244,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
         getSettings()->enableRedeemedHighlight.getValue())
     {
         painter.fillRect(
-            0, y, this->scale_ * 4, pixmap->height(),
+            0, y, this->scale_ * 4, this->bufferSize_.height(),
             *ColorProvider::instance().color(ColorType::RedeemedHighlight));
     }
 
@@ -262,10 +281,111 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
                                 getSettings()->lastMessagePattern.getValue()));
 
         painter.fillRect(0, y + this->container_->getHeight() - 1,
-                         pixmap->width(), 1, brush);
+                         this->bufferSize_.width(), 1, brush);
     }
 
     this->bufferValid_ = true;
+    this->message_->latency.record(MessageLatency::Stage::Painted);
+}
+
+QPixmap *MessageLayout::takeBuffer(QPainter &painter, int width,
+                                   PixmapPool &pool)
+{
+#if defined(Q_OS_MACOS) || defined(Q_OS_LINUX)
+    auto ratio = painter.device()->devicePixelRatioF();
+    this->bufferSize_ = QSize(int(width * ratio),
+                              int(this->container_->getHeight() * ratio));
+#else
+    qreal ratio = 1;
+    this->bufferSize_ =
+        QSize(width, std::max(16, this->container_->getHeight()));
+#endif
+
+    this->buffer_ = pool.take(this->bufferSize_, ratio);
+    this->bufferValid_ = false;
+    bufferCount.increase();
+    bufferBytes.increase(pixmapBytes(*this->buffer_));
+
+    return this->buffer_.get();
+}
+
+void MessageLayout::rasterizeBuffers(
+    const std::vector<MessageLayout *> &layouts, QPainter &painter, int width,
+    PixmapPool &pool)
+{
+    static const bool supported =
+        QFontDatabase::supportsThreadedFontRendering();
+    if (!supported)
+    {
+        return;
+    }
+
+    struct Job {
+        MessageLayout *layout;
+        QPixmap *buffer;
+        QColor background;
+        QImage image;
+    };
+
+    std::vector<MessageLayout *> outdated;
+    for (auto *layout : layouts)
+    {
+        if (!layout->buffer_ || !layout->bufferValid_)
+        {
+            outdated.push_back(layout);
+        }
+    }
+    // not worth waking up the threads for
+    if (outdated.size() < MIN_THREADED_BUFFERS)
+    {
+        return;
+    }
+
+    std::vector<Job> jobs;
+    jobs.reserve(outdated.size());
+    for (auto *layout : outdated)
+    {
+        auto *buffer = layout->buffer_
+                           ? layout->buffer_.get()
+                           : layout->takeBuffer(painter, width, pool);
+        if (buffer->isNull())
+        {
+            continue;
+        }
+
+        QImage image(layout->bufferSize_,
+                     QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(buffer->devicePixelRatio());
+        jobs.push_back(
+            {layout, buffer, layout->backgroundColor(), std::move(image)});
+    }
+
+    // the GUI thread is blocked meanwhile, so nothing changes the layouts
+    QtConcurrent::blockingMap(jobs, [](Job &job) {
+        QPainter painter(&job.image);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+        painter.fillRect(job.image.rect(), job.background);
+        job.layout->container_->paintElements(
+            painter, MessageLayoutContainer::PaintPass::ThreadSafe);
+    });
+
+    // upload the images and paint the pixmaps, which only works in the GUI
+    // thread
+    for (auto &job : jobs)
+    {
+        QPainter painter(job.buffer);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(QPoint(0, 0), job.image);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+        job.layout->container_->paintElements(
+            painter, MessageLayoutContainer::PaintPass::GuiThreadOnly);
+        job.layout->bufferValid_ = true;
+    }
+
+    rasterizedBuffers.increase(int64_t(jobs.size()));
 }
 
 void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
@@ -274,13 +394,36 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
     if (buffer->isNull())
         return;
 
-    auto app = getApp();
-    auto settings = getSettings();
-
     QPainter painter(buffer);
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
 
     // draw background
+    painter.fillRect(buffer->rect(), this->backgroundColor());
+
+    // draw message
+    this->container_->paintElements(painter);
+
+#ifdef FOURTF
+    // debug
+    painter.setPen(QColor(255, 0, 0));
+    painter.drawRect(buffer->rect().x(), buffer->rect().y(),
+                     buffer->rect().width() - 1, buffer->rect().height() - 1);
+
+    QTextOption option;
+    option.setAlignment(Qt::AlignRight | Qt::AlignTop);
+
+    painter.drawText(QRectF(1, 1, this->container_->getWidth() - 3, 1000),
+                     QString::number(this->layoutCount_) + ", " +
+                         QString::number(++this->bufferUpdatedCount_),
+                     option);
+#endif
+}
+
+QColor MessageLayout::backgroundColor() const
+{
+    auto app = getApp();
+    auto settings = getSettings();
+
     QColor backgroundColor = [this, &app] {
         if (getSettings()->alternateMessages.getValue() &&
             this->flags.has(MessageLayoutFlag::AlternateBackground))
@@ -328,25 +471,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
         backgroundColor = QColor("#4A273D");
     }
 
-    painter.fillRect(buffer->rect(), backgroundColor);
-
-    // draw message
-    this->container_->paintElements(painter);
-
-#ifdef FOURTF
-    // debug
-    painter.setPen(QColor(255, 0, 0));
-    painter.drawRect(buffer->rect().x(), buffer->rect().y(),
-                     buffer->rect().width() - 1, buffer->rect().height() - 1);
-
-    QTextOption option;
-    option.setAlignment(Qt::AlignRight | Qt::AlignTop);
-
-    painter.drawText(QRectF(1, 1, this->container_->getWidth() - 3, 1000),
-                     QString::number(this->layoutCount_) + ", " +
-                         QString::number(++this->bufferUpdatedCount_),
-                     option);
-#endif
+    return backgroundColor;
 }
 
 void MessageLayout::invalidateBuffer()
@@ -358,7 +483,8 @@ void MessageLayout::deleteBuffer()
 {
     if (this->buffer_ != nullptr)
     {
-        DebugCount::decrease("message drawing buffers");
+        bufferCount.decrease();
+        bufferBytes.decrease(pixmapBytes(*this->buffer_));
 
         this->buffer_ = nullptr;
     }
@@ -7,6 +7,7 @@
 #include <boost/noncopyable.hpp>
 #include <cinttypes>
 #include <memory>
+#include <vector>
 
 namespace chatterino {
 
@@ -16,6 +17,7 @@ using MessagePtr = std::shared_ptr<const Message>;
 struct Selection;
 struct MessageLayoutContainer;
 class MessageLayoutElement;
+class PixmapPool;
 
 enum class MessageElementFlag : int64_t;
 using MessageElementFlags = FlagsEnum<MessageElementFlag>;
@@ -47,11 +49,18 @@ public:
     // Painting
     void paint(QPainter &painter, int width, int y, int messageIndex,
                Selection &selection, bool isLastReadMessage,
-               bool isWindowFocused, bool isMentions);
+               bool isWindowFocused, bool isMentions, PixmapPool &pool);
     void invalidateBuffer();
     void deleteBuffer();
     void deleteCache();
 
+    // Redraws the outdated buffers of the layouts in the thread pool, only
+    // the images are drawn in the GUI thread. Does nothing if there are only
+    // a few or if fonts can't be rendered outside of the GUI thread.
+    static void rasterizeBuffers(const std::vector<MessageLayout *> &layouts,
+                                 QPainter &painter, int width,
+                                 PixmapPool &pool);
+
     // Elements
     const MessageLayoutElement *getElementAt(QPoint point);
     int getLastCharacterIndex() const;
@@ -68,6 +77,8 @@ private:
     MessagePtr message_;
     std::shared_ptr<MessageLayoutContainer> container_;
     std::shared_ptr<QPixmap> buffer_{};
+    // the part of buffer_ that is used, in device pixels
+    QSize bufferSize_;
     bool bufferValid_ = false;
 
     int height_ = 0;
@@ -84,7 +95,9 @@ private:
 
     // methods
     void actuallyLayout(int width, MessageElementFlags flags);
+    QPixmap *takeBuffer(QPainter &painter, int width, PixmapPool &pool);
     void updateBuffer(QPixmap *pixmap, int messageIndex, Selection &selection);
+    QColor backgroundColor() const;
 };
 
 using MessageLayoutPtr = std::shared_ptr<MessageLayout>;
@@ -303,10 +303,17 @@ MessageLayoutElement *MessageLayoutContainer::getElementAt(QPoint point)
 }
 
 // painting
-void MessageLayoutContainer::paintElements(QPainter &painter)
+void MessageLayoutContainer::paintElements(QPainter &painter, PaintPass pass)
 {
     for (const std::unique_ptr<MessageLayoutElement> &element : this->elements_)
     {
+        if (pass != PaintPass::All &&
+            element->paintsInGuiThreadOnly() !=
+                (pass == PaintPass::GuiThreadOnly))
+        {
+            continue;
+        }
+
 #ifdef FOURTF
         painter.setPen(QColor(0, 255, 0));
         painter.drawRect(element->getRect());
@@ -67,7 +67,14 @@ struct MessageLayoutContainer {
     MessageLayoutElement *getElementAt(QPoint point);
 
     // painting
-    void paintElements(QPainter &painter);
+    enum class PaintPass {
+        All,
+        // the elements that may be painted outside of the GUI thread
+        ThreadSafe,
+        // the rest
+        GuiThreadOnly,
+    };
+    void paintElements(QPainter &painter, PaintPass pass = PaintPass::All);
     void paintAnimatedElements(QPainter &painter, int yOffset);
     void paintSelection(QPainter &painter, int messageIndex,
                         Selection &selection, int yOffset);
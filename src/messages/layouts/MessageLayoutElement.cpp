@@ -6,6 +6,7 @@
 #include "messages/Image.hpp"
 #include "messages/MessageElement.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
+#include "singletons/Fonts.hpp"
 #include "singletons/Theme.hpp"
 #include "util/DebugCount.hpp"
 
@@ -13,6 +14,11 @@
 #include <QPainter>
 
 namespace chatterino {
+namespace {
+    auto &layoutElementCount = DebugCount::counter("message layout elements");
+    auto &layoutBytes =
+        DebugCount::counter("message layout bytes", DebugCount::Unit::Bytes);
+}  // namespace
 
 const QRect &MessageLayoutElement::getRect() const
 {
@@ -24,12 +30,14 @@ MessageLayoutElement::MessageLayoutElement(MessageElement &creator,
     : creator_(creator)
 {
     this->rect_.setSize(size);
-    DebugCount::increase("message layout elements");
+    layoutElementCount.increase();
+    layoutBytes.increase(sizeof(MessageLayoutElement));
 }
 
 MessageLayoutElement::~MessageLayoutElement()
 {
-    DebugCount::decrease("message layout elements");
+    layoutElementCount.decrease();
+    layoutBytes.decrease(sizeof(MessageLayoutElement));
 }
 
 MessageElement &MessageLayoutElement::getCreator() const
@@ -81,6 +89,11 @@ FlagsEnum<MessageElementFlag> MessageLayoutElement::getFlags() const
     return this->creator_.getFlags();
 }
 
+bool MessageLayoutElement::paintsInGuiThreadOnly() const
+{
+    return false;
+}
+
 //
 // IMAGE
 //
@@ -169,6 +182,12 @@ int ImageLayoutElement::getXFromIndex(int index)
     }
 }
 
+bool ImageLayoutElement::paintsInGuiThreadOnly() const
+{
+    // pixmaps may only be used in the GUI thread
+    return true;
+}
+
 //
 // IMAGE WITH BACKGROUND
 //
@@ -207,6 +226,7 @@ TextLayoutElement::TextLayoutElement(MessageElement &_creator, QString &_text,
     , color_(_color)
     , style_(_style)
     , scale_(_scale)
+    , font_(getFonts()->getFont(_style, _scale))
 {
     this->setText(_text);
 }
@@ -240,11 +260,9 @@ int TextLayoutElement::getSelectionIndexCount() const
 
 void TextLayoutElement::paint(QPainter &painter)
 {
-    auto app = getApp();
-
     painter.setPen(this->color_);
 
-    painter.setFont(app->fonts->getFont(this->style_, this->scale_));
+    painter.setFont(this->font_);
 
     painter.drawText(
         QRectF(this->getRect().x(), this->getRect().y(), 10000, 10000),
@@ -328,6 +346,8 @@ TextIconLayoutElement::TextIconLayoutElement(MessageElement &creator,
     , scale(_scale)
     , line1(_line1)
     , line2(_line2)
+    , font_(getFonts()->getFont(FontStyle::Tiny, _scale))
+    , color_(getApp()->themes->messages.textColors.system)
 {
 }
 
@@ -343,12 +363,8 @@ int TextIconLayoutElement::getSelectionIndexCount() const
 
 void TextIconLayoutElement::paint(QPainter &painter)
 {
-    auto app = getApp();
-
-    QFont font = app->fonts->getFont(FontStyle::Tiny, this->scale);
-
-    painter.setPen(app->themes->messages.textColors.system);
-    painter.setFont(font);
+    painter.setPen(this->color_);
+    painter.setFont(this->font_);
 
     QTextOption option;
     option.setAlignment(Qt::AlignHCenter);
@@ -411,15 +427,13 @@ MultiColorTextLayoutElement::MultiColorTextLayoutElement(
 
 void MultiColorTextLayoutElement::paint(QPainter &painter)
 {
-    auto app = getApp();
-
     painter.setPen(this->color_);
 
-    painter.setFont(app->fonts->getFont(this->style_, this->scale_));
+    painter.setFont(this->font_);
 
     int xOffset = 0;
 
-    auto metrics = app->fonts->getFontMetrics(this->style_, this->scale_);
+    QFontMetrics metrics(this->font_);
 
     for (const auto &segment : this->segments_)
     {
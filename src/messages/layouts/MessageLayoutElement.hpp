@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QFont>
 #include <QPoint>
 #include <QRect>
 #include <QString>
@@ -42,6 +43,10 @@ public:
     virtual int getMouseOverIndex(const QPoint &abs) const = 0;
     virtual int getXFromIndex(int index) = 0;
 
+    // Elements that don't draw pixmaps may be painted in other threads while
+    // the GUI thread waits for them. Their paint() must not touch singletons.
+    virtual bool paintsInGuiThreadOnly() const;
+
     const Link &getLink() const;
     const QString &getText() const;
     FlagsEnum<MessageElementFlag> getFlags() const;
@@ -71,6 +76,7 @@ protected:
     void paintAnimated(QPainter &painter, int yOffset) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(int index) override;
+    bool paintsInGuiThreadOnly() const override;
 
     ImagePtr image_;
 };
@@ -110,6 +116,8 @@ protected:
     QColor color_;
     FontStyle style_;
     float scale_;
+    // resolved while laying out, so paint() doesn't need the Fonts singleton
+    QFont font_;
 
     std::vector<pajlada::Signals::ScopedConnection> managedConnections_;
 };
@@ -135,6 +143,8 @@ private:
     float scale;
     QString line1;
     QString line2;
+    QFont font_;
+    QColor color_;
 };
 
 struct PajSegment {
@@ -0,0 +1,149 @@
+#include "messages/layouts/PixmapPool.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QObject>
+#include <QWidget>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace chatterino {
+namespace {
+    auto &allocated = DebugCount::counter("pixmap pool allocations");
+    auto &reused = DebugCount::counter("pixmap pool reuses");
+    auto &idleBytes =
+        DebugCount::counter("pixmap pool idle bytes", DebugCount::Unit::Bytes);
+    auto &totalBytes =
+        DebugCount::counter("pixmap pool bytes", DebugCount::Unit::Bytes);
+    auto &highWaterBytes = DebugCount::counter("pixmap pool high water bytes",
+                                               DebugCount::Unit::Bytes);
+
+    int64_t pixmapBytes(const QPixmap &pixmap)
+    {
+        return int64_t(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    }
+
+    // Rounds up to a multiple of 32 for small sizes and to one of 8 steps
+    // per power of two above that, so at most 12.5% of a buffer is unused.
+    int roundUp(int value)
+    {
+        value = std::max(value, 1);
+        if (value <= 256)
+        {
+            return (value + 31) & ~31;
+        }
+
+        int step = (1 << (31 - qCountLeadingZeroBits(quint32(value)))) / 8;
+        return (value + step - 1) / step * step;
+    }
+}  // namespace
+
+std::shared_ptr<PixmapPool> PixmapPool::forWindow(QWidget *window)
+{
+    assertInGuiThread();
+
+    static std::unordered_map<QWidget *, std::shared_ptr<PixmapPool>> pools;
+
+    auto it = pools.find(window);
+    if (it != pools.end())
+    {
+        return it->second;
+    }
+
+    auto pool = std::make_shared<PixmapPool>();
+    pools.emplace(window, pool);
+    QObject::connect(window, &QObject::destroyed, [window] {
+        // buffers that are still in use are freed once they are dropped
+        pools.erase(window);
+    });
+    return pool;
+}
+
+PixmapPool::~PixmapPool()
+{
+    idleBytes.decrease(this->idleBytes_);
+    totalBytes.decrease(this->idleBytes_);
+}
+
+QSize PixmapPool::sizeClass(QSize size)
+{
+    return {roundUp(size.width()), roundUp(size.height())};
+}
+
+std::shared_ptr<QPixmap> PixmapPool::take(QSize size, qreal devicePixelRatio)
+{
+    size = sizeClass(size);
+
+    QPixmap *pixmap = nullptr;
+
+    // the most recently returned buffer is the most likely to be cached by the
+    // graphics backend
+    for (auto it = this->idle_.rbegin(); it != this->idle_.rend(); ++it)
+    {
+        if (it->size == size && it->devicePixelRatio == devicePixelRatio)
+        {
+            pixmap = it->pixmap.release();
+            this->idle_.erase(std::next(it).base());
+
+            this->idleBytes_ -= pixmapBytes(*pixmap);
+            idleBytes.decrease(pixmapBytes(*pixmap));
+            reused.increase();
+            break;
+        }
+    }
+
+    if (!pixmap)
+    {
+        pixmap = new QPixmap(size);
+        pixmap->setDevicePixelRatio(devicePixelRatio);
+
+        allocated.increase();
+        totalBytes.increase(pixmapBytes(*pixmap));
+        highWaterBytes.set(
+            std::max(highWaterBytes.value(), totalBytes.value()));
+    }
+
+    return std::shared_ptr<QPixmap>(
+        pixmap, [pool = this->weak_from_this()](QPixmap *pixmap) {
+            give(pool, pixmap);
+        });
+}
+
+void PixmapPool::give(const std::weak_ptr<PixmapPool> &weakPool,
+                      QPixmap *pixmap)
+{
+    auto pool = weakPool.lock();
+    if (!pool || pixmap->isNull())
+    {
+        totalBytes.decrease(pixmapBytes(*pixmap));
+        delete pixmap;
+        return;
+    }
+
+    auto bytes = pixmapBytes(*pixmap);
+    pool->idle_.push_back({pixmap->size(), pixmap->devicePixelRatio(),
+                           std::unique_ptr<QPixmap>(pixmap)});
+    pool->idleBytes_ += bytes;
+    idleBytes.increase(bytes);
+
+    pool->trim();
+}
+
+void PixmapPool::trim()
+{
+    size_t dropped = 0;
+    while (this->idleBytes_ > MAX_IDLE_BYTES && dropped < this->idle_.size())
+    {
+        auto bytes = pixmapBytes(*this->idle_[dropped].pixmap);
+        this->idleBytes_ -= bytes;
+        idleBytes.decrease(bytes);
+        totalBytes.decrease(bytes);
+        dropped++;
+    }
+
+    this->idle_.erase(this->idle_.begin(), this->idle_.begin() + dropped);
+}
+
+}  // namespace chatterino
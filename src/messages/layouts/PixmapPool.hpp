@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QPixmap>
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class QWidget;
+
+namespace chatterino {
+
+/// Recycles the pixmaps that messages are drawn into. When a message scrolls
+/// off screen it gives its buffer back, and the next message that needs a
+/// buffer of the same size class takes it instead of allocating a new one.
+///
+/// Sizes are rounded up to size classes, so a buffer is usually a bit larger
+/// than the message drawn into it. Every window has its own pool. Idle
+/// buffers beyond MAX_IDLE_BYTES are freed, oldest first.
+/// Only used from the GUI thread.
+class PixmapPool : public std::enable_shared_from_this<PixmapPool>,
+                   boost::noncopyable
+{
+public:
+    static constexpr int64_t MAX_IDLE_BYTES = 24 * 1024 * 1024;
+
+    static std::shared_ptr<PixmapPool> forWindow(QWidget *window);
+
+    ~PixmapPool();
+
+    /// Returns a pixmap of at least size device pixels with the given device
+    /// pixel ratio. It goes back to the pool once the last reference to it is
+    /// dropped. Its contents are undefined.
+    std::shared_ptr<QPixmap> take(QSize size, qreal devicePixelRatio);
+
+    /// Returns the size of the pixmaps take() hands out for the given size
+    static QSize sizeClass(QSize size);
+
+private:
+    struct Idle {
+        QSize size;
+        qreal devicePixelRatio;
+        std::unique_ptr<QPixmap> pixmap;
+    };
+
+    static void give(const std::weak_ptr<PixmapPool> &pool, QPixmap *pixmap);
+
+    void trim();
+
+    // oldest first
+    std::vector<Idle> idle_;
+    int64_t idleBytes_ = 0;
+};
+
+}  // namespace chatterino
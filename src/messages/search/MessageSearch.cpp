@@ -0,0 +1,157 @@
+#include "messages/search/MessageSearch.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QThread>
+#include <QtConcurrent>
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <mutex>
+
+namespace chatterino {
+namespace {
+    // don't spawn a worker for a handful of messages
+    constexpr size_t MIN_CHUNK_SIZE = 256;
+    // how often a worker checks whether the search was cancelled
+    constexpr size_t CANCEL_CHECK_INTERVAL = 64;
+}  // namespace
+
+struct MessageSearch::Query {
+    std::shared_ptr<const std::vector<MessagePtr>> messages;
+    Predicates predicates;
+    ResultCallback onResults;
+    FinishedCallback onFinished;
+
+    std::atomic<bool> cancelled{false};
+
+    std::mutex mutex;
+    std::vector<boost::optional<std::vector<MessagePtr>>> chunks;
+
+    // only accessed from the GUI thread
+    size_t nextChunk = 0;
+
+    bool matches(const Message &message) const
+    {
+        for (const auto &predicate : this->predicates)
+        {
+            // Discard the message as soon as one predicate fails
+            if (!predicate->appliesTo(message))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Hands all chunks that are done and whose predecessors have been
+    // delivered to the result callback
+    void deliver()
+    {
+        assertInGuiThread();
+
+        while (!this->cancelled && this->nextChunk < this->chunks.size())
+        {
+            std::vector<MessagePtr> results;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+
+                auto &chunk = this->chunks[this->nextChunk];
+                if (!chunk)
+                {
+                    return;
+                }
+                results = std::move(*chunk);
+                chunk->clear();
+            }
+
+            this->nextChunk++;
+            if (!results.empty())
+            {
+                this->onResults(std::move(results));
+            }
+        }
+
+        if (!this->cancelled && this->nextChunk == this->chunks.size())
+        {
+            // don't call onFinished twice
+            this->nextChunk++;
+            this->onFinished();
+        }
+    }
+};
+
+MessageSearch::~MessageSearch()
+{
+    this->cancel();
+}
+
+void MessageSearch::start(
+    std::shared_ptr<const std::vector<MessagePtr>> messages,
+    Predicates predicates, ResultCallback onResults,
+    FinishedCallback onFinished)
+{
+    assertInGuiThread();
+
+    this->cancel();
+
+    auto query = std::make_shared<Query>();
+    query->messages = std::move(messages);
+    query->predicates = std::move(predicates);
+    query->onResults = std::move(onResults);
+    query->onFinished = std::move(onFinished);
+    this->query_ = query;
+
+    const auto size = query->messages->size();
+    const auto threads = size_t(std::max(1, QThread::idealThreadCount()));
+    const auto chunkCount =
+        std::max<size_t>(1, std::min(threads, size / MIN_CHUNK_SIZE));
+    const auto chunkSize = (size + chunkCount - 1) / chunkCount;
+
+    query->chunks.resize(chunkCount);
+
+    for (size_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        QtConcurrent::run([query, chunk, chunkSize] {
+            const auto &messages = *query->messages;
+            const auto begin = chunk * chunkSize;
+            const auto end = std::min(messages.size(), begin + chunkSize);
+
+            std::vector<MessagePtr> results;
+            for (auto i = begin; i < end; i++)
+            {
+                if ((i - begin) % CANCEL_CHECK_INTERVAL == 0 &&
+                    query->cancelled)
+                {
+                    return;
+                }
+
+                if (query->matches(*messages[i]))
+                {
+                    results.push_back(messages[i]);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(query->mutex);
+                query->chunks[chunk] = std::move(results);
+            }
+
+            postToThread([query] {
+                query->deliver();
+            });
+        });
+    }
+}
+
+void MessageSearch::cancel()
+{
+    if (this->query_)
+    {
+        this->query_->cancelled = true;
+        this->query_.reset();
+    }
+}
+
+}  // namespace chatterino
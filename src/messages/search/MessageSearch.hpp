@@ -0,0 +1,57 @@
+#pragma once
+
+#include "messages/search/MessagePredicate.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Searches a list of messages on worker threads.
+ *
+ * The messages are split into chunks which are searched in parallel. The
+ * matches are handed to the result callback on the GUI thread, chunk by chunk
+ * and in the order of the searched list.
+ *
+ * Starting a new search cancels the one that is currently running. Callbacks
+ * of a cancelled search are never invoked.
+ */
+class MessageSearch
+{
+public:
+    using Predicates = std::vector<std::unique_ptr<MessagePredicate>>;
+    using ResultCallback = std::function<void(std::vector<MessagePtr> &&)>;
+    using FinishedCallback = std::function<void()>;
+
+    MessageSearch() = default;
+    ~MessageSearch();
+
+    MessageSearch(const MessageSearch &) = delete;
+    MessageSearch &operator=(const MessageSearch &) = delete;
+
+    /**
+     * @brief Starts searching for messages that satisfy all predicates.
+     *
+     * Must be called from the GUI thread.
+     *
+     * @param messages      the messages to search
+     * @param predicates    predicates a message has to satisfy
+     * @param onResults     called with the matches of each chunk
+     * @param onFinished    called once all chunks have been delivered
+     */
+    void start(std::shared_ptr<const std::vector<MessagePtr>> messages,
+               Predicates predicates, ResultCallback onResults,
+               FinishedCallback onFinished);
+
+    /// Cancels the running search
+    void cancel();
+
+private:
+    struct Query;
+
+    std::shared_ptr<Query> query_;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,152 @@
+#include "messages/search/SearchQuery.hpp"
+
+#include "messages/search/AuthorPredicate.hpp"
+#include "messages/search/ChannelPredicate.hpp"
+#include "messages/search/LinkPredicate.hpp"
+#include "messages/search/SubstringPredicate.hpp"
+
+#include <QRegularExpression>
+
+namespace chatterino {
+namespace {
+    QStringList splitList(const QStringList &values)
+    {
+        QStringList result;
+        for (const auto &entry : values)
+        {
+            for (auto value : entry.split(',', QString::SkipEmptyParts))
+            {
+                if (value.startsWith('#'))
+                {
+                    value.remove(0, 1);
+                }
+                result << value;
+            }
+        }
+        return result;
+    }
+
+    // Every value of "next" has to be contained in "previous". An empty list
+    // doesn't restrict the results.
+    bool isSubset(const QStringList &next, const QStringList &previous)
+    {
+        if (previous.empty())
+        {
+            return true;
+        }
+
+        auto nextValues = splitList(next);
+        if (nextValues.empty())
+        {
+            return false;
+        }
+
+        auto previousValues = splitList(previous);
+        for (const auto &value : nextValues)
+        {
+            if (!previousValues.contains(value, Qt::CaseInsensitive))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+SearchQuery SearchQuery::parse(const QString &input)
+{
+    static QRegularExpression predicateRegex(R"(^(\w+):([\w,#-]+)$)");
+
+    SearchQuery query;
+    auto words = input.split(' ', QString::SkipEmptyParts);
+
+    for (auto it = words.begin(); it != words.end();)
+    {
+        if (auto match = predicateRegex.match(*it); match.hasMatch())
+        {
+            QString name = match.captured(1);
+            QString value = match.captured(2);
+
+            bool remove = true;
+
+            // match predicates
+            if (name == "from")
+            {
+                query.authors.append(value);
+            }
+            else if (name == "in")
+            {
+                query.channels.append(value);
+            }
+            else if (name == "has" && value == "link")
+            {
+                query.hasLink = true;
+            }
+            else if (name == "on" &&
+                     QDate::fromString(value, Qt::ISODate).isValid())
+            {
+                query.day = QDate::fromString(value, Qt::ISODate);
+            }
+            else
+            {
+                remove = false;
+            }
+
+            // remove or advance
+            it = remove ? words.erase(it) : ++it;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    query.text = words.join(" ");
+
+    if (query.text.size() >= 2 && query.text.startsWith('"') &&
+        query.text.endsWith('"'))
+    {
+        query.text = query.text.mid(1, query.text.size() - 2);
+    }
+
+    return query;
+}
+
+std::vector<std::unique_ptr<MessagePredicate>> SearchQuery::predicates() const
+{
+    auto predicates = std::vector<std::unique_ptr<MessagePredicate>>();
+
+    if (this->hasLink)
+        predicates.push_back(std::make_unique<LinkPredicate>());
+
+    if (!this->authors.empty())
+        predicates.push_back(std::make_unique<AuthorPredicate>(this->authors));
+
+    if (!this->channels.empty())
+        predicates.push_back(
+            std::make_unique<ChannelPredicate>(this->channels));
+
+    if (!this->text.isEmpty())
+        predicates.push_back(std::make_unique<SubstringPredicate>(this->text));
+
+    return predicates;
+}
+
+bool SearchQuery::narrows(const SearchQuery &previous) const
+{
+    if (previous.hasLink && !this->hasLink)
+    {
+        return false;
+    }
+
+    if (previous.day.isValid() && previous.day != this->day)
+    {
+        return false;
+    }
+
+    return isSubset(this->authors, previous.authors) &&
+           isSubset(this->channels, previous.channels) &&
+           this->text.contains(previous.text, Qt::CaseInsensitive);
+}
+
+}  // namespace chatterino
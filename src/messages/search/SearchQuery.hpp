@@ -0,0 +1,53 @@
+#pragma once
+
+#include "messages/search/MessagePredicate.hpp"
+
+#include <QDate>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief A search query split into its tags and the text to search for.
+ *
+ * Supported tags are "from:user1,user2", "in:#channel", "has:link" and
+ * "on:yyyy-MM-dd". The remaining words are searched for as one phrase,
+ * surrounding quotes are removed.
+ */
+struct SearchQuery {
+    QStringList authors;
+    QStringList channels;
+    bool hasLink = false;
+    // only supported when searching logs
+    QDate day;
+    QString text;
+
+    /**
+     * @brief Parses the search query typed by the user.
+     *
+     * @param input the search query
+     * @return the parsed query
+     */
+    static SearchQuery parse(const QString &input);
+
+    /**
+     * @brief Creates the MessagePredicates for this query.
+     *
+     * @return a vector of MessagePredicates a message has to satisfy
+     */
+    std::vector<std::unique_ptr<MessagePredicate>> predicates() const;
+
+    /**
+     * @brief Checks whether every message matching this query also matches
+     *        "previous", e.g. because more text has been typed.
+     *
+     * @param previous the previous search query
+     * @return true if only the results of "previous" have to be searched
+     */
+    bool narrows(const SearchQuery &previous) const;
+};
+
+}  // namespace chatterino
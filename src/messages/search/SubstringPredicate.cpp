@@ -3,13 +3,19 @@
 namespace chatterino {
 
 SubstringPredicate::SubstringPredicate(const QString &search)
-    : search_(search)
+    : search_(search.toLower())
 {
 }
 
 bool SubstringPredicate::appliesTo(const Message &message)
 {
-    return message.searchText.contains(this->search_, Qt::CaseInsensitive);
+    if (message.lowercaseSearchText.isEmpty())
+    {
+        // message wasn't released by a MessageBuilder
+        return message.searchText.contains(this->search_, Qt::CaseInsensitive);
+    }
+
+    return message.lowercaseSearchText.contains(this->search_);
 }
 
 }  // namespace chatterino
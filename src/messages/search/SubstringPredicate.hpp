@@ -34,7 +34,8 @@ public:
     bool appliesTo(const Message &message);
 
 private:
-    /// Holds the substring to search for in a message's `messageText`
+    /// Holds the lowercase substring to search for in a message's
+    /// `searchText`
     const QString search_;
 };
 
@@ -3,61 +3,336 @@
 #include "common/Common.hpp"
 #include "common/Env.hpp"
 #include "common/NetworkRequest.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "messages/Image.hpp"
 #include "messages/Link.hpp"
+#include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
+#include "util/DebugCount.hpp"
 
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSet>
 #include <QString>
+#include <QTimer>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
 
 namespace chatterino {
+namespace {
+    constexpr int MAX_RUNNING_REQUESTS = 4;
+    constexpr int MAX_CACHED_LINKS = 2000;
+    // how long results are cached, failed requests are retried sooner
+    constexpr qint64 RESOLVED_TTL = 24 * 60 * 60 * 1000;
+    constexpr qint64 FAILED_TTL = 5 * 60 * 1000;
+    constexpr qint64 ERROR_TTL = 60 * 1000;
+    constexpr int SAVE_DELAY = 10 * 1000;
 
-void LinkResolver::getLinkInfo(
-    const QString url, QObject *caller,
-    std::function<void(QString, Link, ImagePtr)> successCallback)
-{
-    if (!getSettings()->linkInfoTooltip)
+    auto &requestCount = DebugCount::counter("link info requests");
+    auto &cacheHits = DebugCount::counter("link info cache hits");
+    auto &coalescedCount = DebugCount::counter("link info requests coalesced");
+
+    struct CachedLinkInfo {
+        QString tooltip;
+        // the unshortened link, empty if it isn't known
+        QString link;
+        QString thumbnail;
+        qint64 expiresAt = 0;
+        // only resolved links are saved to disk
+        bool resolved = false;
+    };
+
+    struct Waiter {
+        // callbacks of waiters whose caller was deleted are skipped
+        bool hasCaller;
+        QPointer<QObject> caller;
+        std::function<void(QString, Link, ImagePtr)> callback;
+    };
+
+    struct ResolverState {
+        bool loaded = false;
+        bool saveQueued = false;
+        QHash<QString, CachedLinkInfo> cache;
+
+        // waiters of the urls that are queued or being resolved
+        QHash<QString, std::vector<Waiter>> waiters;
+        std::deque<QString> queue;
+        QSet<QString> running;
+    };
+
+    ResolverState &resolverState()
     {
-        successCallback("No link info loaded", Link(Link::Url, url), nullptr);
-        return;
+        static ResolverState state;
+        return state;
+    }
+
+    QString cachePath()
+    {
+        return getPaths()->cacheDirectory() + "/linkinfo.json";
+    }
+
+    void loadCache(ResolverState &state)
+    {
+        state.loaded = true;
+
+        QFile file(cachePath());
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return;
+        }
+
+        auto now = QDateTime::currentMSecsSinceEpoch();
+        auto root = QJsonDocument::fromJson(file.readAll()).object();
+        for (auto it = root.begin(); it != root.end(); ++it)
+        {
+            auto object = it.value().toObject();
+
+            CachedLinkInfo info;
+            info.expiresAt = qint64(object.value("expiresAt").toDouble());
+            if (info.expiresAt <= now)
+            {
+                continue;
+            }
+            info.tooltip = object.value("tooltip").toString();
+            info.link = object.value("link").toString();
+            info.thumbnail = object.value("thumbnail").toString();
+            info.resolved = true;
+
+            state.cache.insert(it.key(), info);
+        }
     }
-    // Uncomment to test crashes
-    // QTimer::singleShot(3000, [=]() {
-    NetworkRequest(Env::get().linkResolverUrl.arg(QString::fromUtf8(
-                       QUrl::toPercentEncoding(url, "", "/:"))))
-        .caller(caller)
-        .timeout(30000)
-        .onSuccess(
-            [successCallback, url](NetworkResult result) mutable -> Outcome {
+
+    void saveCache(ResolverState &state)
+    {
+        state.saveQueued = false;
+
+        QJsonObject root;
+        for (auto it = state.cache.begin(); it != state.cache.end(); ++it)
+        {
+            if (it->resolved)
+            {
+                root.insert(it.key(), QJsonObject{
+                                          {"tooltip", it->tooltip},
+                                          {"link", it->link},
+                                          {"thumbnail", it->thumbnail},
+                                          {"expiresAt", double(it->expiresAt)},
+                                      });
+            }
+        }
+
+        QtConcurrent::run(
+            [path = cachePath(), bytes = QJsonDocument(root).toJson(
+                                     QJsonDocument::Compact)] {
+                QFile file(path);
+                if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+                {
+                    qCWarning(chatterinoApp)
+                        << "Unable to write link info cache to" << path;
+                    return;
+                }
+                file.write(bytes);
+            });
+    }
+
+    void removeExpired(ResolverState &state)
+    {
+        auto now = QDateTime::currentMSecsSinceEpoch();
+        for (auto it = state.cache.begin(); it != state.cache.end();)
+        {
+            if (it->expiresAt <= now)
+            {
+                it = state.cache.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (state.cache.size() <= MAX_CACHED_LINKS)
+        {
+            return;
+        }
+
+        // drop the quarter of the links that expire first
+        std::vector<qint64> expiries;
+        expiries.reserve(state.cache.size());
+        for (const auto &info : state.cache)
+        {
+            expiries.push_back(info.expiresAt);
+        }
+        auto nth = expiries.begin() + expiries.size() / 4;
+        std::nth_element(expiries.begin(), nth, expiries.end());
+
+        for (auto it = state.cache.begin(); it != state.cache.end();)
+        {
+            if (it->expiresAt <= *nth)
+            {
+                it = state.cache.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void deliver(const QString &url, const CachedLinkInfo &info,
+                 const Waiter &waiter)
+    {
+        if (waiter.hasCaller && waiter.caller.isNull())
+        {
+            return;
+        }
+
+        auto linkString = url;
+        if (getSettings()->unshortLinks && !info.link.isEmpty())
+        {
+            linkString = info.link;
+        }
+
+        waiter.callback(
+            info.tooltip, Link(Link::Url, linkString),
+            info.resolved ? Image::fromUrl({info.thumbnail}) : nullptr);
+    }
+
+    void startQueued();
+
+    void finish(const QString &url, CachedLinkInfo info, qint64 ttl)
+    {
+        auto &state = resolverState();
+
+        // a timed out request might still report an error
+        if (!state.running.remove(url))
+        {
+            return;
+        }
+
+        info.expiresAt = QDateTime::currentMSecsSinceEpoch() + ttl;
+        if (state.cache.size() >= MAX_CACHED_LINKS)
+        {
+            removeExpired(state);
+        }
+        state.cache.insert(url, info);
+
+        if (info.resolved && !state.saveQueued)
+        {
+            state.saveQueued = true;
+            QTimer::singleShot(SAVE_DELAY, [] {
+                saveCache(resolverState());
+            });
+        }
+
+        for (const auto &waiter : state.waiters.take(url))
+        {
+            deliver(url, info, waiter);
+        }
+
+        startQueued();
+    }
+
+    void resolve(const QString &url)
+    {
+        resolverState().running.insert(url);
+        requestCount.increase();
+
+        NetworkRequest(Env::get().linkResolverUrl.arg(QString::fromUtf8(
+                           QUrl::toPercentEncoding(url, "", "/:"))))
+            .timeout(30000)
+            .onSuccess([url](NetworkResult result) -> Outcome {
                 auto root = result.parseJson();
                 auto statusCode = root.value("status").toInt();
-                QString response = QString();
-                QString linkString = url;
-                ImagePtr thumbnail = nullptr;
+
+                CachedLinkInfo info;
                 if (statusCode == 200)
                 {
-                    response = root.value("tooltip").toString();
-                    thumbnail =
-                        Image::fromUrl({root.value("thumbnail").toString()});
-                    if (getSettings()->unshortLinks)
-                    {
-                        linkString = root.value("link").toString();
-                    }
+                    info.tooltip = root.value("tooltip").toString();
+                    info.thumbnail = root.value("thumbnail").toString();
+                    info.link = root.value("link").toString();
+                    info.resolved = true;
                 }
                 else
                 {
-                    response = root.value("message").toString();
+                    info.tooltip = root.value("message").toString();
                 }
-                successCallback(QUrl::fromPercentEncoding(response.toUtf8()),
-                                Link(Link::Url, linkString), thumbnail);
+                info.tooltip = QUrl::fromPercentEncoding(info.tooltip.toUtf8());
 
+                finish(url, info, info.resolved ? RESOLVED_TTL : FAILED_TTL);
                 return Success;
             })
-        .onError([successCallback, url](auto /*result*/) {
-            successCallback("No link info found", Link(Link::Url, url),
-                            nullptr);
-        })
-        .execute();
-    // });
+            .onError([url](auto /*result*/) {
+                CachedLinkInfo info;
+                info.tooltip = "No link info found";
+                finish(url, info, ERROR_TTL);
+            })
+            .execute();
+    }
+
+    void startQueued()
+    {
+        auto &state = resolverState();
+
+        while (state.running.size() < MAX_RUNNING_REQUESTS &&
+               !state.queue.empty())
+        {
+            auto url = state.queue.front();
+            state.queue.pop_front();
+            resolve(url);
+        }
+    }
+}  // namespace
+
+void LinkResolver::getLinkInfo(
+    const QString url, QObject *caller,
+    std::function<void(QString, Link, ImagePtr)> successCallback)
+{
+    assertInGuiThread();
+
+    if (!getSettings()->linkInfoTooltip)
+    {
+        successCallback("No link info loaded", Link(Link::Url, url), nullptr);
+        return;
+    }
+
+    auto &state = resolverState();
+    if (!state.loaded)
+    {
+        loadCache(state);
+    }
+
+    Waiter waiter{caller != nullptr, caller, std::move(successCallback)};
+
+    auto cached = state.cache.find(url);
+    if (cached != state.cache.end())
+    {
+        if (cached->expiresAt > QDateTime::currentMSecsSinceEpoch())
+        {
+            cacheHits.increase();
+            deliver(url, *cached, waiter);
+            return;
+        }
+        state.cache.erase(cached);
+    }
+
+    auto waiting = state.waiters.find(url);
+    if (waiting != state.waiters.end())
+    {
+        coalescedCount.increase();
+        waiting->push_back(std::move(waiter));
+        return;
+    }
+
+    state.waiters[url].push_back(std::move(waiter));
+    state.queue.push_back(url);
+    startQueued();
 }
 
 }  // namespace chatterino
@@ -8,6 +8,15 @@
 
 namespace chatterino {
 
+/// Resolves the tooltip, thumbnail and unshortened link of urls.
+///
+/// Results are cached in memory and, if they were resolved successfully, in
+/// the cache directory for a day. Requests for a url that is already being
+/// resolved wait for that request instead of making their own and only a few
+/// requests run at the same time, the rest are queued.
+///
+/// Only call this from the GUI thread, the callback is called on it as well,
+/// right away if the result is cached.
 class LinkResolver
 {
 public:
@@ -6,6 +6,7 @@
 #include "common/Common.hpp"
 #include "common/NetworkRequest.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTrace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
@@ -140,12 +141,15 @@ void BttvEmotes::loadEmotes()
 {
     NetworkRequest(QString(globalEmoteApiUrl))
         .timeout(30000)
+        .concurrent()
+        .snapshot()
         .onSuccess([this](auto result) -> Outcome {
+            StartupTraceScope trace("BttvEmotes::loadEmotes", "network");
+
             auto emotes = this->global_.get();
             auto pair = parseGlobalEmotes(result.parseJsonArray(), *emotes);
             if (pair.first)
-                this->global_.set(
-                    std::make_shared<EmoteMap>(std::move(pair.second)));
+                this->global_.set(makeEmoteMapPtr(std::move(pair.second)));
             return pair.first;
         })
         .execute();
@@ -157,8 +161,16 @@ void BttvEmotes::loadChannel(std::weak_ptr<Channel> channel,
                              std::function<void(EmoteMap &&)> callback,
                              bool manualRefresh)
 {
-    NetworkRequest(QString(bttvChannelEmoteApiUrl) + channelId)
-        .timeout(3000)
+    auto request =
+        NetworkRequest(QString(bttvChannelEmoteApiUrl) + channelId)
+            .timeout(3000);
+    if (!manualRefresh)
+    {
+        // the stored emotes are shown until the new ones arrive
+        request = std::move(request).snapshot();
+    }
+
+    std::move(request)
         .onSuccess([callback = std::move(callback), channel,
                     &channelDisplayName,
                     manualRefresh](auto result) -> Outcome {
@@ -10,7 +10,7 @@
 
 #include <QUrl>
 
-#include <map>
+#include <memory>
 
 namespace chatterino {
 void ChatterinoBadges::initialize(Settings &settings, Paths &paths)
@@ -24,10 +24,13 @@ ChatterinoBadges::ChatterinoBadges()
 
 boost::optional<EmotePtr> ChatterinoBadges::getBadge(const UserId &id)
 {
-    auto it = badgeMap.find(id.string);
-    if (it != badgeMap.end())
+    if (auto badges = this->badges_.get())
     {
-        return emotes[it->second];
+        auto it = badges->userBadges.find(id.string);
+        if (it != badges->userBadges.end())
+        {
+            return badges->emotes[it->second];
+        }
     }
     return boost::none;
 }
@@ -37,7 +40,10 @@ void ChatterinoBadges::loadChatterinoBadges()
     static QUrl url("https://api.chatterino.com/badges");
 
     NetworkRequest(url)
+        .priority(NetworkRequestPriority::Background)
+        .snapshot()
         .onSuccess([this](auto result) -> Outcome {
+            auto badges = std::make_unique<Badges>();
             auto jsonRoot = result.parseJson();
             int index = 0;
             for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
@@ -50,16 +56,17 @@ void ChatterinoBadges::loadChatterinoBadges()
                              Url{jsonBadge.value("image3").toString()}},
                     Tooltip{jsonBadge.value("tooltip").toString()}, Url{}};
 
-                emotes.push_back(
+                badges->emotes.push_back(
                     std::make_shared<const Emote>(std::move(emote)));
 
                 for (const auto &user : jsonBadge.value("users").toArray())
                 {
-                    badgeMap[user.toString()] = index;
+                    badges->userBadges[user.toString()] = index;
                 }
                 ++index;
             }
 
+            this->badges_.publish(std::move(badges));
             return Success;
         })
         .execute();
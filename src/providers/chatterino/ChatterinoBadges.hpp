@@ -4,8 +4,10 @@
 #include <common/Singleton.hpp>
 
 #include "common/Aliases.hpp"
+#include "common/Published.hpp"
+#include "util/QStringHash.hpp"
 
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace chatterino {
@@ -22,9 +24,14 @@ public:
     boost::optional<EmotePtr> getBadge(const UserId &id);
 
 private:
+    struct Badges {
+        // user id -> index in emotes
+        std::unordered_map<QString, int> userBadges;
+        std::vector<EmotePtr> emotes;
+    };
+
     void loadChatterinoBadges();
-    std::map<QString, int> badgeMap;
-    std::vector<EmotePtr> emotes;
+    Published<Badges> badges_;
 };
 
 }  // namespace chatterino
@@ -1,6 +1,8 @@
 #include "providers/emoji/Emojis.hpp"
 
 #include "Application.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "debug/StartupTrace.hpp"
 #include "messages/Emote.hpp"
 #include "singletons/Settings.hpp"
 
@@ -8,6 +10,7 @@
 #include <rapidjson/error/error.h>
 #include <rapidjson/rapidjson.h>
 #include <QFile>
+#include <QtConcurrent>
 #include <boost/variant.hpp>
 #include <memory>
 #include "common/QLogging.hpp"
@@ -107,13 +110,30 @@ namespace {
 
 void Emojis::load()
 {
-    this->loadEmojis();
+    this->loadFuture_ = QtConcurrent::run([this] {
+        StartupTraceScope trace("Emojis::load");
 
-    this->loadEmojiOne2Capabilities();
+        this->loadEmojis();
 
-    this->sortEmojis();
+        this->loadEmojiOne2Capabilities();
+
+        this->sortEmojis();
+    });
+}
+
+void Emojis::waitUntilLoaded()
+{
+    assertInGuiThread();
+
+    if (this->emojiSetLoaded_)
+    {
+        return;
+    }
+
+    this->loadFuture_.waitForFinished();
 
     this->loadEmojiSet();
+    this->emojiSetLoaded_ = true;
 }
 
 void Emojis::loadEmojis()
@@ -2,6 +2,7 @@
 
 #include "util/ConcurrentMap.hpp"
 
+#include <QFuture>
 #include <QMap>
 #include <QRegularExpression>
 #include <boost/variant.hpp>
@@ -39,7 +40,12 @@ class Emojis
 {
 public:
     void initialize();
+    // load starts parsing the emoji data on a worker thread
     void load();
+    // waitUntilLoaded blocks until the emoji data has been parsed, then
+    // applies the emoji set. Must be called from the GUI thread before the
+    // emojis are used.
+    void waitUntilLoaded();
     std::vector<boost::variant<EmotePtr, QString>> parse(const QString &text);
 
     EmojiMap emojis;
@@ -61,6 +67,9 @@ private:
     // Maps the first character of the emoji unicode string to a vector of
     // possible emojis
     QMap<QChar, QVector<std::shared_ptr<EmojiData>>> emojiFirstByte_;
+
+    QFuture<void> loadFuture_;
+    bool emojiSetLoaded_ = false;
 };
 
 }  // namespace chatterino
@@ -10,7 +10,7 @@
 
 #include <QUrl>
 
-#include <map>
+#include <memory>
 
 namespace chatterino {
 
@@ -21,24 +21,25 @@ void FfzBadges::initialize(Settings &settings, Paths &paths)
 
 boost::optional<EmotePtr> FfzBadges::getBadge(const UserId &id)
 {
-    auto it = this->badgeMap.find(id.string);
-    if (it != this->badgeMap.end())
+    if (auto badges = this->badges_.get())
     {
-        return this->badges[it->second];
+        auto it = badges->userBadges.find(id.string);
+        if (it != badges->userBadges.end())
+        {
+            return badges->emotes[it->second];
+        }
     }
     return boost::none;
 }
 boost::optional<QColor> FfzBadges::getBadgeColor(const UserId &id)
 {
-    auto badgeIt = this->badgeMap.find(id.string);
-    if (badgeIt != this->badgeMap.end())
+    if (auto badges = this->badges_.get())
     {
-        auto colorIt = this->colorMap.find(badgeIt->second);
-        if (colorIt != this->colorMap.end())
+        auto it = badges->userBadges.find(id.string);
+        if (it != badges->userBadges.end())
         {
-            return colorIt->second;
+            return badges->colors[it->second];
         }
-        return boost::none;
     }
     return boost::none;
 }
@@ -48,7 +49,10 @@ void FfzBadges::loadFfzBadges()
     static QUrl url("https://api.frankerfacez.com/v1/badges/ids");
 
     NetworkRequest(url)
+        .priority(NetworkRequestPriority::Background)
+        .snapshot()
         .onSuccess([this](auto result) -> Outcome {
+            auto badges = std::make_unique<Badges>();
             auto jsonRoot = result.parseJson();
             int index = 0;
             for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
@@ -65,10 +69,10 @@ void FfzBadges::loadFfzBadges()
                             jsonUrls.value("4").toString()}},
                     Tooltip{jsonBadge.value("title").toString()}, Url{}};
 
-                this->badges.push_back(
+                badges->emotes.push_back(
                     std::make_shared<const Emote>(std::move(emote)));
-                this->colorMap[index] =
-                    QColor(jsonBadge.value("color").toString());
+                badges->colors.push_back(
+                    QColor(jsonBadge.value("color").toString()));
 
                 auto badgeId = QString::number(jsonBadge.value("id").toInt());
                 for (const auto &user : jsonRoot.value("users")
@@ -76,11 +80,12 @@ void FfzBadges::loadFfzBadges()
                                             .value(badgeId)
                                             .toArray())
                 {
-                    this->badgeMap[QString::number(user.toInt())] = index;
+                    badges->userBadges[QString::number(user.toInt())] = index;
                 }
                 ++index;
             }
 
+            this->badges_.publish(std::move(badges));
             return Success;
         })
         .execute();
@@ -4,8 +4,12 @@
 #include <common/Singleton.hpp>
 
 #include "common/Aliases.hpp"
+#include "common/Published.hpp"
+#include "util/QStringHash.hpp"
 
-#include <map>
+#include <QColor>
+
+#include <unordered_map>
 #include <vector>
 
 namespace chatterino {
@@ -23,10 +27,15 @@ public:
     boost::optional<QColor> getBadgeColor(const UserId &id);
 
 private:
+    struct Badges {
+        // user id -> index in emotes and colors
+        std::unordered_map<QString, int> userBadges;
+        std::vector<EmotePtr> emotes;
+        std::vector<QColor> colors;
+    };
+
     void loadFfzBadges();
-    std::map<QString, int> badgeMap;
-    std::vector<EmotePtr> badges;
-    std::map<int, QColor> colorMap;
+    Published<Badges> badges_;
 };
 
 }  // namespace chatterino
@@ -5,6 +5,7 @@
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTrace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -180,12 +181,15 @@ void FfzEmotes::loadEmotes()
     NetworkRequest(url)
 
         .timeout(30000)
+        .concurrent()
+        .snapshot()
         .onSuccess([this](auto result) -> Outcome {
+            StartupTraceScope trace("FfzEmotes::loadEmotes", "network");
+
             auto emotes = this->emotes();
             auto pair = parseGlobalEmotes(result.parseJson(), *emotes);
             if (pair.first)
-                this->global_.set(
-                    std::make_shared<EmoteMap>(std::move(pair.second)));
+                this->global_.set(makeEmoteMapPtr(std::move(pair.second)));
             return pair.first;
         })
         .execute();
@@ -200,9 +204,16 @@ void FfzEmotes::loadChannel(
     qCDebug(chatterinoFfzemotes)
         << "[FFZEmotes] Reload FFZ Channel Emotes for channel" << channelId;
 
-    NetworkRequest("https://api.frankerfacez.com/v1/room/id/" + channelId)
+    auto request =
+        NetworkRequest("https://api.frankerfacez.com/v1/room/id/" + channelId)
+            .timeout(20000);
+    if (!manualRefresh)
+    {
+        // the stored emotes are shown until the new ones arrive
+        request = std::move(request).snapshot();
+    }
 
-        .timeout(20000)
+    std::move(request)
         .onSuccess([emoteCallback = std::move(emoteCallback),
                     modBadgeCallback = std::move(modBadgeCallback), channel,
                     manualRefresh](auto result) -> Outcome {
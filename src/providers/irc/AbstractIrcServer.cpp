@@ -224,12 +224,12 @@ ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName)
 
             if (this->readConnection_)
             {
-                this->readConnection_->sendRaw("PART #" + channelName);
+                this->sendPart(this->readConnection_.get(), channelName);
             }
 
             if (this->writeConnection_ && this->hasSeparateWriteConnection())
             {
-                this->writeConnection_->sendRaw("PART #" + channelName);
+                this->sendPart(this->writeConnection_.get(), channelName);
             }
         }));
 
@@ -241,7 +241,7 @@ ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName)
         {
             if (this->readConnection_->isConnected())
             {
-                this->readConnection_->sendRaw("JOIN #" + channelName);
+                this->sendJoin(this->readConnection_.get(), channelName);
             }
         }
 
@@ -249,7 +249,7 @@ ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName)
         {
             if (this->readConnection_->isConnected())
             {
-                this->writeConnection_->sendRaw("JOIN #" + channelName);
+                this->sendJoin(this->writeConnection_.get(), channelName);
             }
         }
     }
@@ -298,6 +298,18 @@ std::vector<std::weak_ptr<Channel>> AbstractIrcServer::getChannels()
     return channels;
 }
 
+void AbstractIrcServer::sendJoin(IrcConnection *connection,
+                                 const QString &channelName)
+{
+    connection->sendRaw("JOIN #" + channelName);
+}
+
+void AbstractIrcServer::sendPart(IrcConnection *connection,
+                                 const QString &channelName)
+{
+    connection->sendRaw("PART #" + channelName);
+}
+
 void AbstractIrcServer::onReadConnected(IrcConnection *connection)
 {
     (void)connection;
@@ -309,7 +321,7 @@ void AbstractIrcServer::onReadConnected(IrcConnection *connection)
     {
         if (auto channel = weak.lock())
         {
-            connection->sendRaw("JOIN #" + channel->getName());
+            this->sendJoin(connection, channel->getName());
         }
     }
 
@@ -67,6 +67,13 @@ protected:
     virtual void readConnectionMessageReceived(Communi::IrcMessage *message);
     virtual void writeConnectionMessageReceived(Communi::IrcMessage *message);
 
+    // sendJoin sends a JOIN for the channel on the given connection
+    virtual void sendJoin(IrcConnection *connection,
+                          const QString &channelName);
+    // sendPart sends a PART for the channel on the given connection
+    virtual void sendPart(IrcConnection *connection,
+                          const QString &channelName);
+
     virtual void onReadConnected(IrcConnection *connection);
     virtual void onWriteConnected(IrcConnection *connection);
     virtual void onDisconnected();
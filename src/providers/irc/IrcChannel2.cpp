@@ -14,7 +14,7 @@ IrcChannel::IrcChannel(const QString &name, IrcServer *server)
 {
 }
 
-void IrcChannel::sendMessage(const QString &message)
+void IrcChannel::sendMessage(const QString &message, SendPriority)
 {
     assertInGuiThread();
 
@@ -13,7 +13,8 @@ class IrcChannel : public Channel, public ChannelChatters
 public:
     explicit IrcChannel(const QString &name, IrcServer *server);
 
-    void sendMessage(const QString &message) override;
+    void sendMessage(const QString &message,
+                     SendPriority priority = SendPriority::Automated) override;
 
     // server may be nullptr
     IrcServer *server();
@@ -0,0 +1,172 @@
+#include "providers/twitch/ColdHistory.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/Message.hpp"
+#include "providers/twitch/IrcMessageHandler.hpp"
+#include "util/DebugCount.hpp"
+#include "util/IrcHelpers.hpp"
+
+#include <QDateTime>
+#include <QtEndian>
+#include <IrcMessage>
+
+namespace chatterino {
+namespace {
+    // lines per block, roughly 100 KiB before compression
+    constexpr int BLOCK_SIZE = 256;
+    // speed matters more than size, blocks are compressed on the GUI thread
+    constexpr int COMPRESSION_LEVEL = 1;
+    constexpr int RECORD_HEADER_SIZE = 8 + 4;
+
+    auto &coldHistoryBytes =
+        DebugCount::counter("cold history bytes", DebugCount::Unit::Bytes);
+}  // namespace
+
+ColdHistory::ColdHistory(int limit)
+    : limit_(limit)
+{
+}
+
+ColdHistory::~ColdHistory()
+{
+    for (const auto &block : this->blocks_)
+    {
+        coldHistoryBytes.decrease(block->data.size());
+    }
+    coldHistoryBytes.decrease(this->open_.data.size());
+}
+
+void ColdHistory::append(qint64 timestamp, const QByteArray &line)
+{
+    assertInGuiThread();
+
+    uchar header[RECORD_HEADER_SIZE];
+    qToLittleEndian<qint64>(timestamp, header);
+    qToLittleEndian<quint32>(quint32(line.size()), header + 8);
+
+    this->open_.data.append(reinterpret_cast<const char *>(header),
+                            RECORD_HEADER_SIZE);
+    this->open_.data.append(line);
+    this->open_.lineCount++;
+    this->lineCount_++;
+    coldHistoryBytes.increase(RECORD_HEADER_SIZE + line.size());
+
+    if (this->open_.lineCount >= BLOCK_SIZE)
+    {
+        this->compressOpenBlock();
+    }
+
+    while (!this->blocks_.empty() &&
+           this->lineCount_ - this->blocks_.front()->lineCount >= this->limit_)
+    {
+        this->lineCount_ -= this->blocks_.front()->lineCount;
+        coldHistoryBytes.decrease(this->blocks_.front()->data.size());
+        this->blocks_.pop_front();
+    }
+}
+
+void ColdHistory::compressOpenBlock()
+{
+    auto block = std::make_shared<Block>();
+    block->data = qCompress(this->open_.data, COMPRESSION_LEVEL);
+    block->lineCount = this->open_.lineCount;
+    block->compressed = true;
+
+    coldHistoryBytes.increase(block->data.size() - this->open_.data.size());
+    this->blocks_.push_back(std::move(block));
+    this->open_ = Block();
+}
+
+void ColdHistory::clear()
+{
+    assertInGuiThread();
+
+    for (const auto &block : this->blocks_)
+    {
+        coldHistoryBytes.decrease(block->data.size());
+    }
+    coldHistoryBytes.decrease(this->open_.data.size());
+
+    this->blocks_.clear();
+    this->open_ = Block();
+    this->lineCount_ = 0;
+}
+
+ColdHistory::Snapshot ColdHistory::snapshot() const
+{
+    assertInGuiThread();
+
+    Snapshot snapshot(this->blocks_.begin(), this->blocks_.end());
+    if (this->open_.lineCount > 0)
+    {
+        snapshot.push_back(std::make_shared<Block>(this->open_));
+    }
+    return snapshot;
+}
+
+ColdHistory::Lines ColdHistory::lines(const Snapshot &snapshot,
+                                      const QSet<QString> &skipIds)
+{
+    Lines lines;
+
+    for (const auto &block : snapshot)
+    {
+        auto data = block->compressed ? qUncompress(block->data) : block->data;
+        const auto *begin = reinterpret_cast<const uchar *>(data.constData());
+
+        int offset = 0;
+        while (offset + RECORD_HEADER_SIZE <= data.size())
+        {
+            auto timestamp = qFromLittleEndian<qint64>(begin + offset);
+            auto size = int(qFromLittleEndian<quint32>(begin + offset + 8));
+            offset += RECORD_HEADER_SIZE;
+            if (offset + size > data.size())
+            {
+                break;
+            }
+
+            auto line = data.mid(offset, size);
+            offset += size;
+
+            // building is the expensive part, skip what would be left out
+            auto id = rawTagValue(line, "id");
+            if (!id.isEmpty() && !skipIds.contains(QString::fromLatin1(id)))
+            {
+                lines.push_back({timestamp, std::move(line)});
+            }
+        }
+    }
+
+    return lines;
+}
+
+std::vector<MessagePtr> ColdHistory::build(Channel *channel,
+                                           const Lines &lines, size_t begin,
+                                           size_t end)
+{
+    assertInGuiThread();
+
+    auto &handler = IrcMessageHandler::instance();
+    std::vector<MessagePtr> messages;
+
+    for (auto i = begin; i < end && i < lines.size(); i++)
+    {
+        const auto &stored = lines[i];
+        auto *message = Communi::IrcMessage::fromData(
+            historicalLine(stored.line, stored.timestamp), nullptr);
+
+        for (auto &built : handler.parseMessage(channel, message))
+        {
+            if (!built->id.isEmpty())
+            {
+                messages.push_back(std::move(built));
+            }
+        }
+
+        delete message;
+    }
+
+    return messages;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "providers/twitch/MessageStore.hpp"
+
+#include <QByteArray>
+#include <QSet>
+#include <QString>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class Channel;
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+// ColdHistory keeps the raw irc lines of a twitch channel, reaching much
+// further back than the fully built messages the channel keeps.
+// The lines are collected in blocks which are compressed once they're full,
+// only the newest block stays uncompressed. The oldest blocks are dropped
+// once there are more lines than the limit.
+// The lines are only built into messages again when a search needs them,
+// scrolling up in a split doesn't bring them back. Only kept while the
+// keepColdHistory setting is on.
+class ColdHistory
+{
+public:
+    struct Block {
+        // records of: i64 time received, u32 line length, line
+        QByteArray data;
+        int lineCount = 0;
+        bool compressed = false;
+    };
+
+    // A copy of the blocks, which can be used from any thread
+    using Snapshot = std::vector<std::shared_ptr<const Block>>;
+
+    explicit ColdHistory(int limit);
+    ~ColdHistory();
+
+    // append keeps a line that was just received
+    // Must be called from the GUI thread
+    void append(qint64 timestamp, const QByteArray &line);
+
+    // Must be called from the GUI thread
+    Snapshot snapshot() const;
+
+    // Must be called from the GUI thread
+    void clear();
+
+    using Lines = std::vector<MessageStore::StoredMessage>;
+
+    // lines returns the lines of the snapshot, oldest first. Lines whose id
+    // is in skipIds, usually because the channel still has them, and lines
+    // without an id are left out.
+    // Can be called from any thread
+    static Lines lines(const Snapshot &snapshot, const QSet<QString> &skipIds);
+
+    // build builds lines[begin, end) for the channel, oldest first.
+    // Must be called from the GUI thread, like any message builder
+    static std::vector<MessagePtr> build(Channel *channel, const Lines &lines,
+                                         size_t begin, size_t end);
+
+private:
+    void compressOpenBlock();
+
+    const int limit_;
+    int lineCount_ = 0;
+
+    std::deque<std::shared_ptr<const Block>> blocks_;
+    Block open_;
+};
+
+}  // namespace chatterino
@@ -16,6 +16,7 @@
 #include "util/IrcHelpers.hpp"
 
 #include <IrcMessage>
+#include <QDateTime>
 
 #include <unordered_set>
 
@@ -136,6 +137,9 @@ void IrcMessageHandler::setSimilarityFlags(MessagePtr msg, ChannelPtr chan)
             return;
         }
 
+        // messages that are still queued have to be compared against too
+        chan->flushQueuedMessages();
+
         if (IrcMessageHandler::similarity(msg, chan->getMessageSnapshot()) >
             getSettings()->similarityPercentage)
         {
@@ -225,6 +229,8 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *_message,
                                    TwitchIrcServer &server, bool isSub,
                                    bool isAction)
 {
+    auto receivedAt = QDateTime::currentMSecsSinceEpoch();
+
     QString channelName;
     if (!trimChannelName(target, channelName))
     {
@@ -284,7 +290,11 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *_message,
             builder->flags.set(MessageFlag::Subscription);
             builder->flags.unset(MessageFlag::Highlighted);
         }
+        builder->latency.start(chan->getName(), chan.get(),
+                               tags.value("tmi-sent-ts").toLongLong(),
+                               receivedAt);
         auto msg = builder.build();
+        msg->latency.record(MessageLatency::Stage::Built);
 
         IrcMessageHandler::setSimilarityFlags(msg, chan);
 
@@ -306,7 +316,7 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *_message,
             }
         }
 
-        chan->addMessage(msg);
+        chan->queueMessage(msg);
         if (auto chatters = dynamic_cast<ChannelChatters *>(chan.get()))
         {
             chatters->addRecentChatter(msg->displayName);
@@ -0,0 +1,262 @@
+#include "providers/twitch/MessageStore.hpp"
+
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "singletons/Paths.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace chatterino {
+namespace {
+    // segments of older days are deleted
+    constexpr int RETENTION_DAYS = 3;
+    constexpr int FLUSH_INTERVAL = 1000;
+
+    const QByteArray DATA_MAGIC("CHMSDAT1");
+    const QByteArray INDEX_MAGIC("CHMSIDX1");
+    constexpr int MAGIC_SIZE = 8;
+
+    // record: u32 size of the rest, i64 timestamp, u16 channel length,
+    // channel, line
+    constexpr int RECORD_HEADER_SIZE = 4 + 8 + 2;
+    // index entry: u32 channel hash, u32 record offset, i64 timestamp
+    constexpr int INDEX_ENTRY_SIZE = 4 + 4 + 8;
+
+    // FNV-1a, stable across runs unlike qHash
+    quint32 channelHash(const QByteArray &channel)
+    {
+        quint32 hash = 2166136261u;
+        for (auto c : channel)
+        {
+            hash ^= quint8(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    QString segmentName(const QDate &day)
+    {
+        return day.toString(Qt::ISODate);
+    }
+
+    // Appends the matching records of one segment, newest first
+    void readSegment(const QString &directory, const QDate &day,
+                     const QByteArray &channel, qint64 before, int maxCount,
+                     std::vector<MessageStore::StoredMessage> &out)
+    {
+        auto name = directory + "/" + segmentName(day);
+
+        QFile indexFile(name + ".idx");
+        QFile dataFile(name + ".dat");
+        if (!indexFile.open(QIODevice::ReadOnly) ||
+            !dataFile.open(QIODevice::ReadOnly) ||
+            indexFile.size() < MAGIC_SIZE || dataFile.size() < MAGIC_SIZE)
+        {
+            return;
+        }
+
+        auto indexSize = indexFile.size();
+        auto dataSize = dataFile.size();
+        auto *index = indexFile.map(0, indexSize);
+        auto *data = dataFile.map(0, dataSize);
+        if (!index || !data ||
+            std::memcmp(index, INDEX_MAGIC.constData(), MAGIC_SIZE) != 0 ||
+            std::memcmp(data, DATA_MAGIC.constData(), MAGIC_SIZE) != 0)
+        {
+            return;
+        }
+
+        auto hash = channelHash(channel);
+        auto entries = (indexSize - MAGIC_SIZE) / INDEX_ENTRY_SIZE;
+
+        for (auto i = entries - 1; i >= 0 && int(out.size()) < maxCount; i--)
+        {
+            const uchar *entry = index + MAGIC_SIZE + i * INDEX_ENTRY_SIZE;
+            auto timestamp = qFromLittleEndian<qint64>(entry + 8);
+            if (qFromLittleEndian<quint32>(entry) != hash ||
+                timestamp >= before)
+            {
+                continue;
+            }
+
+            // the entry might point past the end if we crashed while writing
+            qint64 offset = qFromLittleEndian<quint32>(entry + 4);
+            if (offset + RECORD_HEADER_SIZE > dataSize)
+            {
+                continue;
+            }
+
+            const uchar *record = data + offset;
+            qint64 size = qFromLittleEndian<quint32>(record);
+            auto channelSize = qFromLittleEndian<quint16>(record + 12);
+            if (offset + 4 + size > dataSize ||
+                RECORD_HEADER_SIZE - 4 + channelSize > size ||
+                QByteArray::fromRawData(
+                    reinterpret_cast<const char *>(record) + RECORD_HEADER_SIZE,
+                    channelSize) != channel)
+            {
+                continue;
+            }
+
+            auto lineOffset = RECORD_HEADER_SIZE + channelSize;
+            out.push_back(
+                {timestamp,
+                 QByteArray(reinterpret_cast<const char *>(record) + lineOffset,
+                            int(size + 4 - lineOffset))});
+        }
+    }
+}  // namespace
+
+MessageStore::MessageStore(const QString &directory)
+    : directory_(directory)
+{
+    this->flushTimer_.setSingleShot(true);
+    this->flushTimer_.setInterval(FLUSH_INTERVAL);
+    QObject::connect(&this->flushTimer_, &QTimer::timeout, [this] {
+        this->flush();
+    });
+}
+
+MessageStore &MessageStore::instance()
+{
+    static MessageStore instance(getPaths()->cacheDirectory() + "/history");
+    return instance;
+}
+
+void MessageStore::append(const QString &channelName, const QByteArray &line,
+                          const QDateTime &time)
+{
+    assertInGuiThread();
+
+    if (time.date() != this->day_ && !this->openSegment(time.date()))
+    {
+        return;
+    }
+
+    // index entries can only address the first 4 GiB
+    if (this->dataSize_ > std::numeric_limits<quint32>::max())
+    {
+        return;
+    }
+
+    auto channel = channelName.toUtf8();
+    auto timestamp = time.toMSecsSinceEpoch();
+
+    uchar header[RECORD_HEADER_SIZE];
+    qToLittleEndian<quint32>(
+        quint32(RECORD_HEADER_SIZE - 4 + channel.size() + line.size()), header);
+    qToLittleEndian<qint64>(timestamp, header + 4);
+    qToLittleEndian<quint16>(quint16(channel.size()), header + 12);
+
+    uchar entry[INDEX_ENTRY_SIZE];
+    qToLittleEndian<quint32>(channelHash(channel), entry);
+    qToLittleEndian<quint32>(quint32(this->dataSize_), entry + 4);
+    qToLittleEndian<qint64>(timestamp, entry + 8);
+
+    this->data_.write(reinterpret_cast<const char *>(header),
+                      RECORD_HEADER_SIZE);
+    this->data_.write(channel);
+    this->data_.write(line);
+    this->dataSize_ += RECORD_HEADER_SIZE + channel.size() + line.size();
+
+    // the index is written after the record it points to
+    this->index_.write(reinterpret_cast<const char *>(entry),
+                       INDEX_ENTRY_SIZE);
+
+    if (!this->flushTimer_.isActive())
+    {
+        this->flushTimer_.start();
+    }
+}
+
+std::vector<MessageStore::StoredMessage> MessageStore::readRecent(
+    const QString &channelName, int maxCount, qint64 before) const
+{
+    std::vector<StoredMessage> messages;
+    auto channel = channelName.toUtf8();
+
+    auto day = QDateTime::fromMSecsSinceEpoch(before).date();
+    for (int i = 0; i <= RETENTION_DAYS && int(messages.size()) < maxCount;
+         i++)
+    {
+        readSegment(this->directory_, day.addDays(-i), channel, before,
+                    maxCount, messages);
+    }
+
+    std::reverse(messages.begin(), messages.end());
+    return messages;
+}
+
+bool MessageStore::openSegment(const QDate &day)
+{
+    this->flush();
+    this->data_.close();
+    this->index_.close();
+    this->day_ = day;
+
+    if (!QDir().mkpath(this->directory_))
+    {
+        qCWarning(chatterinoTwitch) << "Unable to create message store path";
+        return false;
+    }
+    this->removeOldSegments();
+
+    auto name = this->directory_ + "/" + segmentName(day);
+    this->data_.setFileName(name + ".dat");
+    this->index_.setFileName(name + ".idx");
+
+    if (!this->data_.open(QIODevice::Append) ||
+        !this->index_.open(QIODevice::Append))
+    {
+        qCWarning(chatterinoTwitch) << "Unable to open message store" << name;
+        this->data_.close();
+        this->index_.close();
+        return false;
+    }
+
+    this->dataSize_ = this->data_.size();
+    if (this->dataSize_ == 0)
+    {
+        this->data_.write(DATA_MAGIC);
+        this->dataSize_ = MAGIC_SIZE;
+    }
+    if (this->index_.size() == 0)
+    {
+        this->index_.write(INDEX_MAGIC);
+    }
+
+    return true;
+}
+
+void MessageStore::removeOldSegments()
+{
+    auto oldest = this->day_.addDays(-RETENTION_DAYS);
+
+    QDir directory(this->directory_);
+    for (const auto &file : directory.entryInfoList(
+             {"*.dat", "*.idx"}, QDir::Files | QDir::NoDotAndDotDot))
+    {
+        auto day = QDate::fromString(file.completeBaseName(), Qt::ISODate);
+        if (day.isValid() && day < oldest)
+        {
+            QFile::remove(file.absoluteFilePath());
+        }
+    }
+}
+
+void MessageStore::flush()
+{
+    if (this->data_.isOpen())
+    {
+        this->data_.flush();
+        this->index_.flush();
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDate>
+#include <QDateTime>
+#include <QFile>
+#include <QString>
+#include <QTimer>
+
+#include <vector>
+
+namespace chatterino {
+
+// MessageStore keeps the raw irc lines of the joined twitch channels on disk,
+// so the history of a channel can be restored after a restart without the
+// recent-messages API.
+// Every day gets its own segment: a data file with the records of all
+// channels and an index file with one fixed size entry per record, which
+// allows finding the newest records of one channel without reading the
+// others. Both files are only ever appended to and are read through memory
+// maps. Segments older than a few days are deleted.
+class MessageStore
+{
+public:
+    struct StoredMessage {
+        // when the message was received, in ms since epoch
+        qint64 timestamp;
+        QByteArray line;
+    };
+
+    // The segments are kept in the given directory, the application uses
+    // the one of instance()
+    explicit MessageStore(const QString &directory);
+
+    static MessageStore &instance();
+
+    // append stores a line received in the given channel at the given time
+    // Must be called from the GUI thread
+    void append(const QString &channelName, const QByteArray &line,
+                const QDateTime &time = QDateTime::currentDateTime());
+
+    // readRecent returns up to maxCount of the newest lines of the channel
+    // received before the given time, oldest first
+    // Can be called from any thread
+    std::vector<StoredMessage> readRecent(const QString &channelName,
+                                          int maxCount, qint64 before) const;
+
+    // flush writes the buffered lines to disk, which append does by itself
+    // after a second
+    void flush();
+
+private:
+    bool openSegment(const QDate &day);
+    void removeOldSegments();
+
+    QString directory_;
+
+    QDate day_;
+    QFile data_;
+    qint64 dataSize_ = 0;
+    QFile index_;
+    QTimer flushTimer_;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,379 @@
+#include "providers/twitch/RecentMessagesLoader.hpp"
+
+#include "common/Channel.hpp"
+#include "common/Env.hpp"
+#include "common/NetworkRequest.hpp"
+#include "common/Outcome.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/Message.hpp"
+#include "providers/twitch/IrcMessageHandler.hpp"
+#include "singletons/Settings.hpp"
+#include "util/FormatTime.hpp"
+#include "util/IrcHelpers.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QDateTime>
+#include <QTimer>
+#include <QtConcurrent>
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
+#include <IrcMessage>
+
+namespace chatterino {
+namespace {
+    // amount of channels whose history is downloaded and built at once
+    constexpr int MAX_CONCURRENT_LOADS = 4;
+    // amount of messages that are handed to the channel at once
+    constexpr int CHUNK_SIZE = 50;
+    constexpr int LOAD_TIMEOUT = 20000;
+
+    // convertClearchatToNotice takes a Communi::IrcMessage that is a CLEARCHAT command and converts it to a readable NOTICE message
+    // This has historically been done in the Recent Messages API, but this functionality is being moved to Chatterino instead
+    Communi::IrcMessage *convertClearchatToNotice(Communi::IrcMessage *message)
+    {
+        auto channelName = message->parameter(0);
+        QString noticeMessage{};
+        if (message->tags().contains("target-user-id"))
+        {
+            auto target = message->parameter(1);
+
+            if (message->tags().contains("ban-duration"))
+            {
+                // User was timed out
+                noticeMessage =
+                    QString("%1 has been timed out for %2.")
+                        .arg(target)
+                        .arg(formatTime(
+                            message->tag("ban-duration").toString()));
+            }
+            else
+            {
+                // User was permanently banned
+                noticeMessage =
+                    QString("%1 has been permanently banned.").arg(target);
+            }
+        }
+        else
+        {
+            // Chat was cleared
+            noticeMessage = "Chat has been cleared by a moderator.";
+        }
+
+        // rebuild the raw irc message so we can convert it back to an ircmessage again!
+        // this could probably be done in a smarter way
+
+        auto s = QString(":tmi.twitch.tv NOTICE %1 :%2")
+                     .arg(channelName)
+                     .arg(noticeMessage);
+
+        auto newMessage = Communi::IrcMessage::fromData(s.toUtf8(), nullptr);
+        newMessage->setTags(message->tags());
+
+        return newMessage;
+    }
+
+    // Returns the rm-received-ts tag of a line from the API, 0 if missing
+    qint64 receivedAt(const QByteArray &line)
+    {
+        static const QByteArray tag("rm-received-ts=");
+
+        auto tagsEnd = line.indexOf(' ');
+        auto index = line.indexOf(tag);
+        if (!line.startsWith('@') || index == -1 || index > tagsEnd)
+        {
+            return 0;
+        }
+
+        auto start = index + tag.size();
+        auto end = start;
+        while (end < line.size() && line[end] >= '0' && line[end] <= '9')
+        {
+            end++;
+        }
+        return line.mid(start, end - start).toLongLong();
+    }
+
+    // Collects the strings of the top level "messages" array without
+    // building a document of the whole response
+    struct RecentMessagesHandler
+        : rapidjson::BaseReaderHandler<rapidjson::UTF8<>,
+                                       RecentMessagesHandler> {
+        std::vector<QByteArray> lines;
+
+        bool Default()
+        {
+            this->nextIsMessages_ = false;
+            return true;
+        }
+
+        bool String(const char *str, rapidjson::SizeType length, bool)
+        {
+            if (this->inMessages_ && this->depth_ == 2)
+            {
+                this->lines.emplace_back(str, int(length));
+            }
+            this->nextIsMessages_ = false;
+            return true;
+        }
+
+        bool Key(const char *str, rapidjson::SizeType length, bool)
+        {
+            this->nextIsMessages_ =
+                this->depth_ == 1 &&
+                QLatin1String(str, int(length)) == QLatin1String("messages");
+            return true;
+        }
+
+        bool StartObject()
+        {
+            this->depth_++;
+            this->nextIsMessages_ = false;
+            return true;
+        }
+
+        bool EndObject(rapidjson::SizeType)
+        {
+            this->depth_--;
+            return true;
+        }
+
+        bool StartArray()
+        {
+            this->depth_++;
+            this->inMessages_ = this->nextIsMessages_ && this->depth_ == 2;
+            this->nextIsMessages_ = false;
+            return true;
+        }
+
+        bool EndArray(rapidjson::SizeType)
+        {
+            if (this->depth_ == 2)
+            {
+                this->inMessages_ = false;
+            }
+            this->depth_--;
+            return true;
+        }
+
+    private:
+        int depth_ = 0;
+        bool nextIsMessages_ = false;
+        bool inMessages_ = false;
+    };
+}  // namespace
+
+RecentMessagesLoader &RecentMessagesLoader::instance()
+{
+    static RecentMessagesLoader instance;
+    return instance;
+}
+
+void RecentMessagesLoader::load(std::weak_ptr<Channel> channel)
+{
+    assertInGuiThread();
+
+    this->pending_.push_back(std::move(channel));
+    this->startNext();
+}
+
+void RecentMessagesLoader::startNext()
+{
+    while (this->running_ < MAX_CONCURRENT_LOADS && !this->pending_.empty())
+    {
+        auto weak = std::move(this->pending_.front());
+        this->pending_.pop_front();
+
+        // channel was closed while it was waiting
+        if (weak.expired())
+        {
+            continue;
+        }
+
+        this->running_++;
+        this->loadNow(std::move(weak));
+    }
+}
+
+void RecentMessagesLoader::finishLoad()
+{
+    assertInGuiThread();
+
+    this->running_--;
+    this->startNext();
+}
+
+void RecentMessagesLoader::loadNow(std::weak_ptr<Channel> weak)
+{
+    auto shared = weak.lock();
+    if (!shared)
+    {
+        this->finishLoad();
+        return;
+    }
+
+    if (!getSettings()->storeMessageHistory)
+    {
+        this->requestMessages(std::move(weak), {});
+        return;
+    }
+
+    // messages received from now on are added to the channel as they come in
+    auto before = QDateTime::currentMSecsSinceEpoch();
+    auto &store = MessageStore::instance();
+    auto channelName = shared->getName();
+    int limit = getSettings()->twitchMessageHistoryLimit;
+
+    QtConcurrent::run([this, weak, &store, channelName, limit, before] {
+        auto stored = store.readRecent(channelName, limit, before);
+
+        postToThread([this, weak, stored = std::move(stored)]() mutable {
+            this->requestMessages(weak, std::move(stored));
+        });
+    });
+}
+
+void RecentMessagesLoader::requestMessages(
+    std::weak_ptr<Channel> weak,
+    std::vector<MessageStore::StoredMessage> stored)
+{
+    auto shared = weak.lock();
+    if (!shared)
+    {
+        this->finishLoad();
+        return;
+    }
+
+    int limit = getSettings()->twitchMessageHistoryLimit;
+    auto baseURL = Env::get().recentMessagesApiUrl.arg(shared->getName());
+    auto url = QString("%1?limit=%2").arg(baseURL).arg(limit);
+
+    // only the messages since the newest stored one are missing
+    qint64 after = stored.empty() ? 0 : stored.back().timestamp;
+    if (after != 0)
+    {
+        url += QString("&after=%1").arg(after);
+    }
+
+    auto storedLines = std::make_shared<std::vector<QByteArray>>();
+    storedLines->reserve(stored.size());
+    for (const auto &message : stored)
+    {
+        storedLines->push_back(historicalLine(message.line, message.timestamp));
+    }
+
+    NetworkRequest(url)
+        .timeout(LOAD_TIMEOUT)
+        .concurrent()
+        .onSuccess([this, weak, storedLines, after, limit](auto result)
+                       -> Outcome {
+            // runs on a worker thread
+            auto lines = *storedLines;
+            for (auto &line : parseRecentMessageLines(result.getData()))
+            {
+                // skip what we have in case "after" was ignored, lines
+                // without a timestamp can't be told apart and are kept
+                auto lineReceivedAt = receivedAt(line);
+                if (after == 0 || lineReceivedAt == 0 ||
+                    lineReceivedAt > after)
+                {
+                    lines.push_back(std::move(line));
+                }
+            }
+
+            if (int(lines.size()) > limit)
+            {
+                lines.erase(lines.begin(), lines.end() - limit);
+            }
+
+            auto kept =
+                std::make_shared<const std::vector<QByteArray>>(
+                    std::move(lines));
+            postToThread([this, weak, kept] {
+                this->buildMessages(weak, kept, int(kept->size()));
+            });
+
+            return Success;
+        })
+        .onError([this, weak, storedLines](auto) {
+            // the stored history is all we have when the API is unreachable
+            postToThread([this, weak, storedLines] {
+                this->buildMessages(weak, storedLines,
+                                    int(storedLines->size()));
+            });
+        })
+        .execute();
+}
+
+std::vector<QByteArray> RecentMessagesLoader::parseRecentMessageLines(
+    const QByteArray &data)
+{
+    RecentMessagesHandler handler;
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(data.constData());
+
+    auto result = reader.Parse(stream, handler);
+    if (result.IsError())
+    {
+        // keep the lines we got up to the error
+        qCWarning(chatterinoTwitch)
+            << "Error parsing recent messages:"
+            << rapidjson::GetParseError_En(result.Code()) << "("
+            << result.Offset() << ")";
+    }
+
+    return std::move(handler.lines);
+}
+
+void RecentMessagesLoader::buildMessages(
+    std::weak_ptr<Channel> weak,
+    std::shared_ptr<const std::vector<QByteArray>> lines, int end)
+{
+    assertInGuiThread();
+
+    auto shared = weak.lock();
+    if (!shared || end <= 0)
+    {
+        this->finishLoad();
+        return;
+    }
+
+    auto &handler = IrcMessageHandler::instance();
+
+    // Build the history from the newest to the oldest chunk. Every chunk is
+    // added to the start of the channel, which keeps the order intact.
+    int begin = std::max(0, end - CHUNK_SIZE);
+
+    std::vector<MessagePtr> builtMessages;
+    builtMessages.reserve(end - begin);
+
+    for (int i = begin; i < end; i++)
+    {
+        auto message = Communi::IrcMessage::fromData((*lines)[i], nullptr);
+
+        if (message->command() == "CLEARCHAT")
+        {
+            auto notice = convertClearchatToNotice(message);
+            delete message;
+            message = notice;
+        }
+
+        for (auto builtMessage : handler.parseMessage(shared.get(), message))
+        {
+            builtMessage->flags.set(MessageFlag::RecentMessage);
+            builtMessages.emplace_back(std::move(builtMessage));
+        }
+
+        delete message;
+    }
+
+    shared->addMessagesAtStart(builtMessages);
+
+    // let the GUI thread handle its events before the next chunk
+    QTimer::singleShot(0, [this, weak = std::move(weak),
+                           lines = std::move(lines), begin] {
+        this->buildMessages(weak, lines, begin);
+    });
+}
+
+}  // namespace chatterino
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "providers/twitch/MessageStore.hpp"
+
+#include <QByteArray>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class Channel;
+
+// RecentMessagesLoader loads the message history of twitch channels from the
+// recent-messages API.
+// The response is parsed with a SAX reader on a worker thread. The messages
+// are built on the GUI thread, since the builders read settings, emotes and
+// ignores which are only safe to read there. One chunk is built per event
+// loop iteration and handed to the channel, newest chunk first, so the
+// visible part of a split fills up before the rest of the history has been
+// built and the GUI keeps responding in between.
+// Only a limited amount of channels is loaded at the same time, the others
+// wait in a queue until a slot frees up.
+// If the history is stored locally, it is restored from the MessageStore and
+// the API is only asked for the messages since the newest stored one.
+class RecentMessagesLoader
+{
+    RecentMessagesLoader() = default;
+
+public:
+    static RecentMessagesLoader &instance();
+
+    // load queues loading the message history for the given channel
+    // Must be called from the GUI thread
+    void load(std::weak_ptr<Channel> channel);
+
+    // parseRecentMessageLines returns the raw irc lines contained in the
+    // "messages" array of a recent-messages API response
+    static std::vector<QByteArray> parseRecentMessageLines(
+        const QByteArray &data);
+
+private:
+    void startNext();
+    void loadNow(std::weak_ptr<Channel> weak);
+    void requestMessages(std::weak_ptr<Channel> weak,
+                         std::vector<MessageStore::StoredMessage> stored);
+    void finishLoad();
+
+    // Builds the chunk of lines before end, then queues the next one.
+    // Must be called from the GUI thread
+    void buildMessages(std::weak_ptr<Channel> weak,
+                       std::shared_ptr<const std::vector<QByteArray>> lines,
+                       int end);
+
+    std::deque<std::weak_ptr<Channel>> pending_;
+    int running_ = 0;
+};
+
+}  // namespace chatterino
@@ -318,6 +318,7 @@ void TwitchAccount::loadEmotes()
     NetworkRequest(url)
 
         .authorizeTwitchV5(this->getOAuthClient(), this->getOAuthToken())
+        .snapshot()
         .onError([=](NetworkResult result) {
             qCWarning(chatterinoTwitch)
                 << "[TwitchAccount::loadEmotes] Error" << result.status();
@@ -7,20 +7,52 @@
 
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
+#include "debug/StartupTrace.hpp"
 #include "messages/Emote.hpp"
+#include "util/StringPool.hpp"
 
 namespace chatterino {
 
+//
+// TwitchBadgeTable
+//
+void TwitchBadgeTable::insert(const QString &set, const QString &version,
+                              EmotePtr emote)
+{
+    // messages intern their badges as well, so the keys share their data
+    this->badges_[{StringPool::intern(set), StringPool::intern(version)}] =
+        std::move(emote);
+}
+
+boost::optional<EmotePtr> TwitchBadgeTable::find(const QString &set,
+                                                 const QString &version) const
+{
+    auto it = this->badges_.find({set, version});
+    if (it != this->badges_.end())
+    {
+        return it->second;
+    }
+    return boost::none;
+}
+
+//
+// TwitchBadges
+//
 void TwitchBadges::loadTwitchBadges()
 {
     static QString url(
         "https://badges.twitch.tv/v1/badges/global/display?language=en");
 
     NetworkRequest(url)
-
+        .concurrent()
+        .snapshot()
         .onSuccess([this](auto result) -> Outcome {
+            // runs on a worker thread, the table is published at the end
+            StartupTraceScope trace("TwitchBadges::loadTwitchBadges",
+                                    "network");
+
             auto root = result.parseJson();
-            auto badgeSets = this->badgeSets_.access();
+            auto badges = std::make_unique<TwitchBadgeTable>();
 
             auto jsonSets = root.value("badge_sets").toObject();
             for (auto sIt = jsonSets.begin(); sIt != jsonSets.end(); ++sIt)
@@ -51,11 +83,13 @@ void TwitchBadges::loadTwitchBadges()
                     // "title"
                     // "clickAction"
 
-                    (*badgeSets)[key][vIt.key()] =
-                        std::make_shared<Emote>(emote);
+                    badges->insert(key, vIt.key(),
+                                   std::make_shared<Emote>(emote));
                 }
             }
 
+            this->badges_.publish(std::move(badges));
+
             return Success;
         })
         .execute();
@@ -64,15 +98,9 @@ void TwitchBadges::loadTwitchBadges()
 boost::optional<EmotePtr> TwitchBadges::badge(const QString &set,
                                               const QString &version) const
 {
-    auto badgeSets = this->badgeSets_.access();
-    auto it = badgeSets->find(set);
-    if (it != badgeSets->end())
+    if (auto badges = this->badges_.get())
     {
-        auto it2 = it->second.find(version);
-        if (it2 != it->second.end())
-        {
-            return it2->second;
-        }
+        return badges->find(set, version);
     }
     return boost::none;
 }
@@ -4,7 +4,7 @@
 #include <boost/optional.hpp>
 #include <unordered_map>
 
-#include "common/UniqueAccess.hpp"
+#include "common/Published.hpp"
 #include "util/QStringHash.hpp"
 
 namespace chatterino {
@@ -15,6 +15,30 @@ using EmotePtr = std::shared_ptr<const Emote>;
 class Settings;
 class Paths;
 
+/// Badges of the global or a channel's badge sets, keyed by (set, version),
+/// e.g. ("bits", "100"). It is filled once and then published, after that it
+/// can be read from any thread.
+class TwitchBadgeTable
+{
+public:
+    void insert(const QString &set, const QString &version, EmotePtr emote);
+
+    boost::optional<EmotePtr> find(const QString &set,
+                                   const QString &version) const;
+
+private:
+    using Key = std::pair<QString, QString>;
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const
+        {
+            return qHash(key.first) * 31 + qHash(key.second);
+        }
+    };
+
+    std::unordered_map<Key, EmotePtr, KeyHash> badges_;
+};
+
 class TwitchBadges
 {
 public:
@@ -24,9 +48,7 @@ public:
                                     const QString &version) const;
 
 private:
-    UniqueAccess<
-        std::unordered_map<QString, std::unordered_map<QString, EmotePtr>>>
-        badgeSets_;  // "bits": { "100": ... "500": ...
+    Published<TwitchBadgeTable> badges_;
 };
 
 }  // namespace chatterino
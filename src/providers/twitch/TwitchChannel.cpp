@@ -11,6 +11,7 @@
 #include "providers/bttv/LoadBttvChannelEmote.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "providers/twitch/PubsubClient.hpp"
+#include "providers/twitch/RecentMessagesLoader.hpp"
 #include "providers/twitch/TwitchCommon.hpp"
 #include "providers/twitch/TwitchMessageBuilder.hpp"
 #include "providers/twitch/TwitchParseCheerEmotes.hpp"
@@ -25,7 +26,10 @@
 #include "widgets/Window.hpp"
 
 #include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
 #include <IrcConnection>
+#include <QDateTime>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonValue>
@@ -38,6 +42,11 @@ namespace {
     constexpr char MAGIC_MESSAGE_SUFFIX[] = u8" \U000E0000";
     constexpr int TITLE_REFRESH_PERIOD = 10;
     constexpr int CLIP_CREATION_COOLDOWN = 5000;
+    // ten times the amount of messages a channel keeps built
+    constexpr int COLD_HISTORY_LIMIT = 10000;
+    constexpr int CHATTERS_REFRESH_PERIOD = 5 * 60 * 1000;
+    // time between the chatters requests of two channels
+    constexpr int CHATTERS_REFRESH_STAGGER = 1000;
     const QString CLIPS_LINK("https://clips.twitch.tv/%1");
     const QString CLIPS_FAILURE_CLIPS_DISABLED_TEXT(
         "Failed to create a clip - the streamer has clips disabled entirely or "
@@ -49,97 +58,143 @@ namespace {
     const QString LOGIN_PROMPT_TEXT("Click here to add your account again.");
     const Link ACCOUNTS_LINK(Link::OpenAccountsPage, QString());
 
-    // convertClearchatToNotice takes a Communi::IrcMessage that is a CLEARCHAT command and converts it to a readable NOTICE message
-    // This has historically been done in the Recent Messages API, but this functionality is being moved to Chatterino instead
-    auto convertClearchatToNotice(Communi::IrcMessage *message)
-    {
-        auto channelName = message->parameter(0);
-        QString noticeMessage{};
-        if (message->tags().contains("target-user-id"))
+    struct Chatters {
+        int count = 0;
+        // sorted by CaseInsensitiveLess without duplicates
+        std::vector<QString> names;
+    };
+
+    // Collects "chatter_count" and the names in all categories of "chatters"
+    // without building a document of the whole response
+    struct ChattersHandler
+        : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, ChattersHandler> {
+        Chatters chatters;
+
+        bool Default()
         {
-            auto target = message->parameter(1);
+            this->next_ = Next::None;
+            return true;
+        }
 
-            if (message->tags().contains("ban-duration"))
+        bool Uint(unsigned value)
+        {
+            if (this->next_ == Next::Count)
             {
-                // User was timed out
-                noticeMessage =
-                    QString("%1 has been timed out for %2.")
-                        .arg(target)
-                        .arg(formatTime(
-                            message->tag("ban-duration").toString()));
+                this->chatters.count = int(value);
             }
-            else
+            return this->Default();
+        }
+
+        bool String(const char *str, rapidjson::SizeType length, bool)
+        {
+            // "chatters": {"viewers": ["name", ...], ...}
+            if (this->inChatters_ && this->depth_ == 3)
             {
-                // User was permanently banned
-                noticeMessage =
-                    QString("%1 has been permanently banned.").arg(target);
+                this->chatters.names.push_back(
+                    QString::fromUtf8(str, int(length)));
             }
+            return this->Default();
         }
-        else
+
+        bool Key(const char *str, rapidjson::SizeType length, bool)
         {
-            // Chat was cleared
-            noticeMessage = "Chat has been cleared by a moderator.";
+            this->next_ = Next::None;
+            if (this->depth_ == 1)
+            {
+                QLatin1String key(str, int(length));
+                if (key == QLatin1String("chatter_count"))
+                {
+                    this->next_ = Next::Count;
+                }
+                else if (key == QLatin1String("chatters"))
+                {
+                    this->next_ = Next::Chatters;
+                }
+            }
+            return true;
         }
 
-        // rebuild the raw irc message so we can convert it back to an ircmessage again!
-        // this could probably be done in a smarter way
-
-        auto s = QString(":tmi.twitch.tv NOTICE %1 :%2")
-                     .arg(channelName)
-                     .arg(noticeMessage);
-
-        auto newMessage = Communi::IrcMessage::fromData(s.toUtf8(), nullptr);
-        newMessage->setTags(message->tags());
-
-        return newMessage;
-    }
-
-    // parseRecentMessages takes a json object and returns a vector of
-    // Communi IrcMessages
-    auto parseRecentMessages(const QJsonObject &jsonRoot, ChannelPtr channel)
-    {
-        QJsonArray jsonMessages = jsonRoot.value("messages").toArray();
-        std::vector<Communi::IrcMessage *> messages;
-
-        if (jsonMessages.empty())
-            return messages;
-
-        for (const auto jsonMessage : jsonMessages)
+        bool StartObject()
         {
-            auto content = jsonMessage.toString().toUtf8();
-
-            auto message = Communi::IrcMessage::fromData(content, nullptr);
+            this->depth_++;
+            if (this->depth_ == 2 && this->next_ == Next::Chatters)
+            {
+                this->inChatters_ = true;
+                // the count comes first
+                this->chatters.names.reserve(this->chatters.count);
+            }
+            return this->Default();
+        }
 
-            if (message->command() == "CLEARCHAT")
+        bool EndObject(rapidjson::SizeType)
+        {
+            if (this->depth_ == 2)
             {
-                message = convertClearchatToNotice(message);
+                this->inChatters_ = false;
             }
+            this->depth_--;
+            return true;
+        }
 
-            messages.emplace_back(std::move(message));
+        bool StartArray()
+        {
+            this->depth_++;
+            return this->Default();
         }
 
-        return messages;
-    }
-    std::pair<Outcome, UsernameSet> parseChatters(const QJsonObject &jsonRoot)
-    {
-        static QStringList categories = {"broadcaster", "vips",   "moderators",
-                                         "staff",       "admins", "global_mods",
-                                         "viewers"};
+        bool EndArray(rapidjson::SizeType)
+        {
+            this->depth_--;
+            return true;
+        }
+
+    private:
+        enum class Next { None, Count, Chatters };
 
-        auto usernames = UsernameSet();
+        int depth_ = 0;
+        Next next_ = Next::None;
+        bool inChatters_ = false;
+    };
 
-        // parse json
-        QJsonObject jsonCategories = jsonRoot.value("chatters").toObject();
+    std::pair<Outcome, Chatters> parseChatters(const QByteArray &data)
+    {
+        ChattersHandler handler;
+        rapidjson::Reader reader;
+        rapidjson::StringStream stream(data.constData());
 
-        for (const auto &category : categories)
+        auto result = reader.Parse(stream, handler);
+        if (result.IsError())
         {
-            for (auto jsonCategory : jsonCategories.value(category).toArray())
-            {
-                usernames.insert(jsonCategory.toString());
-            }
+            // keep the chatters we have instead of clearing them
+            qCWarning(chatterinoTwitch)
+                << "Error parsing chatters:"
+                << rapidjson::GetParseError_En(result.Code()) << "("
+                << result.Offset() << ")";
+            return {Failure, {}};
         }
 
-        return {Success, std::move(usernames)};
+        auto &names = handler.chatters.names;
+        std::sort(names.begin(), names.end(), CaseInsensitiveLess());
+        names.erase(std::unique(names.begin(), names.end(),
+                                [](const auto &a, const auto &b) {
+                                    return a.compare(b, Qt::CaseInsensitive) ==
+                                           0;
+                                }),
+                    names.end());
+
+        return {Success, std::move(handler.chatters)};
+    }
+
+    // Hands out the times at which channels may request their chatters, at
+    // least CHATTERS_REFRESH_STAGGER apart. Returns the delay until then.
+    int reserveChattersRefresh()
+    {
+        static qint64 nextRefresh = 0;
+
+        auto now = QDateTime::currentMSecsSinceEpoch();
+        auto at = std::max(now, nextRefresh);
+        nextRefresh = at + CHATTERS_REFRESH_STAGGER;
+        return int(at - now);
     }
 }  // namespace
 
@@ -160,6 +215,7 @@ TwitchChannel::TwitchChannel(const QString &name,
     , ffzEmotes_(std::make_shared<EmoteMap>())
     , mod_(false)
     , titleRefreshedTime_(QTime::currentTime().addSecs(-TITLE_REFRESH_PERIOD))
+    , coldHistory_(COLD_HISTORY_LIMIT)
 {
     qCDebug(chatterinoTwitch) << "[TwitchChannel" << name << "] Opened";
 
@@ -191,7 +247,7 @@ TwitchChannel::TwitchChannel(const QString &name,
     QObject::connect(&this->chattersListTimer_, &QTimer::timeout, [=] {
         this->refreshChatters();
     });
-    this->chattersListTimer_.start(5 * 60 * 1000);
+    this->chattersListTimer_.start(CHATTERS_REFRESH_PERIOD);
 
     QObject::connect(&this->liveStatusTimer_, &QTimer::timeout, [=] {
         this->refreshLiveStatus();
@@ -249,8 +305,7 @@ void TwitchChannel::refreshBTTVChannelEmotes(bool manualRefresh)
         weakOf<Channel>(this), this->roomId(), this->getLocalizedName(),
         [this, weak = weakOf<Channel>(this)](auto &&emoteMap) {
             if (auto shared = weak.lock())
-                this->bttvEmotes_.set(
-                    std::make_shared<EmoteMap>(std::move(emoteMap)));
+                this->bttvEmotes_.set(makeEmoteMapPtr(std::move(emoteMap)));
         },
         manualRefresh);
 }
@@ -261,8 +316,7 @@ void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
         weakOf<Channel>(this), this->roomId(),
         [this, weak = weakOf<Channel>(this)](auto &&emoteMap) {
             if (auto shared = weak.lock())
-                this->ffzEmotes_.set(
-                    std::make_shared<EmoteMap>(std::move(emoteMap)));
+                this->ffzEmotes_.set(makeEmoteMapPtr(std::move(emoteMap)));
         },
         [this, weak = weakOf<Channel>(this)](auto &&modBadge) {
             if (auto shared = weak.lock())
@@ -319,7 +373,13 @@ boost::optional<ChannelPointReward> TwitchChannel::channelPointReward(
     return it->second;
 }
 
-void TwitchChannel::sendMessage(const QString &message)
+ColdHistory &TwitchChannel::coldHistory()
+{
+    return this->coldHistory_;
+}
+
+void TwitchChannel::sendMessage(const QString &message,
+                                SendPriority priority)
 {
     auto app = getApp();
 
@@ -358,7 +418,8 @@ void TwitchChannel::sendMessage(const QString &message)
     }
 
     bool messageSent = false;
-    this->sendMessageSignal.invoke(this->getName(), parsedMessage, messageSent);
+    this->sendMessageSignal.invoke(this->getName(), parsedMessage, priority,
+                                   messageSent);
 
     if (messageSent)
     {
@@ -707,42 +768,7 @@ void TwitchChannel::loadRecentMessages()
         return;
     }
 
-    auto baseURL = Env::get().recentMessagesApiUrl.arg(this->getName());
-
-    auto url = QString("%1?limit=%2")
-                   .arg(baseURL)
-                   .arg(getSettings()->twitchMessageHistoryLimit);
-
-    NetworkRequest(url)
-        .onSuccess([weak = weakOf<Channel>(this)](auto result) -> Outcome {
-            auto shared = weak.lock();
-            if (!shared)
-                return Failure;
-
-            auto messages = parseRecentMessages(result.parseJson(), shared);
-
-            auto &handler = IrcMessageHandler::instance();
-
-            std::vector<MessagePtr> allBuiltMessages;
-
-            for (auto message : messages)
-            {
-                for (auto builtMessage :
-                     handler.parseMessage(shared.get(), message))
-                {
-                    builtMessage->flags.set(MessageFlag::RecentMessage);
-                    allBuiltMessages.emplace_back(builtMessage);
-                }
-            }
-
-            postToThread(
-                [shared, messages = std::move(allBuiltMessages)]() mutable {
-                    shared->addMessagesAtStart(messages);
-                });
-
-            return Success;
-        })
-        .execute();
+    RecentMessagesLoader::instance().load(weakOf<Channel>(this));
 }
 
 void TwitchChannel::refreshPubsub()
@@ -758,6 +784,24 @@ void TwitchChannel::refreshPubsub()
 }
 
 void TwitchChannel::refreshChatters()
+{
+    // the previous refresh is still waiting for its turn
+    if (this->chattersRefreshQueued_)
+    {
+        return;
+    }
+    this->chattersRefreshQueued_ = true;
+
+    // Joining many channels at once would download and parse all of their
+    // chatters at the same time otherwise, and again every refresh period.
+    QTimer::singleShot(reserveChattersRefresh(), &this->chattersListTimer_,
+                       [this] {
+                           this->chattersRefreshQueued_ = false;
+                           this->fetchChatters();
+                       });
+}
+
+void TwitchChannel::fetchChatters()
 {
     // setting?
     const auto streamStatus = this->accessStreamStatus();
@@ -774,23 +818,25 @@ void TwitchChannel::refreshChatters()
     // get viewer list
     NetworkRequest("https://tmi.twitch.tv/group/user/" + this->getName() +
                    "/chatters")
-
+        .concurrent()
         .onSuccess(
             [this, weak = weakOf<Channel>(this)](auto result) -> Outcome {
-                // channel still exists?
-                auto shared = weak.lock();
-                if (!shared)
-                {
-                    return Failure;
-                }
-
-                auto data = result.parseJson();
-                this->chatterCount_ = data.value("chatter_count").toInt();
-
-                auto pair = parseChatters(std::move(data));
+                // parsed on a worker thread, the channel is only touched on
+                // the GUI thread
+                auto pair = parseChatters(result.getData());
                 if (pair.first)
                 {
-                    this->setChatters(std::move(pair.second));
+                    postToThread(
+                        [this, weak, chatters = std::move(pair.second)] {
+                            auto shared = weak.lock();
+                            if (!shared)
+                            {
+                                return;
+                            }
+
+                            this->chatterCount_ = chatters.count;
+                            this->updateChatters(chatters.names);
+                        });
                 }
 
                 return pair.first;
@@ -837,7 +883,7 @@ void TwitchChannel::refreshBadges()
             if (!shared)
                 return Failure;
 
-            auto badgeSets = this->badgeSets_.access();
+            auto badges = std::make_unique<TwitchBadgeTable>();
 
             auto jsonRoot = result.parseJson();
 
@@ -845,8 +891,6 @@ void TwitchChannel::refreshBadges()
             for (auto jsonBadgeSet = _.begin(); jsonBadgeSet != _.end();
                  jsonBadgeSet++)
             {
-                auto &versions = (*badgeSets)[jsonBadgeSet.key()];
-
                 auto _set = jsonBadgeSet->toObject()["versions"].toObject();
                 for (auto jsonVersion_ = _set.begin();
                      jsonVersion_ != _set.end(); jsonVersion_++)
@@ -864,10 +908,13 @@ void TwitchChannel::refreshBadges()
                         Tooltip{jsonVersion["description"].toString()},
                         Url{jsonVersion["clickURL"].toString()}});
 
-                    versions.emplace(jsonVersion_.key(), emote);
+                    badges->insert(jsonBadgeSet.key(), jsonVersion_.key(),
+                                   emote);
                 };
             }
 
+            this->badges_.publish(std::move(badges));
+
             return Success;
         })
         .execute();
@@ -1042,15 +1089,9 @@ void TwitchChannel::createClip()
 boost::optional<EmotePtr> TwitchChannel::twitchBadge(
     const QString &set, const QString &version) const
 {
-    auto badgeSets = this->badgeSets_.access();
-    auto it = badgeSets->find(set);
-    if (it != badgeSets->end())
+    if (auto badges = this->badges_.get())
     {
-        auto it2 = it->second.find(version);
-        if (it2 != it->second.end())
-        {
-            return it2->second;
-        }
+        return badges->find(set, version);
     }
     return boost::none;
 }
@@ -5,9 +5,12 @@
 #include "common/Channel.hpp"
 #include "common/ChannelChatters.hpp"
 #include "common/Outcome.hpp"
+#include "common/Published.hpp"
 #include "common/UniqueAccess.hpp"
 #include "common/UsernameSet.hpp"
 #include "providers/twitch/ChannelPointReward.hpp"
+#include "providers/twitch/ColdHistory.hpp"
+#include "providers/twitch/TwitchBadges.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "providers/twitch/api/Helix.hpp"
 
@@ -17,6 +20,7 @@
 #include <boost/optional.hpp>
 #include <pajlada/signals/signalholder.hpp>
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 
@@ -28,7 +32,6 @@ struct Emote;
 using EmotePtr = std::shared_ptr<const Emote>;
 class EmoteMap;
 
-class TwitchBadges;
 class FfzEmotes;
 class BttvEmotes;
 
@@ -64,7 +67,9 @@ public:
     // Channel methods
     virtual bool isEmpty() const override;
     virtual bool canSendMessage() const override;
-    virtual void sendMessage(const QString &message) override;
+    virtual void sendMessage(
+        const QString &message,
+        SendPriority priority = SendPriority::Automated) override;
     virtual bool isMod() const override;
     bool isVip() const;
     bool isStaff() const;
@@ -119,6 +124,10 @@ public:
     boost::optional<ChannelPointReward> channelPointReward(
         const QString &rewardId) const;
 
+    // Raw lines of the messages, reaching further back than the messages
+    // the channel keeps built
+    ColdHistory &coldHistory();
+
 private:
     struct NameOptions {
         QString displayName;
@@ -136,6 +145,7 @@ private:
     void parseLiveStatus(bool live, const HelixStream &stream);
     void refreshPubsub();
     void refreshChatters();
+    void fetchChatters();
     void refreshBadges();
     void refreshCheerEmotes();
     void loadRecentMessages();
@@ -157,7 +167,7 @@ private:
     const QString subscriptionUrl_;
     const QString channelUrl_;
     const QString popoutPlayerUrl_;
-    int chatterCount_;
+    std::atomic<int> chatterCount_{0};
     UniqueAccess<StreamStatus> streamStatus_;
     UniqueAccess<RoomModes> roomModes_;
 
@@ -173,8 +183,7 @@ protected:
 
 private:
     // Badges
-    UniqueAccess<std::map<QString, std::map<QString, EmotePtr>>>
-        badgeSets_;  // "subscribers": { "0": ... "3": ... "6": ...
+    Published<TwitchBadgeTable> badges_;
     UniqueAccess<std::vector<CheerEmoteSet>> cheerEmoteSets_;
     UniqueAccess<std::map<QString, ChannelPointReward>> channelPointRewards_;
 
@@ -188,10 +197,13 @@ private:
     QObject lifetimeGuard_;
     QTimer liveStatusTimer_;
     QTimer chattersListTimer_;
+    bool chattersRefreshQueued_ = false;
     QTime titleRefreshedTime_;
     QTime timeNextClipCreationAllowed_{QTime().currentTime()};
     bool isClipCreationInProgress{false};
 
+    ColdHistory coldHistory_;
+
     friend class TwitchIrcServer;
     friend class TwitchMessageBuilder;
     friend class IrcMessageHandler;
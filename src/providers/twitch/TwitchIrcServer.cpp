@@ -1,6 +1,7 @@
 #include "TwitchIrcServer.hpp"
 
 #include <IrcCommand>
+#include <QDateTime>
 #include <cassert>
 
 #include "Application.hpp"
@@ -11,21 +12,70 @@
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
+#include "providers/twitch/MessageStore.hpp"
 #include "providers/twitch/PubsubClient.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchHelpers.hpp"
+#include "singletons/Settings.hpp"
+#include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
 
 // using namespace Communi;
 using namespace std::chrono_literals;
 
 namespace chatterino {
+namespace {
+    auto &receivedMessages =
+        DebugCount::counter("twitch irc messages received");
+
+    // Keeps the lines which make up the history of a channel. They're kept
+    // compressed in memory, so searches reach further back than the built
+    // messages, and on disk, so the history can be restored after a restart
+    void storeMessage(TwitchIrcServer &server, Communi::IrcMessage *message)
+    {
+        static const QStringList storedCommands{
+            "PRIVMSG", "USERNOTICE", "CLEARCHAT", "CLEARMSG", "NOTICE"};
+
+        auto target = message->parameter(0);
+        if (!storedCommands.contains(message->command()) ||
+            !target.startsWith('#'))
+        {
+            return;
+        }
+
+        auto channelName = target.mid(1);
+        auto line = message->toData();
+
+        if (getSettings()->storeMessageHistory)
+        {
+            MessageStore::instance().append(channelName, line);
+        }
+
+        // only these are built into chat messages again
+        if (getSettings()->keepColdHistory &&
+            (message->command() == "PRIVMSG" ||
+             message->command() == "USERNOTICE"))
+        {
+            auto channel = server.getChannelOrEmpty(channelName);
+            if (auto *twitchChannel =
+                    dynamic_cast<TwitchChannel *>(channel.get()))
+            {
+                twitchChannel->coldHistory().append(
+                    QDateTime::currentMSecsSinceEpoch(), line);
+            }
+        }
+    }
+}  // namespace
 
 TwitchIrcServer::TwitchIrcServer()
     : whispersChannel(new Channel("/whispers", Channel::Type::TwitchWhispers))
     , mentionsChannel(new Channel("/mentions", Channel::Type::TwitchMentions))
     , watchingChannel(Channel::getEmpty(), Channel::Type::TwitchWatching)
+    , sendScheduler_(
+          [this](const QString &channelName, const QString &message) {
+              this->sendMessage(channelName, message);
+          })
 {
     this->initializeIrc();
 
@@ -45,6 +95,23 @@ void TwitchIrcServer::initialize(Settings &settings, Paths &paths)
         });
     });
 
+    // the cold history only feeds searches, it's dropped when turned off
+    settings.keepColdHistory.connect(
+        [this](bool enabled, auto) {
+            if (enabled)
+            {
+                return;
+            }
+            this->forEachChannel([](ChannelPtr channel) {
+                if (auto *twitchChannel =
+                        dynamic_cast<TwitchChannel *>(channel.get()))
+                {
+                    twitchChannel->coldHistory().clear();
+                }
+            });
+        },
+        this->signalHolder_, false);
+
     this->twitchBadges.loadTwitchBadges();
     this->bttv.loadEmotes();
     this->ffz.loadEmotes();
@@ -93,8 +160,9 @@ std::shared_ptr<Channel> TwitchIrcServer::createChannel(
     channel->initialize();
 
     channel->sendMessageSignal.connect(
-        [this, channel = channel.get()](auto &chan, auto &msg, bool &sent) {
-            this->onMessageSendRequested(channel, msg, sent);
+        [this, channel = channel.get()](auto &chan, auto &msg, auto priority,
+                                        bool &sent) {
+            this->onMessageSendRequested(channel, msg, priority, sent);
         });
 
     return std::shared_ptr<Channel>(channel);
@@ -111,6 +179,9 @@ void TwitchIrcServer::readConnectionMessageReceived(
 {
     AbstractIrcServer::readConnectionMessageReceived(message);
 
+    receivedMessages.increase();
+    storeMessage(*this, message);
+
     if (message->type() == Communi::IrcMessage::Type::Private)
     {
         // We already have a handler for private messages
@@ -221,6 +292,23 @@ void TwitchIrcServer::writeConnectionMessageReceived(
     }
 }
 
+void TwitchIrcServer::sendJoin(IrcConnection *connection,
+                               const QString &channelName)
+{
+    // rejoining hundreds of channels after a reconnect would exceed the JOIN
+    // rate limit
+    this->sendScheduler_.queueJoin(connection, channelName);
+}
+
+void TwitchIrcServer::sendPart(IrcConnection *connection,
+                               const QString &channelName)
+{
+    // a closed channel must not be joined by a JOIN that is still queued
+    this->sendScheduler_.cancelJoin(connection, channelName);
+
+    AbstractIrcServer::sendPart(connection, channelName);
+}
+
 void TwitchIrcServer::onReadConnected(IrcConnection *connection)
 {
     // twitch.tv/tags enables IRCv3 tags on messages. See https://dev.twitch.tv/docs/irc/tags/
@@ -330,63 +418,50 @@ bool TwitchIrcServer::hasSeparateWriteConnection() const
 }
 
 void TwitchIrcServer::onMessageSendRequested(TwitchChannel *channel,
-                                             const QString &message, bool &sent)
+                                             const QString &message,
+                                             Channel::SendPriority priority,
+                                             bool &sent)
 {
-    sent = false;
+    auto result = this->sendScheduler_.queueMessage(
+        channel->shared_from_this(), message, channel->hasHighRateLimit(),
+        priority);
 
-    {
-        std::lock_guard<std::mutex> guard(this->lastMessageMutex_);
+    auto now = std::chrono::steady_clock::now();
 
-        //        std::queue<std::chrono::steady_clock::time_point>
-        auto &lastMessage = channel->hasHighRateLimit()
-                                ? this->lastMessageMod_
-                                : this->lastMessagePleb_;
-        size_t maxMessageCount = channel->hasHighRateLimit() ? 99 : 19;
-        auto minMessageOffset = (channel->hasHighRateLimit() ? 100ms : 1100ms);
+    switch (result)
+    {
+        case TwitchSendScheduler::QueueResult::Sent: {
+            sent = true;
+        }
+        break;
 
-        auto now = std::chrono::steady_clock::now();
+        case TwitchSendScheduler::QueueResult::Queued: {
+            sent = true;
 
-        // check if you are sending messages too fast
-        if (!lastMessage.empty() && lastMessage.back() + minMessageOffset > now)
-        {
             if (this->lastErrorTimeSpeed_ + 30s < now)
             {
-                auto errorMessage =
-                    makeSystemMessage("You are sending messages too quickly.");
-
-                channel->addMessage(errorMessage);
+                channel->addMessage(makeSystemMessage(
+                    "You are sending messages too quickly. Your messages are "
+                    "queued and will be sent as soon as possible."));
 
                 this->lastErrorTimeSpeed_ = now;
             }
-            return;
         }
+        break;
 
-        // remove messages older than 30 seconds
-        while (!lastMessage.empty() && lastMessage.front() + 32s < now)
-        {
-            lastMessage.pop();
-        }
+        case TwitchSendScheduler::QueueResult::QueueFull: {
+            sent = false;
 
-        // check if you are sending too many messages
-        if (lastMessage.size() >= maxMessageCount)
-        {
             if (this->lastErrorTimeAmount_ + 30s < now)
             {
-                auto errorMessage =
-                    makeSystemMessage("You are sending too many messages.");
-
-                channel->addMessage(errorMessage);
+                channel->addMessage(
+                    makeSystemMessage("You are sending too many messages."));
 
                 this->lastErrorTimeAmount_ = now;
             }
-            return;
         }
-
-        lastMessage.push(now);
+        break;
     }
-
-    this->sendMessage(channel->getName(), message);
-    sent = true;
 }
 
 const BttvEmotes &TwitchIrcServer::getBttvEmotes() const
@@ -398,4 +473,9 @@ const FfzEmotes &TwitchIrcServer::getFfzEmotes() const
     return this->ffz;
 }
 
+const TwitchSendScheduler &TwitchIrcServer::getSendScheduler() const
+{
+    return this->sendScheduler_;
+}
+
 }  // namespace chatterino
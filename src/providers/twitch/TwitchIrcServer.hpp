@@ -8,10 +8,10 @@
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/irc/AbstractIrcServer.hpp"
 #include "providers/twitch/TwitchBadges.hpp"
+#include "providers/twitch/TwitchSendScheduler.hpp"
 
 #include <chrono>
 #include <memory>
-#include <queue>
 
 namespace chatterino {
 
@@ -43,6 +43,8 @@ public:
     const BttvEmotes &getBttvEmotes() const;
     const FfzEmotes &getFfzEmotes() const;
 
+    const TwitchSendScheduler &getSendScheduler() const;
+
 protected:
     virtual void initializeConnection(IrcConnection *connection,
                                       ConnectionType type) override;
@@ -56,6 +58,11 @@ protected:
     virtual void writeConnectionMessageReceived(
         Communi::IrcMessage *message) override;
 
+    virtual void sendJoin(IrcConnection *connection,
+                          const QString &channelName) override;
+    virtual void sendPart(IrcConnection *connection,
+                          const QString &channelName) override;
+
     virtual void onReadConnected(IrcConnection *connection) override;
     virtual void onWriteConnected(IrcConnection *connection) override;
 
@@ -67,11 +74,9 @@ protected:
 
 private:
     void onMessageSendRequested(TwitchChannel *channel, const QString &message,
-                                bool &sent);
+                                Channel::SendPriority priority, bool &sent);
 
-    std::mutex lastMessageMutex_;
-    std::queue<std::chrono::steady_clock::time_point> lastMessagePleb_;
-    std::queue<std::chrono::steady_clock::time_point> lastMessageMod_;
+    TwitchSendScheduler sendScheduler_;
     std::chrono::steady_clock::time_point lastErrorTimeSpeed_;
     std::chrono::steady_clock::time_point lastErrorTimeAmount_;
 
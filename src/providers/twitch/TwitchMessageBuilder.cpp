@@ -4,6 +4,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnoreReplacer.hpp"
 #include "messages/Message.hpp"
 #include "providers/chatterino/ChatterinoBadges.hpp"
 #include "providers/ffz/FfzBadges.hpp"
@@ -17,6 +18,7 @@
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/IrcHelpers.hpp"
+#include "util/StringPool.hpp"
 #include "widgets/Window.hpp"
 
 #include <QApplication>
@@ -27,6 +29,8 @@
 #include <boost/variant.hpp>
 #include "common/QLogging.hpp"
 
+#include <mutex>
+
 namespace {
 
 const QString regexHelpString("(\\w+)[.,!?;:]*?$");
@@ -85,7 +89,8 @@ namespace {
                 continue;
             }
 
-            badgeInfos.emplace(parts[0], parts[1]);
+            badgeInfos.emplace(StringPool::intern(parts[0]),
+                               StringPool::intern(parts[1]));
         }
 
         return badgeInfos;
@@ -103,12 +108,80 @@ namespace {
                 continue;
             }
 
-            badges.emplace_back(parts[0], parts[1]);
+            badges.emplace_back(StringPool::intern(parts[0]),
+                                StringPool::intern(parts[1]));
         }
 
         return badges;
     }
 
+    struct CompiledIgnores {
+        std::shared_ptr<const std::vector<IgnorePhrase>> phrases;
+        // the phrases that replace, indexed like the rules of the replacer
+        std::vector<const IgnorePhrase *> replacing;
+        IgnoreReplacer replacer;
+    };
+
+    // compiled again whenever the ignored phrases change
+    std::shared_ptr<const CompiledIgnores> compiledIgnores()
+    {
+        static std::mutex mutex;
+        static std::shared_ptr<const CompiledIgnores> compiled;
+
+        auto phrases = getCSettings().ignoredMessages.readOnly();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (compiled == nullptr || compiled->phrases != phrases)
+        {
+            std::vector<IgnoreReplacer::Rule> rules;
+            std::vector<const IgnorePhrase *> replacing;
+            for (const auto &phrase : *phrases)
+            {
+                if (phrase.isBlock())
+                {
+                    continue;
+                }
+
+                rules.push_back({phrase.getPattern(), phrase.isRegex(),
+                                 phrase.isCaseSensitive(),
+                                 phrase.getReplace()});
+                replacing.push_back(&phrase);
+            }
+
+            compiled = std::make_shared<const CompiledIgnores>(
+                CompiledIgnores{phrases, std::move(replacing),
+                                IgnoreReplacer(std::move(rules))});
+        }
+        return compiled;
+    }
+
+    bool isWordCharacter(QChar c)
+    {
+        return c.isLetterOrNumber() || c == '_';
+    }
+
+    // where \bword\b first matches in text between from and to, or -1
+    int indexOfWholeWord(const QString &text, const QString &word, int from,
+                         int to)
+    {
+        auto isBoundary = [&text](int index) {
+            auto before = index > 0 && isWordCharacter(text[index - 1]);
+            auto after = index < text.size() && isWordCharacter(text[index]);
+            return before != after;
+        };
+
+        for (auto index = text.indexOf(word, from);
+             index != -1 && index + word.size() <= to;
+             index = text.indexOf(word, index + 1))
+        {
+            if (isBoundary(index) && isBoundary(index + word.size()))
+            {
+                return index;
+            }
+        }
+        return -1;
+    }
+
 }  // namespace
 
 TwitchMessageBuilder::TwitchMessageBuilder(
@@ -589,7 +662,8 @@ void TwitchMessageBuilder::parseUsername()
 
     if (this->userName.isEmpty() || this->args.trimSubscriberUsername)
     {
-        this->userName = this->tags.value(QLatin1String("login")).toString();
+        this->userName = StringPool::intern(
+            this->tags.value(QLatin1String("login")).toString());
     }
 
     // display name
@@ -624,8 +698,8 @@ void TwitchMessageBuilder::appendUsername()
     auto iterator = this->tags.find("display-name");
     if (iterator != this->tags.end())
     {
-        QString displayName =
-            parseTagString(iterator.value().toString()).trimmed();
+        QString displayName = StringPool::intern(
+            parseTagString(iterator.value().toString()).trimmed());
 
         if (QString::compare(displayName, this->userName,
                              Qt::CaseInsensitive) == 0)
@@ -734,220 +808,105 @@ void TwitchMessageBuilder::appendUsername()
 void TwitchMessageBuilder::runIgnoreReplaces(
     std::vector<TwitchEmoteOccurence> &twitchEmotes)
 {
-    auto phrases = getCSettings().ignoredMessages.readOnly();
-    auto removeEmotesInRange = [](int pos, int len,
-                                  auto &twitchEmotes) mutable {
-        auto it = std::partition(
-            twitchEmotes.begin(), twitchEmotes.end(),
-            [pos, len](const auto &item) {
-                return !((item.start >= pos) && item.start < (pos + len));
-            });
-        for (auto copy = it; copy != twitchEmotes.end(); ++copy)
+    auto ignores = compiledIgnores();
+    auto edits = ignores->replacer.replace(this->originalMessage_);
+    if (edits.empty())
+    {
+        return;
+    }
+
+    const auto &message = this->originalMessage_;
+
+    // the words around a replacement in the new message
+    auto wordsAround = [&message](const IgnoreReplacer::Edit &edit) {
+        auto from = edit.newFrom;
+        while (from > 0 && message[from - 1] != ' ')
         {
-            if ((*copy).ptr == nullptr)
-            {
-                qCDebug(chatterinoTwitch)
-                    << "remem nullptr" << (*copy).name.string;
-            }
+            --from;
         }
-        std::vector<TwitchEmoteOccurence> v(it, twitchEmotes.end());
-        twitchEmotes.erase(it, twitchEmotes.end());
-        return v;
-    };
-
-    auto shiftIndicesAfter = [&twitchEmotes](int pos, int by) mutable {
-        for (auto &item : twitchEmotes)
+        auto to = edit.newFrom + edit.newLength;
+        while (to < message.size() && message[to] != ' ')
         {
-            auto &index = item.start;
-            if (index >= pos)
-            {
-                index += by;
-                item.end += by;
-            }
+            ++to;
         }
+        return std::make_pair(from, to);
     };
 
-    auto addReplEmotes = [&twitchEmotes](const IgnorePhrase &phrase,
-                                         const QStringRef &midrepl,
-                                         int startIndex) mutable {
-        if (!phrase.containsEmote())
-        {
-            return;
-        }
+    // One pass over the emotes and edits: emotes behind an edit are shifted,
+    // emotes inside a replaced range are looked for again around it.
+    std::sort(twitchEmotes.begin(), twitchEmotes.end(),
+              [](const auto &a, const auto &b) {
+                  return a.start < b.start;
+              });
 
-        QVector<QStringRef> words = midrepl.split(' ');
-        int pos = 0;
-        for (const auto &word : words)
+    std::vector<TwitchEmoteOccurence> remapped;
+    remapped.reserve(twitchEmotes.size());
+
+    size_t edit = 0;
+    int shift = 0;
+    for (auto &emote : twitchEmotes)
+    {
+        while (edit < edits.size() &&
+               edits[edit].from + edits[edit].length <= emote.start)
         {
-            for (const auto &emote : phrase.getEmotes())
-            {
-                if (word == emote.first.string)
-                {
-                    if (emote.second == nullptr)
-                    {
-                        qCDebug(chatterinoTwitch)
-                            << "emote null" << emote.first.string;
-                    }
-                    twitchEmotes.push_back(TwitchEmoteOccurence{
-                        startIndex + pos,
-                        startIndex + pos + emote.first.string.length(),
-                        emote.second,
-                        emote.first,
-                    });
-                }
-            }
-            pos += word.length() + 1;
+            shift += edits[edit].newLength - edits[edit].length;
+            ++edit;
         }
-    };
 
-    for (const auto &phrase : *phrases)
-    {
-        if (phrase.isBlock())
+        if (edit == edits.size() || emote.start < edits[edit].from)
         {
+            emote.start += shift;
+            emote.end += shift;
+            remapped.push_back(std::move(emote));
             continue;
         }
-        const auto &pattern = phrase.getPattern();
-        if (pattern.isEmpty())
+
+        if (emote.ptr == nullptr)
         {
             continue;
         }
-        if (phrase.isRegex())
-        {
-            const auto &regex = phrase.getRegex();
-            if (!regex.isValid())
-            {
-                continue;
-            }
-            QRegularExpressionMatch match;
-            int from = 0;
-            while ((from = this->originalMessage_.indexOf(regex, from,
-                                                          &match)) != -1)
-            {
-                int len = match.capturedLength();
-                auto vret = removeEmotesInRange(from, len, twitchEmotes);
-                auto mid = this->originalMessage_.mid(from, len);
-                mid.replace(regex, phrase.getReplace());
-
-                int midsize = mid.size();
-                this->originalMessage_.replace(from, len, mid);
-                int pos1 = from;
-                while (pos1 > 0)
-                {
-                    if (this->originalMessage_[pos1 - 1] == ' ')
-                    {
-                        break;
-                    }
-                    --pos1;
-                }
-                int pos2 = from + midsize;
-                while (pos2 < this->originalMessage_.length())
-                {
-                    if (this->originalMessage_[pos2] == ' ')
-                    {
-                        break;
-                    }
-                    ++pos2;
-                }
-
-                shiftIndicesAfter(from + len, midsize - len);
-
-                auto midExtendedRef =
-                    this->originalMessage_.midRef(pos1, pos2 - pos1);
 
-                for (auto &tup : vret)
-                {
-                    if (tup.ptr == nullptr)
-                    {
-                        qCDebug(chatterinoTwitch)
-                            << "v nullptr" << tup.name.string;
-                        continue;
-                    }
-                    QRegularExpression emoteregex(
-                        "\\b" + tup.name.string + "\\b",
-                        QRegularExpression::UseUnicodePropertiesOption);
-                    auto _match = emoteregex.match(midExtendedRef);
-                    if (_match.hasMatch())
-                    {
-                        int last = _match.lastCapturedIndex();
-                        for (int i = 0; i <= last; ++i)
-                        {
-                            tup.start = from + _match.capturedStart();
-                            twitchEmotes.push_back(std::move(tup));
-                        }
-                    }
-                }
-
-                addReplEmotes(phrase, midExtendedRef, pos1);
+        auto range = wordsAround(edits[edit]);
+        auto start = indexOfWholeWord(message, emote.name.string, range.first,
+                                      range.second);
+        if (start != -1)
+        {
+            emote.start = start;
+            emote.end = start + emote.name.string.size() - 1;
+            remapped.push_back(std::move(emote));
+        }
+    }
 
-                from += midsize;
-            }
+    // emotes of the user which are part of the replacements
+    for (const auto &edit : edits)
+    {
+        const auto &phrase = *ignores->replacing[edit.rule];
+        if (!phrase.containsEmote())
+        {
+            continue;
         }
-        else
+
+        auto range = wordsAround(edit);
+        auto words = message.midRef(range.first, range.second - range.first)
+                         .split(' ');
+        auto start = range.first;
+        for (const auto &word : words)
         {
-            int from = 0;
-            while ((from = this->originalMessage_.indexOf(
-                        pattern, from, phrase.caseSensitivity())) != -1)
+            auto it = phrase.getEmotes().find(EmoteName{word.toString()});
+            if (it != phrase.getEmotes().end())
             {
-                int len = pattern.size();
-                auto vret = removeEmotesInRange(from, len, twitchEmotes);
-                auto replace = phrase.getReplace();
-
-                int replacesize = replace.size();
-                this->originalMessage_.replace(from, len, replace);
-
-                int pos1 = from;
-                while (pos1 > 0)
-                {
-                    if (this->originalMessage_[pos1 - 1] == ' ')
-                    {
-                        break;
-                    }
-                    --pos1;
-                }
-                int pos2 = from + replacesize;
-                while (pos2 < this->originalMessage_.length())
-                {
-                    if (this->originalMessage_[pos2] == ' ')
-                    {
-                        break;
-                    }
-                    ++pos2;
-                }
-
-                shiftIndicesAfter(from + len, replacesize - len);
-
-                auto midExtendedRef =
-                    this->originalMessage_.midRef(pos1, pos2 - pos1);
-
-                for (auto &tup : vret)
-                {
-                    if (tup.ptr == nullptr)
-                    {
-                        qCDebug(chatterinoTwitch)
-                            << "v nullptr" << tup.name.string;
-                        continue;
-                    }
-                    QRegularExpression emoteregex(
-                        "\\b" + tup.name.string + "\\b",
-                        QRegularExpression::UseUnicodePropertiesOption);
-                    auto match = emoteregex.match(midExtendedRef);
-                    if (match.hasMatch())
-                    {
-                        int last = match.lastCapturedIndex();
-                        for (int i = 0; i <= last; ++i)
-                        {
-                            tup.start = from + match.capturedStart();
-                            twitchEmotes.push_back(std::move(tup));
-                        }
-                    }
-                }
-
-                addReplEmotes(phrase, midExtendedRef, pos1);
-
-                from += replacesize;
+                remapped.push_back(TwitchEmoteOccurence{
+                    start,
+                    start + word.size() - 1,
+                    it->second,
+                    it->first,
+                });
             }
+            start += word.size() + 1;
         }
     }
+
+    twitchEmotes = std::move(remapped);
 }
 
 void TwitchMessageBuilder::appendTwitchEmote(
@@ -0,0 +1,158 @@
+#include "providers/twitch/TwitchSendQueue.hpp"
+
+#include <QSet>
+
+using namespace std::chrono_literals;
+
+namespace chatterino {
+namespace {
+    // Twitch allows 20 messages per 30 seconds, or 100 in channels where the
+    // user is a moderator, vip or the broadcaster. The windows are a little
+    // larger than that to account for latency.
+    constexpr size_t PLEB_MESSAGE_LIMIT = 19;
+    constexpr size_t MOD_MESSAGE_LIMIT = 99;
+    constexpr auto MESSAGE_WINDOW = 32s;
+
+    // minimum time between two messages in the same channel
+    constexpr auto PLEB_CHANNEL_INTERVAL = 1100ms;
+    constexpr auto MOD_CHANNEL_INTERVAL = 100ms;
+}  // namespace
+
+TwitchSendQueue::TwitchSendQueue()
+    : plebLimit_(PLEB_MESSAGE_LIMIT, MESSAGE_WINDOW)
+    , modLimit_(MOD_MESSAGE_LIMIT, MESSAGE_WINDOW)
+{
+}
+
+bool TwitchSendQueue::push(Message message)
+{
+    if (this->size() >= MAX_SIZE)
+    {
+        return false;
+    }
+
+    (message.interactive ? this->interactive_ : this->automated_)
+        .push_back(std::move(message));
+    return true;
+}
+
+std::vector<TwitchSendQueue::Message> TwitchSendQueue::takeReady(
+    Clock::time_point now, Clock::duration &nextDelay)
+{
+    std::vector<Message> ready;
+
+    // Interactive messages go first. An automated message may still be sent
+    // if the interactive ones are waiting for their channel's interval.
+    bool progressed = true;
+    while (progressed)
+    {
+        progressed = false;
+
+        for (auto *queue : {&this->interactive_, &this->automated_})
+        {
+            // channels whose first message has to wait, their later
+            // messages mustn't overtake it
+            QSet<QString> waiting;
+            for (auto it = queue->begin(); it != queue->end(); ++it)
+            {
+                if (waiting.contains(it->channelName))
+                {
+                    continue;
+                }
+
+                if (this->delay(*it, now) == Clock::duration{0})
+                {
+                    this->record(*it, now);
+                    ready.push_back(std::move(*it));
+                    queue->erase(it);
+                    progressed = true;
+                    break;
+                }
+                waiting.insert(it->channelName);
+            }
+
+            if (progressed)
+            {
+                break;
+            }
+        }
+    }
+
+    nextDelay = Clock::duration::max();
+    for (auto *queue : {&this->interactive_, &this->automated_})
+    {
+        for (const auto &message : *queue)
+        {
+            nextDelay = std::min(nextDelay, this->delay(message, now));
+        }
+    }
+
+    // forget channels that can't limit the next message anymore
+    if (this->lastChannelMessage_.size() > 100)
+    {
+        for (auto it = this->lastChannelMessage_.begin();
+             it != this->lastChannelMessage_.end();)
+        {
+            if (it.value() + PLEB_CHANNEL_INTERVAL < now)
+                it = this->lastChannelMessage_.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    return ready;
+}
+
+bool TwitchSendQueue::contains(uint64_t id) const
+{
+    for (const auto *queue : {&this->interactive_, &this->automated_})
+    {
+        auto found = std::any_of(queue->begin(), queue->end(),
+                                 [id](const auto &message) {
+                                     return message.id == id;
+                                 });
+        if (found)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t TwitchSendQueue::size() const
+{
+    return this->interactive_.size() + this->automated_.size();
+}
+
+std::chrono::milliseconds TwitchSendQueue::lastWait() const
+{
+    return this->lastWait_;
+}
+
+TwitchSendQueue::Clock::duration TwitchSendQueue::delay(
+    const Message &message, Clock::time_point now)
+{
+    auto &limit = message.highRateLimit ? this->modLimit_ : this->plebLimit_;
+    auto delay = limit.delay(now);
+
+    auto it = this->lastChannelMessage_.find(message.channelName);
+    if (it != this->lastChannelMessage_.end())
+    {
+        auto interval = message.highRateLimit ? MOD_CHANNEL_INTERVAL
+                                              : PLEB_CHANNEL_INTERVAL;
+        delay = std::max(delay, it.value() + interval - now);
+    }
+
+    return std::max(delay, Clock::duration{0});
+}
+
+void TwitchSendQueue::record(const Message &message, Clock::time_point now)
+{
+    (message.highRateLimit ? this->modLimit_ : this->plebLimit_).record(now);
+    this->lastChannelMessage_[message.channelName] = now;
+
+    this->lastWait_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now - message.queuedAt);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "util/RateLimit.hpp"
+
+#include <QHash>
+#include <QString>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class Channel;
+
+// TwitchSendQueue decides which queued messages may be sent to twitch at a
+// given time, see TwitchSendScheduler. It has no timers or locks of its own.
+//
+// Interactive messages go before automated ones. A message waiting for its
+// channel's interval doesn't hold up the messages of other channels, but the
+// messages of one channel are always sent in the order they were queued.
+class TwitchSendQueue
+{
+public:
+    using Clock = RateLimit::Clock;
+
+    struct Message {
+        uint64_t id;
+        // only kept for the scheduler, the queue doesn't look at it
+        std::weak_ptr<Channel> channel;
+        QString channelName;
+        QString text;
+        bool highRateLimit;
+        bool interactive;
+        Clock::time_point queuedAt;
+    };
+
+    static constexpr size_t MAX_SIZE = 100;
+
+    TwitchSendQueue();
+
+    // Returns false if the queue is full
+    bool push(Message message);
+
+    // Removes the messages that may be sent at now and records them against
+    // the limits, in the order they have to be sent. nextDelay is set to how
+    // long the first of the remaining messages has to wait, or to
+    // Clock::duration::max() if none are left.
+    std::vector<Message> takeReady(Clock::time_point now,
+                                   Clock::duration &nextDelay);
+
+    // Drops the messages the predicate returns true for
+    template <typename Predicate>
+    void removeIf(Predicate predicate)
+    {
+        for (auto *queue : {&this->interactive_, &this->automated_})
+        {
+            queue->erase(
+                std::remove_if(queue->begin(), queue->end(), predicate),
+                queue->end());
+        }
+    }
+
+    bool contains(uint64_t id) const;
+    size_t size() const;
+
+    // how long the last sent message had to wait in the queue
+    std::chrono::milliseconds lastWait() const;
+
+private:
+    Clock::duration delay(const Message &message, Clock::time_point now);
+    void record(const Message &message, Clock::time_point now);
+
+    std::deque<Message> interactive_;
+    std::deque<Message> automated_;
+
+    RateLimit plebLimit_;
+    RateLimit modLimit_;
+    QHash<QString, Clock::time_point> lastChannelMessage_;
+    std::chrono::milliseconds lastWait_{0};
+};
+
+}  // namespace chatterino
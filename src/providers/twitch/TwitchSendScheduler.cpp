@@ -0,0 +1,215 @@
+#include "providers/twitch/TwitchSendScheduler.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "providers/irc/IrcConnection2.hpp"
+#include "util/DebugCount.hpp"
+#include "util/PostToThread.hpp"
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+namespace chatterino {
+namespace {
+    // Twitch allows 20 JOINs per 10 seconds
+    constexpr size_t JOIN_LIMIT = 18;
+    constexpr auto JOIN_WINDOW = 11s;
+
+    auto &queuedMessages = DebugCount::counter("send queue messages");
+    auto &queuedJoins = DebugCount::counter("send queue joins");
+    auto &lastWait = DebugCount::counter("send queue last wait (ms)");
+}  // namespace
+
+TwitchSendScheduler::TwitchSendScheduler(SendFunction sendMessage)
+    : sendMessage_(std::move(sendMessage))
+    , joinLimit_(JOIN_LIMIT, JOIN_WINDOW)
+{
+    this->timer_.setSingleShot(true);
+    QObject::connect(&this->timer_, &QTimer::timeout, [this] {
+        this->flush();
+    });
+}
+
+TwitchSendScheduler::QueueResult TwitchSendScheduler::queueMessage(
+    const ChannelPtr &channel, const QString &message, bool highRateLimit,
+    Channel::SendPriority priority)
+{
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        id = this->nextMessageId_;
+        if (!this->messages_.push(
+                {id, channel, channel->getName(), message, highRateLimit,
+                 priority == Channel::SendPriority::Interactive,
+                 Clock::now()}))
+        {
+            return QueueResult::QueueFull;
+        }
+        this->nextMessageId_++;
+    }
+
+    if (!isGuiThread())
+    {
+        this->scheduleFlush();
+        return QueueResult::Queued;
+    }
+
+    this->flush();
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->messages_.contains(id) ? QueueResult::Queued
+                                        : QueueResult::Sent;
+}
+
+void TwitchSendScheduler::queueJoin(IrcConnection *connection,
+                                    const QString &channelName)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        auto join = std::find_if(this->joins_.begin(), this->joins_.end(),
+                                 [&](const auto &pending) {
+                                     return pending.channelName == channelName;
+                                 });
+        if (join != this->joins_.end())
+        {
+            // the JOIN is waiting for its turn already, it's sent on all
+            // connections at once
+            if (std::find(join->connections.begin(), join->connections.end(),
+                          connection) == join->connections.end())
+            {
+                join->connections.emplace_back(connection);
+            }
+            return;
+        }
+
+        this->joins_.push_back({channelName, {connection}});
+    }
+
+    this->scheduleFlush();
+}
+
+void TwitchSendScheduler::cancelJoin(IrcConnection *connection,
+                                     const QString &channelName)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    auto join = std::find_if(this->joins_.begin(), this->joins_.end(),
+                             [&](const auto &pending) {
+                                 return pending.channelName == channelName;
+                             });
+    if (join == this->joins_.end())
+    {
+        return;
+    }
+
+    join->connections.erase(std::remove(join->connections.begin(),
+                                        join->connections.end(), connection),
+                            join->connections.end());
+    if (join->connections.empty())
+    {
+        this->joins_.erase(join);
+    }
+
+    this->updateCounters();
+}
+
+size_t TwitchSendScheduler::queuedMessageCount() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    return this->messages_.size();
+}
+
+size_t TwitchSendScheduler::queuedJoinCount() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    return this->joins_.size();
+}
+
+std::chrono::milliseconds TwitchSendScheduler::lastMessageWait() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    return this->messages_.lastWait();
+}
+
+void TwitchSendScheduler::flush()
+{
+    assertInGuiThread();
+
+    std::vector<TwitchSendQueue::Message> messages;
+    std::vector<PendingJoin> joins;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        auto now = Clock::now();
+
+        this->messages_.removeIf([](const auto &message) {
+            return message.channel.expired();
+        });
+        auto nextFlush = Clock::duration::max();
+        messages = this->messages_.takeReady(now, nextFlush);
+
+        while (!this->joins_.empty())
+        {
+            auto delay = this->joinLimit_.delay(now);
+            if (delay != Clock::duration{0})
+            {
+                nextFlush = std::min(nextFlush, delay);
+                break;
+            }
+
+            this->joinLimit_.record(now);
+            joins.push_back(std::move(this->joins_.front()));
+            this->joins_.pop_front();
+        }
+
+        if (nextFlush != Clock::duration::max())
+        {
+            this->timer_.start(int(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    nextFlush)
+                    .count() +
+                1));
+        }
+
+        this->updateCounters();
+    }
+
+    for (const auto &message : messages)
+    {
+        this->sendMessage_(message.channelName, message.text);
+    }
+
+    for (const auto &join : joins)
+    {
+        for (const auto &connection : join.connections)
+        {
+            // the channels are joined again once the connection is back
+            if (connection && connection->isConnected())
+            {
+                connection->sendRaw("JOIN #" + join.channelName);
+            }
+        }
+    }
+}
+
+void TwitchSendScheduler::scheduleFlush()
+{
+    postToThread([this] {
+        this->flush();
+    });
+}
+
+void TwitchSendScheduler::updateCounters()
+{
+    queuedMessages.set(int64_t(this->messages_.size()));
+    queuedJoins.set(int64_t(this->joins_.size()));
+    lastWait.set(this->messages_.lastWait().count());
+}
+
+}  // namespace chatterino
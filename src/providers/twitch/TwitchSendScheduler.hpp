@@ -0,0 +1,74 @@
+#pragma once
+
+#include "common/Channel.hpp"
+#include "providers/twitch/TwitchSendQueue.hpp"
+#include "util/RateLimit.hpp"
+
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+class IrcConnection;
+
+// TwitchSendScheduler keeps the messages and JOINs sent to twitch within the
+// rate limits. Instead of refusing messages that would exceed a limit they
+// are queued and sent as soon as the limits allow it.
+// Messages typed by the user are sent before queued automated messages such
+// as moderation actions.
+class TwitchSendScheduler
+{
+public:
+    using Clock = RateLimit::Clock;
+    using SendFunction = std::function<void(const QString &channelName,
+                                            const QString &message)>;
+
+    enum class QueueResult { Sent, Queued, QueueFull };
+
+    explicit TwitchSendScheduler(SendFunction sendMessage);
+
+    QueueResult queueMessage(const ChannelPtr &channel, const QString &message,
+                             bool highRateLimit,
+                             Channel::SendPriority priority);
+    // A channel joined on the read and the write connection only counts
+    // once against the JOIN limit
+    void queueJoin(IrcConnection *connection, const QString &channelName);
+    // Drops the JOIN if it is still queued, for channels that were closed
+    void cancelJoin(IrcConnection *connection, const QString &channelName);
+
+    size_t queuedMessageCount() const;
+    size_t queuedJoinCount() const;
+
+    // how long the last sent message had to wait in the queue
+    std::chrono::milliseconds lastMessageWait() const;
+
+private:
+    struct PendingJoin {
+        QString channelName;
+        std::vector<QPointer<IrcConnection>> connections;
+    };
+
+    void flush();
+    void scheduleFlush();
+    void updateCounters();
+
+    SendFunction sendMessage_;
+
+    mutable std::mutex mutex_;
+    TwitchSendQueue messages_;
+    std::deque<PendingJoin> joins_;
+    uint64_t nextMessageId_ = 0;
+
+    RateLimit joinLimit_;
+
+    QTimer timer_;
+};
+
+}  // namespace chatterino
@@ -11,8 +11,57 @@
 
 namespace chatterino {
 
+namespace {
+    // new lines are indexed in the background every few minutes
+    constexpr int INDEX_INTERVAL = 5 * 60 * 1000;
+    // the first pass waits until the startup is done
+    constexpr int INITIAL_INDEX_DELAY = 30 * 1000;
+}  // namespace
+
 void Logging::initialize(Settings &settings, Paths &paths)
 {
+    QObject::connect(&this->indexTimer_, &QTimer::timeout, [this] {
+        this->indexTimer_.setInterval(INDEX_INTERVAL);
+        if (this->index_)
+        {
+            this->index_->update();
+        }
+    });
+
+    settings.enableLogIndex.connect(
+        [this](auto, auto) {
+            this->resetIndex();
+        },
+        false);
+    settings.logPath.connect(
+        [this](auto, auto) {
+            this->resetIndex();
+        },
+        false);
+
+    this->resetIndex();
+}
+
+void Logging::resetIndex()
+{
+    this->index_.reset();
+    this->indexTimer_.stop();
+
+    if (!getSettings()->enableLogIndex)
+    {
+        return;
+    }
+
+    auto logPath = getSettings()->logPath.getValue();
+    this->index_ = std::make_unique<LogIndex>(
+        logPath.isEmpty() ? getPaths()->messageLogDirectory : logPath);
+
+    this->indexTimer_.start(INITIAL_INDEX_DELAY);
+}
+
+LogIndex *Logging::getIndex()
+{
+    return this->index_.get();
 }
 
 void Logging::addMessage(const QString &channelName, MessagePtr message)
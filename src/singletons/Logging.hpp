@@ -3,8 +3,11 @@
 #include "common/Singleton.hpp"
 
 #include "messages/Message.hpp"
+#include "singletons/helper/LogIndex.hpp"
 #include "singletons/helper/LoggingChannel.hpp"
 
+#include <QTimer>
+
 #include <memory>
 
 namespace chatterino {
@@ -22,8 +25,16 @@ public:
 
     void addMessage(const QString &channelName, MessagePtr message);
 
+    // Returns the full text index over the logs, nullptr if it is disabled
+    LogIndex *getIndex();
+
 private:
+    void resetIndex();
+
     std::map<QString, std::unique_ptr<LoggingChannel>> loggingChannels_;
+
+    std::unique_ptr<LogIndex> index_;
+    QTimer indexTimer_;
 };
 
 }  // namespace chatterino
@@ -274,6 +274,7 @@ public:
     BoolSetting enableLogging = {"/logging/enabled", false};
 
     QStringSetting logPath = {"/logging/path", ""};
+    BoolSetting enableLogIndex = {"/logging/index", true};
 
     QStringSetting pathHighlightSound = {"/highlighting/highlightSoundPath",
                                          ""};
@@ -335,6 +336,9 @@ public:
 
     BoolSetting loadTwitchMessageHistoryOnConnect = {
         "/misc/twitch/loadMessageHistoryOnConnect", true};
+    BoolSetting storeMessageHistory = {"/misc/twitch/storeMessageHistory",
+                                       false};
+    BoolSetting keepColdHistory = {"/misc/twitch/keepColdHistory", false};
     IntSetting twitchMessageHistoryLimit = {
         "/misc/twitch/messageHistoryLimit",
         800,
@@ -348,6 +352,12 @@ public:
     BoolSetting attachExtensionToAnyProcess = {
         "/misc/attachExtensionToAnyProcess", false};
     BoolSetting askOnImageUpload = {"/misc/askOnImageUpload", true};
+    BoolSetting lazyLoadHiddenSplits = {"/misc/lazyLoadHiddenSplits", true};
+    // seconds until the message layouts of a hidden split are released
+    IntSetting hiddenSplitReleaseTimeout = {"/misc/hiddenSplitReleaseTimeout",
+                                            300};
+    BoolSetting threadedMessageRendering = {"/misc/threadedMessageRendering",
+                                            false};
 
     /// Debug
     BoolSetting showUnhandledIrcMessages = {"/debug/showUnhandledIrcMessages",
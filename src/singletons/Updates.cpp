@@ -251,6 +251,7 @@ void Updates::checkForUpdates()
         currentBranch();
 
     NetworkRequest(url)
+        .priority(NetworkRequestPriority::Background)
         .timeout(60000)
         .onSuccess([this](auto result) -> Outcome {
             auto object = result.parseJson();
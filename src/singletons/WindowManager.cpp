@@ -8,6 +8,7 @@
 #include <QMessageBox>
 #include <QSaveFile>
 #include <QScreen>
+#include <QtConcurrent>
 #include <boost/optional.hpp>
 #include <chrono>
 
@@ -15,6 +16,7 @@
 #include "common/Args.hpp"
 #include "common/QLogging.hpp"
 #include "debug/AssertInGuiThread.hpp"
+#include "debug/StartupTrace.hpp"
 #include "messages/MessageElement.hpp"
 #include "providers/irc/Irc2.hpp"
 #include "providers/irc/IrcChannel2.hpp"
@@ -117,6 +119,13 @@ WindowManager::WindowManager()
     QObject::connect(&this->miscUpdateTimer_, &QTimer::timeout, [this] {
         this->miscUpdate.invoke();
     });
+
+    // parse the window layout while the other singletons are initialized
+    this->windowLayoutFuture_ =
+        QtConcurrent::run([path = this->windowLayoutFilePath] {
+            StartupTraceScope trace("WindowLayout::loadFromFile");
+            return WindowLayout::loadFromFile(path);
+        });
 }
 
 MessageElementFlags WindowManager::getWordFlags()
@@ -452,6 +461,12 @@ void WindowManager::save()
 
 void WindowManager::sendAlert()
 {
+    // there are no windows when running headless
+    if (this->mainWindow_ == nullptr)
+    {
+        return;
+    }
+
     int flashDuration = 2500;
     if (getSettings()->longAlerts)
     {
@@ -560,6 +575,9 @@ IndirectChannel WindowManager::decodeChannel(const SplitDescriptor &descriptor)
 {
     assertInGuiThread();
 
+    StartupTraceScope trace("WindowManager::decodeChannel", "split",
+                            descriptor.type_ + ":" + descriptor.channelName_);
+
     auto app = getApp();
 
     if (descriptor.type_ == "twitch")
@@ -609,11 +627,15 @@ void WindowManager::incGeneration()
 
 WindowLayout WindowManager::loadWindowLayoutFromFile() const
 {
-    return WindowLayout::loadFromFile(this->windowLayoutFilePath);
+    // the file is parsed on a worker thread, see the constructor
+    StartupTraceScope trace("WindowManager::loadWindowLayoutFromFile");
+    return this->windowLayoutFuture_.result();
 }
 
 void WindowManager::applyWindowLayout(const WindowLayout &layout)
 {
+    StartupTraceScope trace("WindowManager::applyWindowLayout");
+
     // Set emote popup position
     this->emotePopupPos_ = layout.emotePopupPos_;
 
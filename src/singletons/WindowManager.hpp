@@ -7,6 +7,8 @@
 #include "pajlada/settings/settinglistener.hpp"
 #include "widgets/splits/SplitContainer.hpp"
 
+#include <QFuture>
+
 namespace chatterino {
 
 class Settings;
@@ -101,6 +103,7 @@ private:
 
     // Contains the full path to the window layout file, e.g. /home/pajlada/.local/share/Chatterino/Settings/window-layout.json
     const QString windowLayoutFilePath;
+    QFuture<WindowLayout> windowLayoutFuture_;
 
     bool initialized_ = false;
 
@@ -0,0 +1,682 @@
+#include "singletons/helper/LogIndex.hpp"
+
+#include "common/LinkParser.hpp"
+#include "common/QLogging.hpp"
+#include "messages/Message.hpp"
+#include "messages/search/SearchQuery.hpp"
+#include "singletons/helper/LogIndexSegment.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+
+namespace chatterino {
+namespace {
+    constexpr int MANIFEST_VERSION = 1;
+
+    // amount of lines after which a segment is written
+    constexpr int SEGMENT_SIZE = 100000;
+    // the newest segments are merged once there are more than MAX_SEGMENTS
+    constexpr int MAX_SEGMENTS = 8;
+    constexpr int MERGE_COUNT = 4;
+    // longer words are only indexed with their first characters
+    constexpr int MAX_WORD_LENGTH = 64;
+
+    const QString WORD_PREFIX = QStringLiteral("w:");
+    const QString AUTHOR_PREFIX = QStringLiteral("u:");
+    const QString LINK_TERM = QStringLiteral("l:");
+
+    using Postings = LogIndexSegment::Postings;
+
+    struct LogLine {
+        QTime time;
+        QString displayName;
+        QString loginName;
+        QString text;
+    };
+
+    // Parses a line written by LoggingChannel:
+    // "[HH:mm:ss] localizedName login: text"
+    // Lines of system messages don't have an author.
+    bool parseLogLine(const QString &line, LogLine &out)
+    {
+        if (line.size() < 11 || line[0] != '[' || line[9] != ']')
+        {
+            return false;
+        }
+
+        out.time = QTime::fromString(line.mid(1, 8), "HH:mm:ss");
+        auto content = line.mid(11);
+
+        auto colon = content.indexOf(": ");
+        if (colon != -1)
+        {
+            auto header = content.left(colon).split(' ');
+            if (header.size() == 2)
+            {
+                out.displayName = header[0];
+                out.loginName = header[1];
+                out.text = content.mid(colon + 2);
+                return true;
+            }
+        }
+
+        out.text = content;
+        return true;
+    }
+
+    // Twitch/Channels/<channel>/<channel>-yyyy-MM-dd.log,
+    // Twitch/Whispers/... and Twitch/Mentions/...
+    QString channelFromPath(const QString &path)
+    {
+        auto parts = path.split('/');
+        if (parts.size() >= 3 && parts[1] == "Channels")
+        {
+            return parts[2];
+        }
+        if (parts.size() >= 2 && parts[1] == "Whispers")
+        {
+            return "/whispers";
+        }
+        if (parts.size() >= 2 && parts[1] == "Mentions")
+        {
+            return "/mentions";
+        }
+        return QString();
+    }
+
+    QDate dayFromPath(const QString &path)
+    {
+        return QDate::fromString(QFileInfo(path).completeBaseName().right(10),
+                                 Qt::ISODate);
+    }
+
+    template <typename F>
+    void forEachWord(const QString &text, F &&callback)
+    {
+        int start = -1;
+        for (int i = 0; i <= text.size(); i++)
+        {
+            bool isWordChar = i < text.size() && (text[i].isLetterOrNumber() ||
+                                                  text[i] == QChar('_'));
+            if (isWordChar)
+            {
+                if (start == -1)
+                {
+                    start = i;
+                }
+            }
+            else if (start != -1)
+            {
+                callback(text.mid(start, std::min(i - start, MAX_WORD_LENGTH))
+                             .toLower());
+                start = -1;
+            }
+        }
+    }
+
+    QStringList termsForLine(const LogLine &line)
+    {
+        QStringList terms;
+        forEachWord(line.text, [&terms](QString &&word) {
+            terms.push_back(WORD_PREFIX + word);
+        });
+
+        if (!line.loginName.isEmpty())
+        {
+            terms.push_back(AUTHOR_PREFIX + line.loginName.toLower());
+            if (line.displayName.compare(line.loginName, Qt::CaseInsensitive))
+            {
+                terms.push_back(AUTHOR_PREFIX + line.displayName.toLower());
+            }
+        }
+
+        for (const auto &word : line.text.split(' ', QString::SkipEmptyParts))
+        {
+            if (word.contains('.') && LinkParser(word).hasMatch())
+            {
+                terms.push_back(LINK_TERM);
+                break;
+            }
+        }
+
+        return terms;
+    }
+
+    // values of comma separated tags like "from:a,b", lowercase
+    QStringList tagValues(const QStringList &entries)
+    {
+        QStringList values;
+        for (const auto &entry : entries)
+        {
+            for (auto value : entry.split(',', QString::SkipEmptyParts))
+            {
+                if (value.startsWith('#'))
+                {
+                    value.remove(0, 1);
+                }
+                values.push_back(value.toLower());
+            }
+        }
+        return values;
+    }
+
+    Postings unite(const Postings &a, const QVector<quint32> &b)
+    {
+        Postings result;
+        result.reserve(a.size() + size_t(b.size()));
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                       std::back_inserter(result));
+        return result;
+    }
+
+    Postings intersect(const Postings &a, const Postings &b)
+    {
+        Postings result;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                              std::back_inserter(result));
+        return result;
+    }
+
+    struct Candidate {
+        QDate day;
+        QString path;
+        QString channelName;
+        qint64 offset;
+    };
+}  // namespace
+
+struct LogIndex::Data {
+    QString logDirectory;
+    QString indexDirectory;
+
+    std::atomic<bool> indexing{false};
+    std::atomic<bool> stopped{false};
+
+    // guards everything below
+    std::mutex mutex;
+    bool loaded = false;
+    int nextSegmentId = 0;
+    QStringList segmentNames;
+    std::vector<std::shared_ptr<const LogIndexSegment>> segments;
+    // how many bytes of every log file have been indexed
+    QHash<QString, qint64> offsets;
+
+    QString segmentPath(const QString &name) const
+    {
+        return this->indexDirectory + "/" + name;
+    }
+
+    // mutex must be held
+    void load()
+    {
+        if (this->loaded)
+        {
+            return;
+        }
+        this->loaded = true;
+
+        QFile file(this->indexDirectory + "/manifest.json");
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return;
+        }
+
+        auto manifest = QJsonDocument::fromJson(file.readAll()).object();
+        if (manifest.value("version").toInt() != MANIFEST_VERSION)
+        {
+            return;
+        }
+
+        for (const auto &value : manifest.value("segments").toArray())
+        {
+            auto name = value.toString();
+            auto segment = LogIndexSegment::read(this->segmentPath(name));
+            if (!segment)
+            {
+                // the offsets can't be trusted anymore, start over
+                qCWarning(chatterinoHelper)
+                    << "Log index segment" << name
+                    << "is damaged, rebuilding the index";
+                this->segmentNames.clear();
+                this->segments.clear();
+                return;
+            }
+
+            this->segmentNames.push_back(name);
+            this->segments.push_back(std::move(segment));
+        }
+
+        auto offsets = manifest.value("files").toObject();
+        for (auto it = offsets.begin(); it != offsets.end(); ++it)
+        {
+            this->offsets.insert(it.key(), qint64(it.value().toDouble()));
+        }
+        this->nextSegmentId = manifest.value("nextSegment").toInt();
+    }
+
+    // mutex must be held
+    bool saveManifest()
+    {
+        QJsonObject offsets;
+        for (auto it = this->offsets.begin(); it != this->offsets.end(); ++it)
+        {
+            offsets.insert(it.key(), double(it.value()));
+        }
+
+        QJsonObject manifest{
+            {"version", MANIFEST_VERSION},
+            {"nextSegment", this->nextSegmentId},
+            {"segments", QJsonArray::fromStringList(this->segmentNames)},
+            {"files", offsets},
+        };
+
+        QSaveFile file(this->indexDirectory + "/manifest.json");
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            return false;
+        }
+        file.write(QJsonDocument(manifest).toJson(QJsonDocument::Compact));
+        return file.commit();
+    }
+
+    // Writes the segment and marks the lines it covers as indexed
+    bool commit(LogIndexSegmentBuilder &builder,
+                QHash<QString, qint64> &pending)
+    {
+        std::shared_ptr<LogIndexSegment> segment;
+        if (builder.docCount() > 0)
+        {
+            segment = builder.take();
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (segment)
+        {
+            auto name = QString("%1.seg").arg(this->nextSegmentId);
+            if (!segment->write(this->segmentPath(name)))
+            {
+                qCWarning(chatterinoHelper)
+                    << "Unable to write log index segment" << name;
+                return false;
+            }
+
+            this->nextSegmentId++;
+            this->segmentNames.push_back(name);
+            this->segments.push_back(std::move(segment));
+        }
+
+        for (auto it = pending.begin(); it != pending.end(); ++it)
+        {
+            this->offsets.insert(it.key(), it.value());
+        }
+        pending.clear();
+
+        return this->saveManifest();
+    }
+
+    // Merges the newest segments until there are at most MAX_SEGMENTS.
+    // Older segments are bigger and stay untouched.
+    void merge()
+    {
+        while (!this->stopped)
+        {
+            std::vector<std::shared_ptr<const LogIndexSegment>> parts;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (int(this->segments.size()) <= MAX_SEGMENTS)
+                {
+                    return;
+                }
+                parts.assign(this->segments.end() - MERGE_COUNT,
+                             this->segments.end());
+            }
+
+            LogIndexSegmentBuilder builder;
+            for (const auto &part : parts)
+            {
+                builder.append(*part);
+            }
+            auto merged = builder.take();
+
+            QStringList removed;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+
+                auto name = QString("%1.seg").arg(this->nextSegmentId);
+                if (!merged->write(this->segmentPath(name)))
+                {
+                    qCWarning(chatterinoHelper)
+                        << "Unable to write log index segment" << name;
+                    return;
+                }
+                this->nextSegmentId++;
+
+                auto first = int(this->segments.size()) - MERGE_COUNT;
+                removed = this->segmentNames.mid(first);
+
+                this->segments.resize(size_t(first));
+                this->segments.push_back(std::move(merged));
+                this->segmentNames.erase(this->segmentNames.begin() + first,
+                                         this->segmentNames.end());
+                this->segmentNames.push_back(name);
+
+                if (!this->saveManifest())
+                {
+                    return;
+                }
+            }
+
+            for (const auto &name : removed)
+            {
+                QFile::remove(this->segmentPath(name));
+            }
+        }
+    }
+
+    void index()
+    {
+        QHash<QString, qint64> offsets;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->load();
+            offsets = this->offsets;
+        }
+
+        if (!QDir(this->logDirectory + "/Twitch").exists())
+        {
+            // nothing has been logged yet
+            return;
+        }
+
+        if (!QDir().mkpath(this->indexDirectory))
+        {
+            qCWarning(chatterinoHelper) << "Unable to create log index path";
+            return;
+        }
+
+        QDir base(this->logDirectory);
+        LogIndexSegmentBuilder builder;
+        QHash<QString, qint64> pending;
+
+        QDirIterator it(this->logDirectory + "/Twitch", QStringList{"*.log"},
+                        QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext() && !this->stopped)
+        {
+            auto path = base.relativeFilePath(it.next());
+            auto offset = offsets.value(path, 0);
+
+            QFile file(it.filePath());
+            if (file.size() <= offset || !file.open(QIODevice::ReadOnly) ||
+                !file.seek(offset))
+            {
+                continue;
+            }
+
+            auto fileId = builder.fileId(path);
+            while (!file.atEnd() && !this->stopped)
+            {
+                auto lineOffset = file.pos();
+                auto bytes = file.readLine();
+                if (!bytes.endsWith('\n'))
+                {
+                    // the line is still being written
+                    break;
+                }
+                pending[path] = file.pos();
+
+                LogLine line;
+                if (bytes.startsWith('#') ||
+                    !parseLogLine(QString::fromUtf8(bytes).trimmed(), line))
+                {
+                    continue;
+                }
+
+                builder.addDoc(fileId, lineOffset, termsForLine(line));
+
+                if (builder.docCount() >= SEGMENT_SIZE)
+                {
+                    if (!this->commit(builder, pending))
+                    {
+                        return;
+                    }
+                    fileId = builder.fileId(path);
+                }
+            }
+        }
+
+        if (!this->commit(builder, pending))
+        {
+            return;
+        }
+
+        this->merge();
+    }
+
+    std::vector<LogIndex::Result> search(const QString &input, int maxResults)
+    {
+        auto query = SearchQuery::parse(input);
+        auto predicates = query.predicates();
+
+        QStringList words;
+        forEachWord(query.text, [&words](QString &&word) {
+            words.push_back(word);
+        });
+        auto authors = tagValues(query.authors);
+        auto channels = tagValues(query.channels);
+
+        std::vector<std::shared_ptr<const LogIndexSegment>> segments;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->load();
+            segments = this->segments;
+        }
+
+        std::vector<Candidate> candidates;
+        for (const auto &segment : segments)
+        {
+            Postings docs;
+            bool restricted = false;
+            auto narrow = [&](Postings &&next) {
+                docs = restricted ? intersect(docs, next) : std::move(next);
+                restricted = true;
+            };
+
+            for (const auto &word : words)
+            {
+                narrow(segment->withPrefix(WORD_PREFIX + word));
+            }
+            if (!authors.empty())
+            {
+                Postings byAuthor;
+                for (const auto &author : authors)
+                {
+                    byAuthor =
+                        unite(byAuthor,
+                              segment->postings.value(AUTHOR_PREFIX + author));
+                }
+                narrow(std::move(byAuthor));
+            }
+            if (query.hasLink)
+            {
+                narrow(unite({}, segment->postings.value(LINK_TERM)));
+            }
+            if (!restricted)
+            {
+                docs.resize(size_t(segment->docFiles.size()));
+                std::iota(docs.begin(), docs.end(), 0);
+            }
+
+            // the file table decides on the channel and day
+            std::vector<Candidate> files;
+            for (const auto &path : segment->files)
+            {
+                files.push_back(
+                    {dayFromPath(path), path, channelFromPath(path), -1});
+            }
+
+            for (auto doc : docs)
+            {
+                const auto &file = files[segment->docFiles[int(doc)]];
+                bool wrongChannel =
+                    !channels.empty() &&
+                    !channels.contains(file.channelName, Qt::CaseInsensitive);
+                bool wrongDay = query.day.isValid() && query.day != file.day;
+                if (wrongChannel || wrongDay)
+                {
+                    continue;
+                }
+
+                auto candidate = file;
+                candidate.offset = segment->docOffsets[int(doc)];
+                candidates.push_back(std::move(candidate));
+            }
+        }
+
+        // newest day first, newest line of a file first
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate &a, const Candidate &b) {
+                      if (a.day != b.day)
+                          return a.day > b.day;
+                      if (a.path != b.path)
+                          return a.path < b.path;
+                      return a.offset > b.offset;
+                  });
+
+        std::vector<LogIndex::Result> results;
+        QFile file;
+        QDate lastDay;
+
+        for (const auto &candidate : candidates)
+        {
+            if (this->stopped)
+            {
+                break;
+            }
+            // lines of the same day aren't ordered between files, the whole
+            // day is checked before cutting off the results
+            if (int(results.size()) >= maxResults && candidate.day != lastDay)
+            {
+                break;
+            }
+
+            auto path = this->logDirectory + "/" + candidate.path;
+            if (file.fileName() != path)
+            {
+                file.close();
+                file.setFileName(path);
+                file.open(QIODevice::ReadOnly);
+            }
+            if (!file.isOpen() || !file.seek(candidate.offset))
+            {
+                continue;
+            }
+
+            LogLine line;
+            if (!parseLogLine(QString::fromUtf8(file.readLine()).trimmed(),
+                              line))
+            {
+                continue;
+            }
+
+            Message message;
+            message.messageText = line.text;
+            message.loginName = line.loginName;
+            message.displayName = line.displayName;
+            message.channelName = candidate.channelName;
+            message.searchText =
+                line.loginName.isEmpty()
+                    ? line.text
+                    : line.displayName + " " + line.loginName + ": " +
+                          line.text;
+            message.lowercaseSearchText = message.searchText.toLower();
+
+            bool accept = true;
+            for (const auto &predicate : predicates)
+            {
+                if (!predicate->appliesTo(message))
+                {
+                    accept = false;
+                    break;
+                }
+            }
+            if (!accept)
+            {
+                continue;
+            }
+
+            lastDay = candidate.day;
+            results.push_back({candidate.channelName,
+                               QDateTime(candidate.day, line.time),
+                               line.loginName, line.displayName, line.text});
+        }
+
+        std::stable_sort(results.begin(), results.end(),
+                         [](const auto &a, const auto &b) {
+                             return a.time > b.time;
+                         });
+        if (int(results.size()) > maxResults)
+        {
+            results.resize(size_t(maxResults));
+        }
+
+        return results;
+    }
+};
+
+LogIndex::LogIndex(const QString &logDirectory)
+    : data_(std::make_shared<Data>())
+{
+    this->data_->logDirectory = logDirectory;
+    this->data_->indexDirectory = logDirectory + "/.index";
+}
+
+LogIndex::~LogIndex()
+{
+    // running workers keep the data alive and stop at the next line
+    this->data_->stopped = true;
+}
+
+void LogIndex::update()
+{
+    if (this->data_->indexing.exchange(true))
+    {
+        return;
+    }
+
+    QtConcurrent::run([data = this->data_] {
+        data->index();
+        data->indexing = false;
+    });
+}
+
+void LogIndex::search(const QString &input, int maxResults,
+                      ResultCallback onResults) const
+{
+    QtConcurrent::run([data = this->data_, input, maxResults,
+                       onResults = std::move(onResults)] {
+        auto results = data->search(input, maxResults);
+
+        postToThread([onResults, results = std::move(results)]() mutable {
+            onResults(std::move(results));
+        });
+    });
+}
+
+}  // namespace chatterino
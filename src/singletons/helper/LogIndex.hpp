@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QDateTime>
+#include <QString>
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief A persistent full text index over the chat logs.
+ *
+ * The index is stored next to the logs in ".index". It consists of immutable
+ * segments which map lowercase words and authors to the lines that contain
+ * them, and a manifest which remembers how far every log file has been
+ * indexed. Indexing only reads the lines which have been appended since the
+ * last pass and can therefore be resumed after a restart.
+ *
+ * Lookups use the index to find candidate lines and only read those from the
+ * log files. Words are matched by prefix, the candidates are then checked
+ * against the full query.
+ */
+class LogIndex : boost::noncopyable
+{
+public:
+    struct Result {
+        QString channelName;
+        QDateTime time;
+        QString loginName;
+        QString displayName;
+        QString text;
+    };
+
+    using ResultCallback = std::function<void(std::vector<Result> &&)>;
+
+    explicit LogIndex(const QString &logDirectory);
+    ~LogIndex();
+
+    /**
+     * @brief Indexes the lines that have been logged since the last pass.
+     *
+     * The pass runs on a worker thread. Does nothing if a pass is running.
+     */
+    void update();
+
+    /**
+     * @brief Searches the indexed logs on a worker thread.
+     *
+     * Supports the same syntax as the search popup, see SearchQuery.
+     *
+     * @param input         the search query
+     * @param maxResults    the maximum amount of results, newest first
+     * @param onResults     called on the GUI thread with the results
+     */
+    void search(const QString &input, int maxResults,
+                ResultCallback onResults) const;
+
+private:
+    struct Data;
+
+    std::shared_ptr<Data> data_;
+};
+
+}  // namespace chatterino
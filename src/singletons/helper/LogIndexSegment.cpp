@@ -0,0 +1,143 @@
+#include "singletons/helper/LogIndexSegment.hpp"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <iterator>
+
+namespace chatterino {
+namespace {
+    constexpr quint32 SEGMENT_MAGIC = 0x43484c49;  // "CHLI"
+    constexpr quint32 SEGMENT_VERSION = 1;
+}  // namespace
+
+bool LogIndexSegment::write(const QString &path) const
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << SEGMENT_MAGIC << SEGMENT_VERSION << this->files << this->docFiles
+           << this->docOffsets << this->postings;
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+std::shared_ptr<LogIndexSegment> LogIndexSegment::read(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return nullptr;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != SEGMENT_MAGIC || version != SEGMENT_VERSION)
+    {
+        return nullptr;
+    }
+
+    auto segment = std::make_shared<LogIndexSegment>();
+    stream >> segment->files >> segment->docFiles >> segment->docOffsets >>
+        segment->postings;
+
+    if (stream.status() != QDataStream::Ok ||
+        segment->docFiles.size() != segment->docOffsets.size())
+    {
+        return nullptr;
+    }
+    return segment;
+}
+
+LogIndexSegment::Postings LogIndexSegment::withPrefix(
+    const QString &prefix) const
+{
+    Postings result;
+    for (auto it = this->postings.lowerBound(prefix);
+         it != this->postings.end() && it.key().startsWith(prefix); ++it)
+    {
+        Postings merged;
+        merged.reserve(result.size() + size_t(it.value().size()));
+        std::set_union(result.begin(), result.end(), it.value().begin(),
+                       it.value().end(), std::back_inserter(merged));
+        result = std::move(merged);
+    }
+    return result;
+}
+
+int LogIndexSegmentBuilder::docCount() const
+{
+    return this->segment_->docFiles.size();
+}
+
+quint32 LogIndexSegmentBuilder::fileId(const QString &path)
+{
+    auto it = this->fileIds_.find(path);
+    if (it == this->fileIds_.end())
+    {
+        it = this->fileIds_.insert(path, this->segment_->files.size());
+        this->segment_->files.push_back(path);
+    }
+    return it.value();
+}
+
+void LogIndexSegmentBuilder::addDoc(quint32 fileId, qint64 offset,
+                                    const QStringList &terms)
+{
+    auto doc = quint32(this->segment_->docFiles.size());
+    this->segment_->docFiles.push_back(fileId);
+    this->segment_->docOffsets.push_back(offset);
+
+    for (const auto &term : terms)
+    {
+        auto &postings = this->segment_->postings[term];
+        // a word can appear multiple times in one line
+        if (postings.isEmpty() || postings.last() != doc)
+        {
+            postings.push_back(doc);
+        }
+    }
+}
+
+void LogIndexSegmentBuilder::append(const LogIndexSegment &other)
+{
+    auto base = quint32(this->segment_->docFiles.size());
+
+    for (int i = 0; i < other.docFiles.size(); i++)
+    {
+        this->segment_->docFiles.push_back(
+            this->fileId(other.files[int(other.docFiles[i])]));
+        this->segment_->docOffsets.push_back(other.docOffsets[i]);
+    }
+
+    for (auto it = other.postings.begin(); it != other.postings.end(); ++it)
+    {
+        auto &postings = this->segment_->postings[it.key()];
+        postings.reserve(postings.size() + it.value().size());
+        for (auto doc : it.value())
+        {
+            postings.push_back(base + doc);
+        }
+    }
+}
+
+std::shared_ptr<LogIndexSegment> LogIndexSegmentBuilder::take()
+{
+    auto segment = std::move(this->segment_);
+    this->segment_ = std::make_shared<LogIndexSegment>();
+    this->fileIds_.clear();
+    return segment;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief One immutable part of the LogIndex.
+ *
+ * Doc ids are the indices into docFiles and docOffsets, a doc is one line of
+ * the log file docFiles refers to. Every posting list is sorted.
+ */
+struct LogIndexSegment {
+    using Postings = std::vector<quint32>;
+
+    QVector<QString> files;
+    QVector<quint32> docFiles;
+    QVector<qint64> docOffsets;
+    QMap<QString, QVector<quint32>> postings;
+
+    bool write(const QString &path) const;
+
+    /**
+     * @brief Reads a segment written by write().
+     *
+     * @return nullptr if the file is missing or damaged
+     */
+    static std::shared_ptr<LogIndexSegment> read(const QString &path);
+
+    /**
+     * @brief Finds the docs containing a term which starts with prefix.
+     *
+     * @param prefix the start of the term
+     * @return the sorted doc ids
+     */
+    Postings withPrefix(const QString &prefix) const;
+};
+
+/**
+ * @brief Builds a LogIndexSegment doc by doc, or by merging other segments.
+ */
+class LogIndexSegmentBuilder
+{
+public:
+    int docCount() const;
+
+    quint32 fileId(const QString &path);
+
+    /**
+     * @brief Adds a line of a log file.
+     *
+     * @param fileId    the id of the log file, see fileId()
+     * @param offset    where the line starts in the log file
+     * @param terms     the terms the line can be found by
+     */
+    void addDoc(quint32 fileId, qint64 offset, const QStringList &terms);
+
+    /**
+     * @brief Appends all docs of "other".
+     *
+     * Their ids are shifted behind the ones that are already in this
+     * builder, so appending the segments from oldest to newest keeps every
+     * posting list sorted.
+     */
+    void append(const LogIndexSegment &other);
+
+    /// Returns the built segment and starts a new one
+    std::shared_ptr<LogIndexSegment> take();
+
+private:
+    std::shared_ptr<LogIndexSegment> segment_ =
+        std::make_shared<LogIndexSegment>();
+    QHash<QString, quint32> fileIds_;
+};
+
+}  // namespace chatterino
@@ -1,7 +1,100 @@
 #include "DebugCount.hpp"
 
+#include <QMap>
+
+#include <cstdlib>
+
+#include <deque>
+#include <mutex>
+
 namespace chatterino {
+namespace {
+    struct Registry {
+        std::mutex mutex;
+        // deque never moves its elements, handles stay valid
+        std::deque<DebugCount::Counter> counters;
+        QMap<QString, DebugCount::Counter *> byName;
+    };
+
+    Registry &registry()
+    {
+        static Registry registry;
+        return registry;
+    }
+}  // namespace
+
+DebugCount::Counter::Counter(const QString &name, Unit unit)
+    : name_(name)
+    , unit_(unit)
+{
+}
+
+DebugCount::Counter &DebugCount::counter(const QString &name, Unit unit)
+{
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    auto it = r.byName.find(name);
+    if (it != r.byName.end())
+    {
+        return **it;
+    }
+
+    r.counters.emplace_back(name, unit);
+    r.byName.insert(name, &r.counters.back());
+    return r.counters.back();
+}
+
+QString DebugCount::getDebugText()
+{
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    QString text;
+    for (auto it = r.byName.begin(); it != r.byName.end(); it++)
+    {
+        auto *counter = it.value();
+        text += it.key() + ": ";
+        if (counter->unit() == Unit::Bytes)
+        {
+            text += formatBytes(counter->value());
+        }
+        else
+        {
+            text += QString::number(counter->value());
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+QJsonObject DebugCount::toJson()
+{
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    QJsonObject counts;
+    QJsonObject bytes;
+    for (auto *counter : r.byName)
+    {
+        auto &target = counter->unit() == Unit::Bytes ? bytes : counts;
+        target.insert(counter->name(), double(counter->value()));
+    }
+
+    return QJsonObject{{"counts", counts}, {"bytes", bytes}};
+}
 
-UniqueAccess<QMap<QString, int64_t>> DebugCount::counts_;
+QString DebugCount::formatBytes(int64_t bytes)
+{
+    if (std::abs(bytes) < 1024)
+    {
+        return QString("%1 B").arg(bytes);
+    }
+    if (std::abs(bytes) < 1024 * 1024)
+    {
+        return QString("%1 KiB").arg(double(bytes) / 1024, 0, 'f', 1);
+    }
+    return QString("%1 MiB").arg(double(bytes) / (1024 * 1024), 0, 'f', 1);
+}
 
 }  // namespace chatterino
@@ -1,67 +1,75 @@
 #pragma once
 
-#include <common/UniqueAccess.hpp>
-
-#include <mutex>
-#include <typeinfo>
-
-#include <QMap>
+#include <QJsonObject>
 #include <QString>
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <cstdint>
 
 namespace chatterino {
 
+/// Registry of the debug counters shown in the DebugPopup.
+///
+/// Counters are registered once and kept in a static handle, after that
+/// changing them is a single atomic operation:
+///
+///     static auto &messageCount = DebugCount::counter("messages");
+///     messageCount.increase();
 class DebugCount
 {
 public:
-    static void increase(const QString &name)
+    enum class Unit { Count, Bytes };
+
+    class Counter : boost::noncopyable
     {
-        auto counts = counts_.access();
+    public:
+        Counter(const QString &name, Unit unit);
 
-        auto it = counts->find(name);
-        if (it == counts->end())
+        void increase(int64_t amount = 1)
         {
-            counts->insert(name, 1);
+            this->value_.fetch_add(amount, std::memory_order_relaxed);
         }
-        else
+
+        void decrease(int64_t amount = 1)
         {
-            reinterpret_cast<int64_t &>(it.value())++;
+            this->value_.fetch_sub(amount, std::memory_order_relaxed);
         }
-    }
-
-    static void decrease(const QString &name)
-    {
-        auto counts = counts_.access();
 
-        auto it = counts->find(name);
-        if (it == counts->end())
+        void set(int64_t value)
         {
-            counts->insert(name, -1);
+            this->value_.store(value, std::memory_order_relaxed);
         }
-        else
+
+        int64_t value() const
         {
-            reinterpret_cast<int64_t &>(it.value())--;
+            return this->value_.load(std::memory_order_relaxed);
         }
-    }
 
-    static QString getDebugText()
-    {
-        auto counts = counts_.access();
+        const QString &name() const
+        {
+            return this->name_;
+        }
 
-        QString text;
-        for (auto it = counts->begin(); it != counts->end(); it++)
+        Unit unit() const
         {
-            text += it.key() + ": " + QString::number(it.value()) + "\n";
+            return this->unit_;
         }
-        return text;
-    }
 
-    QString toString()
-    {
-        return "";
-    }
+    private:
+        const QString name_;
+        const Unit unit_;
+        std::atomic<int64_t> value_{0};
+    };
+
+    /// Returns the counter with the given name and registers it if it doesn't
+    /// exist yet. The returned reference is valid until the program exits.
+    static Counter &counter(const QString &name, Unit unit = Unit::Count);
+
+    static QString getDebugText();
+    static QJsonObject toJson();
 
-private:
-    static UniqueAccess<QMap<QString, int64_t>> counts_;
+    static QString formatBytes(int64_t bytes);
 };
 
 }  // namespace chatterino
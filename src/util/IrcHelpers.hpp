@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QByteArray>
 #include <QString>
 
 namespace chatterino {
@@ -58,6 +59,54 @@ inline QString parseTagString(const QString &input)
     return output;
 }
 
+// Marks a raw irc line like the ones from the recent-messages API, so the
+// message gets the time it was received at and doesn't trigger highlights
+inline QByteArray historicalLine(const QByteArray &line, qint64 receivedAt)
+{
+    auto tags = "historical=1;rm-received-ts=" + QByteArray::number(receivedAt);
+
+    if (line.startsWith('@'))
+    {
+        return '@' + tags + ';' + line.mid(1);
+    }
+    return '@' + tags + ' ' + line;
+}
+
+// Reads a tag from a raw irc line without parsing the whole line. The value
+// isn't unescaped, which is fine for ids
+inline QByteArray rawTagValue(const QByteArray &line, const QByteArray &key)
+{
+    if (!line.startsWith('@'))
+    {
+        return {};
+    }
+
+    auto tagsEnd = line.indexOf(' ');
+    if (tagsEnd == -1)
+    {
+        tagsEnd = line.size();
+    }
+
+    int start = 1;
+    while (start < tagsEnd)
+    {
+        auto end = line.indexOf(';', start);
+        if (end == -1 || end > tagsEnd)
+        {
+            end = tagsEnd;
+        }
+
+        if (end - start > key.size() && line[start + key.size()] == '=' &&
+            line.mid(start, key.size()) == key)
+        {
+            auto valueStart = start + key.size() + 1;
+            return line.mid(valueStart, end - valueStart);
+        }
+        start = end + 1;
+    }
+    return {};
+}
+
 inline QTime calculateMessageTimestamp(const Communi::IrcMessage *message)
 {
     // Check if message is from recent-messages API
@@ -0,0 +1,40 @@
+#include "util/RateLimit.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+RateLimit::RateLimit(size_t maxCount, Clock::duration window,
+                     Clock::duration minInterval)
+    : maxCount_(maxCount)
+    , window_(window)
+    , minInterval_(minInterval)
+{
+}
+
+RateLimit::Clock::duration RateLimit::delay(Clock::time_point now)
+{
+    while (!this->sent_.empty() && this->sent_.front() + this->window_ <= now)
+    {
+        this->sent_.pop_front();
+    }
+
+    Clock::duration delay{0};
+    if (this->sent_.size() >= this->maxCount_)
+    {
+        delay = this->sent_.front() + this->window_ - now;
+    }
+    if (!this->sent_.empty())
+    {
+        delay = std::max(delay, this->sent_.back() + this->minInterval_ - now);
+    }
+
+    return std::max(delay, Clock::duration{0});
+}
+
+void RateLimit::record(Clock::time_point now)
+{
+    this->sent_.push_back(now);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+
+namespace chatterino {
+
+// Allows at most maxCount events per window with at least minInterval
+// between two events
+class RateLimit
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RateLimit(size_t maxCount, Clock::duration window,
+              Clock::duration minInterval = {});
+
+    // How long the next event has to wait, zero if it may happen now
+    Clock::duration delay(Clock::time_point now);
+    void record(Clock::time_point now);
+
+private:
+    const size_t maxCount_;
+    const Clock::duration window_;
+    const Clock::duration minInterval_;
+    std::deque<Clock::time_point> sent_;
+};
+
+}  // namespace chatterino
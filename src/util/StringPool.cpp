@@ -0,0 +1,82 @@
+#include "util/StringPool.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <QSet>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+namespace chatterino {
+namespace {
+    // the pool is split up so threads rarely wait for each other
+    constexpr int SHARD_COUNT = 16;
+    constexpr int MIN_SWEEP_SIZE = 1024;
+
+    auto &internedStrings = DebugCount::counter("interned strings");
+    // only ever goes up, how many of the copies are still alive is unknown
+    auto &totalSharedBytes = DebugCount::counter(
+        "bytes shared by interning (total)", DebugCount::Unit::Bytes);
+
+    struct Shard {
+        std::mutex mutex;
+        QSet<QString> strings;
+        int sweepAt = MIN_SWEEP_SIZE;
+
+        // Drops the strings that are only referenced by the pool
+        void sweep()
+        {
+            auto before = this->strings.size();
+            for (auto it = this->strings.begin(); it != this->strings.end();)
+            {
+                if (it->isDetached())
+                {
+                    it = this->strings.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            internedStrings.decrease(before - this->strings.size());
+            this->sweepAt = std::max(MIN_SWEEP_SIZE, this->strings.size() * 2);
+        }
+    };
+
+    std::array<Shard, SHARD_COUNT> &shards()
+    {
+        static std::array<Shard, SHARD_COUNT> shards;
+        return shards;
+    }
+}  // namespace
+
+QString StringPool::intern(const QString &string)
+{
+    if (string.isEmpty())
+    {
+        return string;
+    }
+
+    auto &shard = shards()[qHash(string) % SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.strings.constFind(string);
+    if (it != shard.strings.constEnd())
+    {
+        totalSharedBytes.increase(string.size() * int64_t(sizeof(QChar)));
+        return *it;
+    }
+
+    if (shard.strings.size() >= shard.sweepAt)
+    {
+        shard.sweep();
+    }
+
+    shard.strings.insert(string);
+    internedStrings.increase();
+    return string;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QString>
+
+namespace chatterino {
+
+/// Makes equal strings share one copy of their data. Used for the strings
+/// that repeat a lot, like user names and badge names, which would otherwise
+/// be kept once per message.
+///
+///     this->message().loginName = StringPool::intern(this->userName);
+///
+/// Strings that aren't used anywhere else anymore are dropped from the pool
+/// every time it doubled in size.
+/// This class is thread safe.
+class StringPool
+{
+public:
+    /// Returns a string equal to the given one, sharing its data with every
+    /// other string that was interned with the same content
+    static QString intern(const QString &string);
+};
+
+}  // namespace chatterino
@@ -19,6 +19,9 @@
 #endif
 
 namespace chatterino {
+namespace {
+    auto &attachedWindowCount = DebugCount::counter("attached window");
+}  // namespace
 
 #ifdef USEWINSDK
 static thread_local std::vector<HWND> taskbarHwnds;
@@ -54,7 +57,7 @@ AttachedWindow::AttachedWindow(void *_target, int _yOffset)
     split->setSizePolicy(QSizePolicy::Maximum, QSizePolicy::MinimumExpanding);
     layout->addWidget(split);
 
-    DebugCount::increase("attached window");
+    attachedWindowCount.increase();
 }
 
 AttachedWindow::~AttachedWindow()
@@ -68,7 +71,7 @@ AttachedWindow::~AttachedWindow()
         }
     }
 
-    DebugCount::decrease("attached window");
+    attachedWindowCount.decrease();
 }
 
 AttachedWindow *AttachedWindow::get(void *target, const GetArgs &args)
@@ -43,6 +43,9 @@
 #include "widgets/helper/TitlebarButton.hpp"
 
 namespace chatterino {
+namespace {
+    auto &windowCount = DebugCount::counter("BaseWindow");
+}  // namespace
 
 BaseWindow::BaseWindow(FlagsEnum<Flags> _flags, QWidget *parent)
     : BaseWidget(parent, (_flags.has(Dialog) ? Qt::Dialog : Qt::Window) |
@@ -97,12 +100,12 @@ BaseWindow::BaseWindow(FlagsEnum<Flags> _flags, QWidget *parent)
 #endif
 
     this->themeChangedEvent();
-    DebugCount::increase("BaseWindow");
+    windowCount.increase();
 }
 
 BaseWindow::~BaseWindow()
 {
-    DebugCount::decrease("BaseWindow");
+    windowCount.decrease();
 }
 
 void BaseWindow::setInitialBounds(const QRect &bounds)
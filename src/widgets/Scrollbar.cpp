@@ -36,6 +36,13 @@ void Scrollbar::addHighlight(ScrollbarHighlight highlight)
     this->highlights_.pushBack(highlight, deleted);
 }
 
+void Scrollbar::addHighlights(
+    const std::vector<ScrollbarHighlight> &highlights)
+{
+    std::vector<ScrollbarHighlight> deleted;
+    this->highlights_.pushBack(highlights, deleted);
+}
+
 void Scrollbar::addHighlightsAtStart(
     const std::vector<ScrollbarHighlight> &_highlights)
 {
@@ -21,6 +21,7 @@ public:
     Scrollbar(ChannelView *parent = nullptr);
 
     void addHighlight(ScrollbarHighlight highlight);
+    void addHighlights(const std::vector<ScrollbarHighlight> &highlights);
     void addHighlightsAtStart(
         const std::vector<ScrollbarHighlight> &highlights_);
     void replaceHighlight(size_t index, ScrollbarHighlight replacement);
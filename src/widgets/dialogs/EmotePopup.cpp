@@ -14,11 +14,21 @@
 #include "widgets/helper/ChannelView.hpp"
 
 #include <QHBoxLayout>
+#include <QLineEdit>
 #include <QShortcut>
 #include <QTabWidget>
 
+#include <algorithm>
+
 namespace chatterino {
 namespace {
+    // Every row of emotes is its own message. ChannelView only lays out the
+    // messages that are visible, so only the images of those are loaded.
+    constexpr size_t EMOTES_PER_ROW = 8;
+
+    // insert text and emote
+    using EmoteList = std::vector<std::pair<QString, EmotePtr>>;
+
     auto makeTitleMessage(const QString &title)
     {
         MessageBuilder builder;
@@ -26,42 +36,87 @@ namespace {
         builder->flags.set(MessageFlag::Centered);
         return builder.release();
     }
-    auto makeEmoteMessage(const EmoteMap &map)
+    auto makeSystemMessage(const QString &text)
     {
         MessageBuilder builder;
         builder->flags.set(MessageFlag::Centered);
         builder->flags.set(MessageFlag::DisableCompactEmotes);
+        builder.emplace<TextElement>(text, MessageElementFlag::Text,
+                                     MessageColor::System);
+        return builder.release();
+    }
+    std::vector<MessagePtr> makeEmoteMessages(const EmoteList &emotes)
+    {
+        std::vector<MessagePtr> messages;
 
-        if (!map.empty())
+        for (size_t i = 0; i < emotes.size(); i += EMOTES_PER_ROW)
         {
-            std::vector<std::pair<EmoteName, EmotePtr>> vec(map.begin(),
-                                                            map.end());
-            std::sort(vec.begin(), vec.end(),
-                      [](const std::pair<EmoteName, EmotePtr> &l,
-                         const std::pair<EmoteName, EmotePtr> &r) {
-                          return CompletionModel::compareStrings(
-                              l.first.string, r.first.string);
-                      });
-            for (const auto &emote : vec)
+            MessageBuilder builder;
+            builder->flags.set(MessageFlag::Centered);
+            builder->flags.set(MessageFlag::DisableCompactEmotes);
+
+            auto end = std::min(i + EMOTES_PER_ROW, emotes.size());
+            for (auto j = i; j < end; j++)
             {
                 builder
-                    .emplace<EmoteElement>(emote.second,
+                    .emplace<EmoteElement>(emotes[j].second,
                                            MessageElementFlag::AlwaysShow)
-                    ->setLink(Link(Link::InsertText, emote.first.string));
+                    ->setLink(Link(Link::InsertText, emotes[j].first));
             }
+            messages.push_back(builder.release());
         }
-        else
+
+        return messages;
+    }
+    EmoteList sortedEmotes(const EmoteMap &map)
+    {
+        EmoteList emotes;
+        emotes.reserve(map.size());
+        for (const auto &emote : map)
+        {
+            emotes.emplace_back(emote.first.string, emote.second);
+        }
+        std::sort(emotes.begin(), emotes.end(),
+                  [](const auto &l, const auto &r) {
+                      return CompletionModel::compareStrings(l.first,
+                                                             r.first);
+                  });
+        return emotes;
+    }
+    // Loads the images of the page below the visible one, so they are ready
+    // by the time it's scrolled into view.
+    void prefetchNextPage(ChannelView *view)
+    {
+        auto channel = view->channel();
+        if (!channel)
         {
-            builder.emplace<TextElement>("no emotes available",
-                                         MessageElementFlag::Text,
-                                         MessageColor::System);
+            return;
         }
 
-        return builder.release();
+        auto &scrollbar = view->getScrollBar();
+        auto messages = channel->getMessageSnapshot();
+        auto start = size_t(std::max<qreal>(
+            0, scrollbar.getCurrentValue() + scrollbar.getLargeChange()));
+        auto end = std::min(
+            messages.size(),
+            start + size_t(std::max<qreal>(1, scrollbar.getLargeChange())));
+
+        for (auto i = start; i < end; i++)
+        {
+            for (const auto &element : messages[i]->elements)
+            {
+                if (auto emote =
+                        dynamic_cast<const EmoteElement *>(element.get()))
+                {
+                    emote->getEmote()->images.getImage(view->scale())->load();
+                }
+            }
+        }
     }
     void addEmoteSets(
         std::vector<std::shared_ptr<TwitchAccount::EmoteSet>> sets,
-        Channel &globalChannel, Channel &subChannel, QString currentChannelName)
+        Channel &globalChannel, Channel &subChannel, QString currentChannelName,
+        EmoteList &allEmotes)
     {
         QMap<QString, QPair<bool, std::vector<MessagePtr>>> mapOfSets;
 
@@ -72,11 +127,6 @@ namespace {
             auto text =
                 set->key == "0" || set->text.isEmpty() ? "Twitch" : set->text;
 
-            // EMOTES
-            MessageBuilder builder;
-            builder->flags.set(MessageFlag::Centered);
-            builder->flags.set(MessageFlag::DisableCompactEmotes);
-
             // If value of map is empty, create init pair and add title.
             if (mapOfSets.find(channelName) == mapOfSets.end())
             {
@@ -85,17 +135,22 @@ namespace {
                 mapOfSets[channelName] = qMakePair(set->key == "0", b);
             }
 
+            // EMOTES
+            EmoteList emotes;
             for (const auto &emote : set->emotes)
             {
-                builder
-                    .emplace<EmoteElement>(
-                        getApp()->emotes->twitch.getOrCreateEmote(emote.id,
-                                                                  emote.name),
-                        MessageElementFlag::AlwaysShow)
-                    ->setLink(Link(Link::InsertText, emote.name.string));
+                emotes.emplace_back(
+                    emote.name.string,
+                    getApp()->emotes->twitch.getOrCreateEmote(emote.id,
+                                                              emote.name));
             }
+            allEmotes.insert(allEmotes.end(), emotes.begin(), emotes.end());
 
-            mapOfSets[channelName].second.push_back(builder.release());
+            auto &messages = mapOfSets[channelName].second;
+            for (auto &&message : makeEmoteMessages(emotes))
+            {
+                messages.push_back(std::move(message));
+            }
         }
 
         // Output to channel all created messages,
@@ -128,7 +183,12 @@ EmotePopup::EmotePopup(QWidget *parent)
     auto layout = new QVBoxLayout(this);
     this->getLayoutContainer()->setLayout(layout);
 
-    auto notebook = new Notebook(this);
+    this->search_ = new QLineEdit(this);
+    this->search_->setPlaceholderText("Search emotes...");
+    this->search_->setClearButtonEnabled(true);
+    layout->addWidget(this->search_);
+
+    auto notebook = this->notebook_ = new Notebook(this);
     layout->addWidget(notebook);
     layout->setMargin(0);
 
@@ -136,23 +196,41 @@ EmotePopup::EmotePopup(QWidget *parent)
         this->linkClicked.invoke(link);
     };
 
-    auto makeView = [&](QString tabTitle) {
+    auto makeView = [&]() {
         auto view = new ChannelView();
 
         view->setOverrideFlags(MessageElementFlags{
             MessageElementFlag::Default, MessageElementFlag::AlwaysShow,
             MessageElementFlag::EmoteImages});
         view->setEnableScrollingToBottom(false);
-        notebook->addPage(view, tabTitle);
         view->linkClicked.connect(clicked);
+        view->getScrollBar().getCurrentValueChanged().connect([view] {
+            prefetchNextPage(view);
+        });
 
         return view;
     };
+    auto makePage = [&](QString tabTitle) {
+        auto view = makeView();
+        notebook->addPage(view, tabTitle);
+        return view;
+    };
+
+    this->subEmotesView_ = makePage("Subs");
+    this->channelEmotesView_ = makePage("Channel");
+    this->globalEmotesView_ = makePage("Global");
+    this->viewEmojis_ = makePage("Emojis");
 
-    this->subEmotesView_ = makeView("Subs");
-    this->channelEmotesView_ = makeView("Channel");
-    this->globalEmotesView_ = makeView("Global");
-    this->viewEmojis_ = makeView("Emojis");
+    // replaces the notebook while searching
+    this->searchView_ = makeView();
+    this->searchView_->hide();
+    layout->addWidget(this->searchView_);
+
+    QObject::connect(this->search_, &QLineEdit::textChanged, this,
+                     [this](const QString &text) {
+                         this->search(text);
+                     });
+    this->search_->setFocus();
 
     this->loadEmojis();
 
@@ -190,10 +268,27 @@ void EmotePopup::loadChannel(ChannelPtr _channel)
     if (twitchChannel == nullptr)
         return;
 
+    this->emoteIndex_.clear();
+    auto addToIndex = [this](const EmoteList &emotes) {
+        for (const auto &emote : emotes)
+        {
+            this->emoteIndex_.push_back(
+                {emote.first.toLower(), emote.first, emote.second});
+        }
+    };
+
     auto addEmotes = [&](Channel &channel, const EmoteMap &map,
                          const QString &title) {
         channel.addMessage(makeTitleMessage(title));
-        channel.addMessage(makeEmoteMessage(map));
+
+        auto emotes = sortedEmotes(map);
+        if (emotes.empty())
+        {
+            channel.addMessage(makeSystemMessage("no emotes available"));
+            return;
+        }
+        channel.addMessages(makeEmoteMessages(emotes));
+        addToIndex(emotes);
     };
 
     auto subChannel = std::make_shared<Channel>("", Channel::Type::None);
@@ -201,9 +296,11 @@ void EmotePopup::loadChannel(ChannelPtr _channel)
     auto channelChannel = std::make_shared<Channel>("", Channel::Type::None);
 
     // twitch
+    EmoteList twitchEmotes;
     addEmoteSets(
         getApp()->accounts->twitch.getCurrent()->accessEmotes()->emoteSets,
-        *globalChannel, *subChannel, _channel->getName());
+        *globalChannel, *subChannel, _channel->getName(), twitchEmotes);
+    addToIndex(twitchEmotes);
 
     // global
     addEmotes(*globalChannel, *twitchChannel->globalBttv().emotes(),
@@ -221,14 +318,17 @@ void EmotePopup::loadChannel(ChannelPtr _channel)
 
     if (subChannel->getMessageSnapshot().size() == 0)
     {
-        MessageBuilder builder;
-        builder->flags.set(MessageFlag::Centered);
-        builder->flags.set(MessageFlag::DisableCompactEmotes);
-        builder.emplace<TextElement>("no subscription emotes available",
-                                     MessageElementFlag::Text,
-                                     MessageColor::System);
-        subChannel->addMessage(builder.release());
+        subChannel->addMessage(
+            makeSystemMessage("no subscription emotes available"));
     }
+
+    std::sort(this->emoteIndex_.begin(), this->emoteIndex_.end(),
+              [](const auto &l, const auto &r) {
+                  return l.name < r.name;
+              });
+    this->lastQuery_.clear();
+    this->lastResults_.clear();
+    this->search(this->search_->text());
 }
 
 void EmotePopup::loadEmojis()
@@ -238,19 +338,93 @@ void EmotePopup::loadEmojis()
     ChannelPtr emojiChannel(new Channel("", Channel::Type::None));
 
     // emojis
-    MessageBuilder builder;
-    builder->flags.set(MessageFlag::Centered);
-    builder->flags.set(MessageFlag::DisableCompactEmotes);
-
-    emojis.each([&builder](const auto &key, const auto &value) {
-        builder
-            .emplace<EmoteElement>(value->emote, MessageElementFlag::AlwaysShow)
-            ->setLink(
-                Link(Link::Type::InsertText, ":" + value->shortCodes[0] + ":"));
+    EmoteList emotes;
+    this->emojiIndex_.clear();
+
+    emojis.each([&](const auto &key, const auto &value) {
+        auto insertText = ":" + value->shortCodes[0] + ":";
+        emotes.emplace_back(insertText, value->emote);
+        this->emojiIndex_.push_back(
+            {value->shortCodes[0].toLower(), insertText, value->emote});
     });
-    emojiChannel->addMessage(builder.release());
+    emojiChannel->addMessages(makeEmoteMessages(emotes));
 
     this->viewEmojis_->setChannel(emojiChannel);
+
+    std::sort(this->emojiIndex_.begin(), this->emojiIndex_.end(),
+              [](const auto &l, const auto &r) {
+                  return l.name < r.name;
+              });
+    this->lastQuery_.clear();
+    this->lastResults_.clear();
+}
+
+void EmotePopup::search(const QString &text)
+{
+    auto query = text.trimmed().toLower();
+
+    this->notebook_->setVisible(query.isEmpty());
+    this->searchView_->setVisible(!query.isEmpty());
+    if (query.isEmpty())
+    {
+        this->lastQuery_.clear();
+        this->lastResults_.clear();
+        this->searchView_->setChannel(
+            std::make_shared<Channel>("", Channel::Type::None));
+        return;
+    }
+
+    std::vector<const SearchEntry *> results;
+    if (!this->lastQuery_.isEmpty() && query.startsWith(this->lastQuery_))
+    {
+        // every match of the longer query also matched the last one
+        for (auto entry : this->lastResults_)
+        {
+            if (entry->name.contains(query))
+            {
+                results.push_back(entry);
+            }
+        }
+    }
+    else
+    {
+        for (const auto *index : {&this->emoteIndex_, &this->emojiIndex_})
+        {
+            for (const auto &entry : *index)
+            {
+                if (entry.name.contains(query))
+                {
+                    results.push_back(&entry);
+                }
+            }
+        }
+    }
+
+    // prefix matches first, the order within both stays the same
+    std::stable_partition(results.begin(), results.end(),
+                          [&query](const SearchEntry *entry) {
+                              return entry->name.startsWith(query);
+                          });
+
+    this->lastQuery_ = query;
+    this->lastResults_ = results;
+
+    auto channel = std::make_shared<Channel>("", Channel::Type::None);
+    if (results.empty())
+    {
+        channel->addMessage(makeSystemMessage("no emotes found"));
+    }
+    else
+    {
+        EmoteList emotes;
+        emotes.reserve(results.size());
+        for (auto entry : results)
+        {
+            emotes.emplace_back(entry->insertText, entry->emote);
+        }
+        channel->addMessages(makeEmoteMessages(emotes));
+    }
+    this->searchView_->setChannel(channel);
 }
 
 void EmotePopup::closeEvent(QCloseEvent *event)
@@ -4,12 +4,20 @@
 
 #include <pajlada/signals/signal.hpp>
 
+#include <memory>
+#include <vector>
+
+class QLineEdit;
+
 namespace chatterino {
 
 struct Link;
 class ChannelView;
 class Channel;
 using ChannelPtr = std::shared_ptr<Channel>;
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+class Notebook;
 
 class EmotePopup : public BasePopup
 {
@@ -24,10 +32,30 @@ public:
     pajlada::Signals::Signal<Link> linkClicked;
 
 private:
+    struct SearchEntry {
+        // lowercase, the index is sorted by it
+        QString name;
+        QString insertText;
+        EmotePtr emote;
+    };
+
+    void search(const QString &text);
+
+    Notebook *notebook_{};
+    QLineEdit *search_{};
+    ChannelView *searchView_{};
+
     ChannelView *globalEmotesView_{};
     ChannelView *channelEmotesView_{};
     ChannelView *subEmotesView_{};
     ChannelView *viewEmojis_{};
+
+    std::vector<SearchEntry> emoteIndex_;
+    std::vector<SearchEntry> emojiIndex_;
+
+    // the results of the last query are narrowed down while it's being typed
+    QString lastQuery_;
+    std::vector<const SearchEntry *> lastResults_;
 };
 
 }  // namespace chatterino
@@ -334,6 +334,7 @@ UserInfoPopup::UserInfoPopup(bool closeAutomatically, QWidget *parent)
 UserInfoPopup::~UserInfoPopup()
 {
     this->refreshConnection_.disconnect();
+    this->batchRefreshConnection_.disconnect();
 }
 
 void UserInfoPopup::themeChangedEvent()
@@ -531,6 +532,7 @@ void UserInfoPopup::updateLatestMessages()
 
     this->refreshConnection_
         .disconnect();  // remove once https://github.com/pajlada/signals/pull/10 gets merged
+    this->batchRefreshConnection_.disconnect();
 
     this->refreshConnection_ = this->channel_->messageAppended.connect(
         [this, hasMessages](auto message, auto) {
@@ -549,6 +551,32 @@ void UserInfoPopup::updateLatestMessages()
                 this->updateLatestMessages();
             }
         });
+
+    this->batchRefreshConnection_ = this->channel_->messagesAppended.connect(
+        [this, hasMessages](std::vector<MessagePtr> &messages) {
+            std::vector<MessagePtr> filtered;
+            for (const auto &message : messages)
+            {
+                if (checkMessageUserName(this->userName_, message))
+                {
+                    filtered.push_back(message);
+                }
+            }
+
+            if (filtered.empty())
+                return;
+
+            if (hasMessages)
+            {
+                this->ui_.latestMessages->channel()->addMessages(
+                    std::move(filtered));
+            }
+            else
+            {
+                // the batch is already part of the channel's snapshot
+                this->updateLatestMessages();
+            }
+        });
 }
 
 void UserInfoPopup::updateUserData()
@@ -44,6 +44,7 @@ private:
 
     // replace with ScopedConnection once https://github.com/pajlada/signals/pull/10 gets merged
     pajlada::Signals::Connection refreshConnection_;
+    pajlada::Signals::Connection batchRefreshConnection_;
 
     std::shared_ptr<bool> hack_;
 
@@ -25,6 +25,7 @@
 #include "messages/MessageElement.hpp"
 #include "messages/layouts/MessageLayout.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "messages/layouts/PixmapPool.hpp"
 #include "providers/LinkResolver.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
@@ -154,6 +155,10 @@ ChannelView::ChannelView(BaseWidget *parent)
     QObject::connect(&this->scrollTimer_, &QTimer::timeout, this,
                      &ChannelView::scrollUpdateRequested);
 
+    this->releaseLayoutsTimer_.setSingleShot(true);
+    QObject::connect(&this->releaseLayoutsTimer_, &QTimer::timeout, this,
+                     &ChannelView::releaseLayouts);
+
     this->setFocusPolicy(Qt::FocusPolicy::StrongFocus);
 }
 
@@ -618,6 +623,20 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
                 }
             }));
 
+    this->channelConnections_.push_back(
+        underlyingChannel->messagesAppended.connect(
+            [this](std::vector<MessagePtr> &messages) {
+                std::vector<MessagePtr> filtered;
+                std::copy_if(messages.begin(), messages.end(),
+                             std::back_inserter(filtered),
+                             [this](MessagePtr msg) {
+                                 return this->shouldIncludeMessage(msg);
+                             });
+
+                // The underlyingChannel already logged the messages
+                this->channel_->addMessages(std::move(filtered), false);
+            }));
+
     this->channelConnections_.push_back(
         underlyingChannel->messagesAddedAtStart.connect(
             [this](std::vector<MessagePtr> &messages) {
@@ -650,6 +669,12 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
             this->messageAppended(message, overridingFlags);
         }));
 
+    this->channelConnections_.push_back(
+        this->channel_->messagesAppended.connect(
+            [this](std::vector<MessagePtr> &messages) {
+                this->messagesAppended(messages);
+            }));
+
     this->channelConnections_.push_back(
         this->channel_->messagesAddedAtStart.connect(
             [this](std::vector<MessagePtr> &messages) {
@@ -669,10 +694,39 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
             this->messageReplaced(index, replacement);
         }));
 
-    auto snapshot = underlyingChannel->getMessageSnapshot();
+    this->underlyingChannel_ = underlyingChannel;
+
+    // Splits in tabs that aren't selected only build their layouts once they
+    // are shown for the first time.
+    this->releaseLayoutsTimer_.stop();
+    this->layoutsReleased_ =
+        getSettings()->lazyLoadHiddenSplits && !this->isVisible();
+
+    if (!this->layoutsReleased_)
+    {
+        this->loadLayoutsFromChannel();
+    }
+
+    // Notifications
+    if (auto tc = dynamic_cast<TwitchChannel *>(underlyingChannel.get()))
+    {
+        this->connections_.push_back(tc->liveStatusChanged.connect([this]() {
+            this->liveStatusChanged.invoke();
+        }));
+    }
+}
+
+void ChannelView::loadLayoutsFromChannel()
+{
+    auto snapshot = this->underlyingChannel_->getMessageSnapshot();
 
     for (size_t i = 0; i < snapshot.size(); i++)
     {
+        if (!this->shouldIncludeMessage(snapshot[i]))
+        {
+            continue;
+        }
+
         MessageLayoutPtr deleted;
 
         auto messageLayout = new MessageLayout(snapshot[i]);
@@ -684,7 +738,7 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
         this->lastMessageHasAlternateBackground_ =
             !this->lastMessageHasAlternateBackground_;
 
-        if (underlyingChannel->shouldIgnoreHighlights())
+        if (this->underlyingChannel_->shouldIgnoreHighlights())
         {
             messageLayout->flags.set(MessageLayoutFlag::IgnoreHighlights);
         }
@@ -697,18 +751,24 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
         }
     }
 
-    this->underlyingChannel_ = underlyingChannel;
-
     this->queueLayout();
     this->queueUpdate();
+}
 
-    // Notifications
-    if (auto tc = dynamic_cast<TwitchChannel *>(underlyingChannel.get()))
+void ChannelView::releaseLayouts()
+{
+    if (this->layoutsReleased_ || this->isVisible() ||
+        !this->underlyingChannel_)
     {
-        this->connections_.push_back(tc->liveStatusChanged.connect([this]() {
-            this->liveStatusChanged.invoke();
-        }));
+        return;
     }
+
+    // The messages stay in the channel, only the layouts and their buffers
+    // are dropped.
+    this->clearMessages();
+    this->clearSelection();
+    this->lastReadMessage_.reset();
+    this->layoutsReleased_ = true;
 }
 
 void ChannelView::setFilters(const QList<QUuid> &ids)
@@ -772,6 +832,28 @@ void ChannelView::messageAppended(MessagePtr &message,
         messageFlags = overridingFlags.get_ptr();
     }
 
+    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
+    {
+        if (messageFlags->has(MessageFlag::Highlighted) &&
+            messageFlags->has(MessageFlag::ShowInMentions) &&
+            !messageFlags->has(MessageFlag::Subscription) &&
+            (getSettings()->highlightMentions ||
+             this->channel_->getType() != Channel::Type::TwitchMentions))
+
+        {
+            this->tabHighlightRequested.invoke(HighlightState::Highlighted);
+        }
+        else
+        {
+            this->tabHighlightRequested.invoke(HighlightState::NewMessage);
+        }
+    }
+
+    if (this->layoutsReleased_)
+    {
+        return;
+    }
+
     auto messageRef = new MessageLayout(message);
 
     if (this->lastMessageHasAlternateBackground_)
@@ -801,26 +883,100 @@ void ChannelView::messageAppended(MessagePtr &message,
         }
     }
 
-    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
+    if (this->showScrollbarHighlights())
     {
-        if (messageFlags->has(MessageFlag::Highlighted) &&
-            messageFlags->has(MessageFlag::ShowInMentions) &&
-            !messageFlags->has(MessageFlag::Subscription) &&
+        this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+    }
+
+    this->messageWasAdded_ = true;
+    this->queueLayout();
+}
+
+void ChannelView::messagesAppended(std::vector<MessagePtr> &messages)
+{
+    // the tab is only highlighted once for the whole batch
+    auto highlightState = boost::optional<HighlightState>();
+    for (const auto &message : messages)
+    {
+        const auto &flags = message->flags;
+        if (flags.has(MessageFlag::DoNotTriggerNotification))
+        {
+            continue;
+        }
+
+        if (flags.has(MessageFlag::Highlighted) &&
+            flags.has(MessageFlag::ShowInMentions) &&
+            !flags.has(MessageFlag::Subscription) &&
             (getSettings()->highlightMentions ||
              this->channel_->getType() != Channel::Type::TwitchMentions))
+        {
+            highlightState = HighlightState::Highlighted;
+            break;
+        }
+        highlightState = HighlightState::NewMessage;
+    }
+
+    if (highlightState)
+    {
+        this->tabHighlightRequested.invoke(highlightState.get());
+    }
 
+    if (this->layoutsReleased_)
+    {
+        return;
+    }
+
+    std::vector<MessageLayoutPtr> messageRefs;
+    messageRefs.reserve(messages.size());
+
+    auto ignoreHighlights = this->channel_->shouldIgnoreHighlights();
+    for (const auto &message : messages)
+    {
+        auto layout = new MessageLayout(message);
+
+        if (this->lastMessageHasAlternateBackground_)
         {
-            this->tabHighlightRequested.invoke(HighlightState::Highlighted);
+            layout->flags.set(MessageLayoutFlag::AlternateBackground);
+        }
+        if (ignoreHighlights)
+        {
+            layout->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        }
+        this->lastMessageHasAlternateBackground_ =
+            !this->lastMessageHasAlternateBackground_;
+
+        messageRefs.push_back(MessageLayoutPtr(layout));
+    }
+
+    std::vector<MessageLayoutPtr> deleted;
+    this->messages_.pushBack(messageRefs, deleted);
+
+    if (!deleted.empty())
+    {
+        if (this->paused())
+        {
+            if (!this->scrollBar_->isAtBottom())
+                this->pauseScrollOffset_ -= int(deleted.size());
         }
         else
         {
-            this->tabHighlightRequested.invoke(HighlightState::NewMessage);
+            if (this->scrollBar_->isAtBottom())
+                this->scrollBar_->scrollToBottom();
+            else
+                this->scrollBar_->offset(-qreal(deleted.size()));
         }
     }
 
     if (this->showScrollbarHighlights())
     {
-        this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        std::vector<ScrollbarHighlight> highlights;
+        highlights.reserve(messages.size());
+        for (const auto &message : messages)
+        {
+            highlights.push_back(message->getScrollBarHighlight());
+        }
+
+        this->scrollBar_->addHighlights(highlights);
     }
 
     this->messageWasAdded_ = true;
@@ -829,6 +985,11 @@ void ChannelView::messageAppended(MessagePtr &message,
 
 void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
 {
+    if (this->layoutsReleased_)
+    {
+        return;
+    }
+
     std::vector<MessageLayoutPtr> messageRefs;
     messageRefs.resize(messages.size());
 
@@ -874,6 +1035,11 @@ void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
 
 void ChannelView::messageRemoveFromStart(MessagePtr &message)
 {
+    if (this->layoutsReleased_)
+    {
+        return;
+    }
+
     if (this->paused())
     {
         this->pauseSelectionOffset_ += 1;
@@ -891,7 +1057,8 @@ void ChannelView::messageRemoveFromStart(MessagePtr &message)
 
 void ChannelView::messageReplaced(size_t index, MessagePtr &replacement)
 {
-    if (index >= this->messages_.getSnapshot().size())
+    if (this->layoutsReleased_ ||
+        index >= this->messages_.getSnapshot().size())
     {
         return;
     }
@@ -1036,6 +1203,24 @@ void ChannelView::drawMessages(QPainter &painter)
     bool isMentions =
         this->underlyingChannel_ == app->twitch.server->mentionsChannel;
 
+    // the buffers of messages that scroll off screen are reused for the ones
+    // that scroll into view
+    auto pool = PixmapPool::forWindow(this->window());
+
+    if (getSettings()->threadedMessageRendering && this->selection_.isEmpty())
+    {
+        std::vector<MessageLayout *> visible;
+        int visibleY = y;
+        for (size_t i = start;
+             i < messagesSnapshot.size() && visibleY <= this->height(); ++i)
+        {
+            visible.push_back(messagesSnapshot[i].get());
+            visibleY += messagesSnapshot[i]->getHeight();
+        }
+
+        MessageLayout::rasterizeBuffers(visible, painter, DRAW_WIDTH, *pool);
+    }
+
     for (size_t i = start; i < messagesSnapshot.size(); ++i)
     {
         MessageLayout *layout = messagesSnapshot[i].get();
@@ -1047,7 +1232,7 @@ void ChannelView::drawMessages(QPainter &painter)
         }
 
         layout->paint(painter, DRAW_WIDTH, y, i, this->selection_,
-                      isLastMessage, windowFocused, isMentions);
+                      isLastMessage, windowFocused, isMentions, *pool);
 
         y += layout->getHeight();
 
@@ -1965,7 +2150,20 @@ void ChannelView::mouseDoubleClickEvent(QMouseEvent *event)
     }
 }
 
-void ChannelView::hideEvent(QHideEvent *)
+void ChannelView::showEvent(QShowEvent *event)
+{
+    BaseWidget::showEvent(event);
+
+    this->releaseLayoutsTimer_.stop();
+
+    if (this->layoutsReleased_ && this->underlyingChannel_)
+    {
+        this->layoutsReleased_ = false;
+        this->loadLayoutsFromChannel();
+    }
+}
+
+void ChannelView::hideEvent(QHideEvent *event)
 {
     for (auto &layout : this->messagesOnScreen_)
     {
@@ -1973,6 +2171,15 @@ void ChannelView::hideEvent(QHideEvent *)
     }
 
     this->messagesOnScreen_.clear();
+
+    // only splits whose tab was switched away from or that were closed,
+    // minimizing the window mustn't lose the scroll position
+    if (getSettings()->lazyLoadHiddenSplits && !event->spontaneous() &&
+        !this->window()->isMinimized())
+    {
+        this->releaseLayoutsTimer_.start(
+            getSettings()->hiddenSplitReleaseTimeout * 1000);
+    }
 }
 
 void ChannelView::showUserInfoPopup(const QString &userName)
@@ -115,6 +115,7 @@ protected:
     void mouseReleaseEvent(QMouseEvent *event) override;
     void mouseDoubleClickEvent(QMouseEvent *event) override;
 
+    void showEvent(QShowEvent *) override;
     void hideEvent(QHideEvent *) override;
 
     void handleLinkClick(QMouseEvent *event, const Link &link,
@@ -130,10 +131,14 @@ private:
 
     void messageAppended(MessagePtr &message,
                          boost::optional<MessageFlags> overridingFlags);
+    void messagesAppended(std::vector<MessagePtr> &messages);
     void messageAddedAtStart(std::vector<MessagePtr> &messages);
     void messageRemoveFromStart(MessagePtr &message);
     void messageReplaced(size_t index, MessagePtr &replacement);
 
+    void loadLayoutsFromChannel();
+    void releaseLayouts();
+
     void performLayout(bool causedByScollbar = false);
     void layoutVisibleMessages(
         LimitedQueueSnapshot<MessageLayoutPtr> &messages);
@@ -177,6 +182,12 @@ private:
     int pauseScrollOffset_ = 0;
     int pauseSelectionOffset_ = 0;
 
+    // Views that have not been shown yet or have been hidden for a while
+    // don't keep any message layouts. They are built from the channel when
+    // the view is shown.
+    bool layoutsReleased_ = false;
+    QTimer releaseLayoutsTimer_;
+
     boost::optional<MessageElementFlags> overrideFlags_;
     MessageLayoutPtr lastReadMessage_;
 
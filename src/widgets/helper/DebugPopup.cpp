@@ -1,6 +1,7 @@
 #include "DebugPopup.hpp"
 
-#include "util/DebugCount.hpp"
+#include "debug/MemoryReport.hpp"
+#include "debug/MessageLatency.hpp"
 
 #include <QFontDatabase>
 #include <QHBoxLayout>
@@ -15,9 +16,11 @@ DebugPopup::DebugPopup()
     auto *text = new QLabel(this);
     auto *timer = new QTimer(this);
 
-    timer->setInterval(300);
+    // summing up the channels walks every message, don't do it too often
+    timer->setInterval(1000);
     QObject::connect(timer, &QTimer::timeout, [text] {
-        text->setText(DebugCount::getDebugText());
+        text->setText(MemoryReport::getText() + "\n" +
+                      MessageLatency::getText());
     });
     timer->start();
 
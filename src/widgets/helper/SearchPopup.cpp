@@ -1,56 +1,69 @@
 #include "SearchPopup.hpp"
 
+#include <QCheckBox>
 #include <QHBoxLayout>
 #include <QLineEdit>
+#include <QPointer>
 #include <QPushButton>
 #include <QVBoxLayout>
+#include <QtConcurrent>
 
+#include <algorithm>
+#include <iterator>
+
+#include "Application.hpp"
 #include "common/Channel.hpp"
 #include "messages/Message.hpp"
-#include "messages/search/AuthorPredicate.hpp"
-#include "messages/search/LinkPredicate.hpp"
-#include "messages/search/SubstringPredicate.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "messages/search/SearchQuery.hpp"
+#include "providers/twitch/TwitchChannel.hpp"
+#include "singletons/Logging.hpp"
+#include "util/PostToThread.hpp"
 #include "util/Shortcut.hpp"
 #include "widgets/helper/ChannelView.hpp"
 
 namespace chatterino {
+namespace {
+    constexpr int MAX_LOG_RESULTS = 1000;
+    constexpr int LOG_SEARCH_DELAY = 250;
+    constexpr size_t COLD_HISTORY_CHUNK_SIZE = 50;
 
-ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const LimitedQueueSnapshot<MessagePtr> &snapshot,
-                               FilterSetPtr filterSet)
-{
-    ChannelPtr channel(new Channel(channelName, Channel::Type::None));
-
-    // Parse predicates from tags in "text"
-    auto predicates = parsePredicates(text);
-
-    // Check for every message whether it fulfills all predicates that have
-    // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
+    MessagePtr buildLogMessage(const LogIndex::Result &result)
     {
-        MessagePtr message = snapshot[i];
+        MessageBuilder builder;
 
-        bool accept = true;
-        for (const auto &pred : predicates)
+        builder.emplace<TimestampElement>(result.time.time());
+        builder.emplace<TextElement>(
+            result.time.date().toString(Qt::ISODate) + " " +
+                (result.channelName.startsWith('/') ? result.channelName
+                                                    : "#" + result.channelName),
+            MessageElementFlag::Text, MessageColor::System);
+
+        if (!result.loginName.isEmpty())
         {
-            // Discard the message as soon as one predicate fails
-            if (!pred->appliesTo(*message))
-            {
-                accept = false;
-                break;
-            }
+            builder
+                .emplace<TextElement>(result.displayName + ":",
+                                      MessageElementFlag::Username,
+                                      MessageColor::Text,
+                                      FontStyle::ChatMediumBold)
+                ->setLink({Link::UserInfo, result.loginName});
         }
-
-        if (accept && filterSet)
-            accept = filterSet->filter(message);
-
-        // If all predicates match, add the message to the channel
-        if (accept)
-            channel->addMessage(message);
+        builder.emplace<TextElement>(result.text, MessageElementFlag::Text,
+                                     MessageColor::Text);
+
+        builder.message().messageText = result.text;
+        builder.message().loginName = result.loginName;
+        builder.message().displayName = result.displayName;
+        builder.message().channelName = result.channelName;
+        builder.message().searchText =
+            result.loginName.isEmpty()
+                ? result.text
+                : result.displayName + " " + result.loginName + ": " +
+                      result.text;
+
+        return builder.release();
     }
-
-    return channel;
-}
+}  // namespace
 
 SearchPopup::SearchPopup(QWidget *parent)
     : BasePopup({}, parent)
@@ -58,6 +71,12 @@ SearchPopup::SearchPopup(QWidget *parent)
     this->initLayout();
     this->resize(400, 600);
 
+    this->logSearchTimer_.setSingleShot(true);
+    this->logSearchTimer_.setInterval(LOG_SEARCH_DELAY);
+    QObject::connect(&this->logSearchTimer_, &QTimer::timeout, [this] {
+        this->searchLogs();
+    });
+
     createShortcut(this, "CTRL+F", [this] {
         this->searchInput_->setFocus();
         this->searchInput_->selectAll();
@@ -73,10 +92,112 @@ void SearchPopup::setChannel(const ChannelPtr &channel)
 {
     this->channelView_->setSourceChannel(channel);
     this->channelName_ = channel->getName();
-    this->snapshot_ = channel->getMessageSnapshot();
+
+    auto snapshot = channel->getMessageSnapshot();
+    auto messages = std::make_shared<std::vector<MessagePtr>>();
+    messages->reserve(snapshot.size());
+    for (size_t i = 0; i < snapshot.size(); i++)
+    {
+        messages->push_back(snapshot[i]);
+    }
+    this->messages_ = std::move(messages);
+
+    this->lastResults_.reset();
+    this->lastSearchFinished_ = false;
     this->search();
 
     this->updateWindowTitle();
+    this->loadColdHistory(channel);
+}
+
+void SearchPopup::loadColdHistory(const ChannelPtr &channel)
+{
+    auto id = ++this->coldHistoryId_;
+
+    auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel.get());
+    if (!twitchChannel)
+    {
+        return;
+    }
+
+    auto snapshot = twitchChannel->coldHistory().snapshot();
+    if (snapshot.empty())
+    {
+        return;
+    }
+
+    // the channel still has these built
+    QSet<QString> skipIds;
+    for (const auto &message : *this->messages_)
+    {
+        skipIds.insert(message->id);
+    }
+
+    // only the blocks are decompressed on the worker, building messages
+    // must happen on the GUI thread
+    QPointer<SearchPopup> self(this);
+    std::weak_ptr<Channel> weak = channel;
+    QtConcurrent::run([self, id, weak, snapshot, skipIds] {
+        auto lines = std::make_shared<const ColdHistory::Lines>(
+            ColdHistory::lines(snapshot, skipIds));
+
+        postToThread([self, id, weak, lines] {
+            if (!self || lines->empty())
+            {
+                return;
+            }
+
+            auto built = std::make_shared<std::vector<MessagePtr>>();
+            built->reserve(lines->size());
+            self->buildColdHistory(id, weak, lines, 0, built);
+        });
+    });
+}
+
+void SearchPopup::buildColdHistory(
+    int id, std::weak_ptr<Channel> weak,
+    std::shared_ptr<const ColdHistory::Lines> lines, size_t begin,
+    std::shared_ptr<std::vector<MessagePtr>> built)
+{
+    auto shared = weak.lock();
+    if (!shared || this->coldHistoryId_ != id)
+    {
+        return;
+    }
+
+    if (begin < lines->size())
+    {
+        auto end = std::min(lines->size(), begin + COLD_HISTORY_CHUNK_SIZE);
+        auto chunk = ColdHistory::build(shared.get(), *lines, begin, end);
+        built->insert(built->end(), std::make_move_iterator(chunk.begin()),
+                      std::make_move_iterator(chunk.end()));
+
+        // let the GUI thread handle its events before the next chunk
+        QTimer::singleShot(0, this,
+                           [this, id, weak = std::move(weak),
+                            lines = std::move(lines), end,
+                            built = std::move(built)] {
+                               this->buildColdHistory(id, weak, lines, end,
+                                                      built);
+                           });
+        return;
+    }
+
+    if (built->empty())
+    {
+        return;
+    }
+
+    built->insert(built->end(), this->messages_->begin(),
+                  this->messages_->end());
+    this->messages_ = std::move(built);
+
+    this->lastResults_.reset();
+    this->lastSearchFinished_ = false;
+    if (!this->searchLogs_->isChecked())
+    {
+        this->search();
+    }
 }
 
 void SearchPopup::updateWindowTitle()
@@ -104,9 +225,103 @@ void SearchPopup::updateWindowTitle()
 
 void SearchPopup::search()
 {
-    this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_,
-                                          this->channelFilters_));
+    if (this->searchLogs_->isChecked())
+    {
+        this->messageSearch_.cancel();
+        this->lastSearchFinished_ = false;
+        this->logSearchTimer_.start();
+        return;
+    }
+    this->logSearchTimer_.stop();
+    this->logSearchId_++;
+
+    auto text = this->searchInput_->text();
+    auto query = SearchQuery::parse(text);
+
+    // If the new query narrows the previous one down, only the results of the
+    // previous search have to be searched again
+    std::shared_ptr<const std::vector<MessagePtr>> source = this->messages_;
+    if (this->lastSearchFinished_ && this->lastResults_ &&
+        query.narrows(SearchQuery::parse(this->lastQuery_)))
+    {
+        source = this->lastResults_;
+    }
+
+    ChannelPtr channel(new Channel(this->channelName_, Channel::Type::None));
+    this->channelView_->setChannel(channel);
+
+    auto results = std::make_shared<std::vector<MessagePtr>>();
+    this->lastQuery_ = text;
+    this->lastResults_ = results;
+    this->lastSearchFinished_ = false;
+
+    this->messageSearch_.start(
+        source, query.predicates(),
+        [this, channel, results](std::vector<MessagePtr> &&messages) {
+            // filters aren't thread safe, they're applied here
+            if (this->channelFilters_)
+            {
+                messages.erase(
+                    std::remove_if(messages.begin(), messages.end(),
+                                   [this](const MessagePtr &message) {
+                                       return !this->channelFilters_->filter(
+                                           message);
+                                   }),
+                    messages.end());
+            }
+            if (messages.empty())
+            {
+                return;
+            }
+
+            results->insert(results->end(), messages.begin(), messages.end());
+            // one layout and repaint for the whole batch, the results were
+            // logged by their own channels already
+            channel->addMessages(std::move(messages), false);
+        },
+        [this] {
+            this->lastSearchFinished_ = true;
+        });
+}
+
+void SearchPopup::searchLogs()
+{
+    auto index = getApp()->logging->getIndex();
+    if (!index)
+    {
+        return;
+    }
+
+    auto input = this->searchInput_->text();
+    // only search the logs of the channel unless another one is requested
+    if (!this->channelName_.isEmpty() && !this->channelName_.startsWith('/') &&
+        SearchQuery::parse(input).channels.empty())
+    {
+        input = QString("in:%1 %2").arg(this->channelName_, input);
+    }
+
+    ChannelPtr channel(new Channel(this->channelName_, Channel::Type::None));
+    this->channelView_->setChannel(channel);
+
+    auto searchId = ++this->logSearchId_;
+    index->search(
+        input, MAX_LOG_RESULTS,
+        [self = QPointer<SearchPopup>(this), channel,
+         searchId](auto &&results) {
+            // the popup was closed or a newer search has been started
+            if (!self || searchId != self->logSearchId_)
+            {
+                return;
+            }
+
+            // results are newest first
+            std::vector<MessagePtr> messages;
+            for (auto it = results.rbegin(); it != results.rend(); ++it)
+            {
+                messages.push_back(buildLogMessage(*it));
+            }
+            channel->addMessagesAtStart(messages);
+        });
 }
 
 void SearchPopup::initLayout()
@@ -131,6 +346,26 @@ void SearchPopup::initLayout()
                                  [this] {
                                      this->search();
                                  });
+                // the previous search is cancelled when the input changes
+                QObject::connect(this->searchInput_, &QLineEdit::textChanged,
+                                 [this] {
+                                     this->search();
+                                 });
+            }
+
+            // SEARCH LOGS
+            {
+                this->searchLogs_ = new QCheckBox("Search logs", this);
+                this->searchLogs_->setEnabled(getApp()->logging->getIndex() !=
+                                              nullptr);
+                this->searchLogs_->setToolTip(
+                    "Search the logs instead of the loaded messages.\n"
+                    "Words are matched from their start.");
+                layout2->addWidget(this->searchLogs_);
+                QObject::connect(this->searchLogs_, &QCheckBox::toggled,
+                                 [this] {
+                                     this->search();
+                                 });
             }
 
             // SEARCH BUTTON
@@ -157,55 +392,4 @@ void SearchPopup::initLayout()
     }
 }
 
-std::vector<std::unique_ptr<MessagePredicate>> SearchPopup::parsePredicates(
-    const QString &input)
-{
-    static QRegularExpression predicateRegex(R"(^(\w+):([\w,]+)$)");
-
-    auto predicates = std::vector<std::unique_ptr<MessagePredicate>>();
-    auto words = input.split(' ', QString::SkipEmptyParts);
-    auto authors = QStringList();
-
-    for (auto it = words.begin(); it != words.end();)
-    {
-        if (auto match = predicateRegex.match(*it); match.hasMatch())
-        {
-            QString name = match.captured(1);
-            QString value = match.captured(2);
-
-            bool remove = true;
-
-            // match predicates
-            if (name == "from")
-            {
-                authors.append(value);
-            }
-            else if (name == "has" && value == "link")
-            {
-                predicates.push_back(std::make_unique<LinkPredicate>());
-            }
-            else
-            {
-                remove = false;
-            }
-
-            // remove or advance
-            it = remove ? words.erase(it) : ++it;
-        }
-        else
-        {
-            ++it;
-        }
-    }
-
-    if (!authors.empty())
-        predicates.push_back(std::make_unique<AuthorPredicate>(authors));
-
-    if (!words.empty())
-        predicates.push_back(
-            std::make_unique<SubstringPredicate>(words.join(" ")));
-
-    return predicates;
-}
-
 }  // namespace chatterino
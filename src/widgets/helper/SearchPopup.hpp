@@ -2,12 +2,15 @@
 
 #include "ForwardDecl.hpp"
 #include "controllers/filters/FilterSet.hpp"
-#include "messages/LimitedQueueSnapshot.hpp"
-#include "messages/search/MessagePredicate.hpp"
+#include "messages/search/MessageSearch.hpp"
+#include "providers/twitch/ColdHistory.hpp"
 #include "widgets/BasePopup.hpp"
 
+#include <QTimer>
+
 #include <memory>
 
+class QCheckBox;
 class QLineEdit;
 
 namespace chatterino {
@@ -26,35 +29,31 @@ protected:
 private:
     void initLayout();
     void search();
+    void searchLogs();
+    void loadColdHistory(const ChannelPtr &channel);
+    // Builds the lines in chunks from begin on, the messages are only added
+    // once all of them are built
+    void buildColdHistory(int id, std::weak_ptr<Channel> weak,
+                          std::shared_ptr<const ColdHistory::Lines> lines,
+                          size_t begin,
+                          std::shared_ptr<std::vector<MessagePtr>> built);
+
+    std::shared_ptr<const std::vector<MessagePtr>> messages_;
+    // incremented when the channel changes, older cold history loads are
+    // ignored
+    int coldHistoryId_ = 0;
+    MessageSearch messageSearch_;
+
+    QString lastQuery_{};
+    std::shared_ptr<std::vector<MessagePtr>> lastResults_;
+    bool lastSearchFinished_ = false;
+
+    // log searches are started once the input stops changing
+    QTimer logSearchTimer_;
+    int logSearchId_ = 0;
 
-    /**
-     * @brief Only retains those message from a list of messages that satisfy a
-     *        search query.
-     *
-     * @param text          the search query -- will be parsed for MessagePredicates
-     * @param channelName   name of the channel to be returned
-     * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
-     *
-     * @return a ChannelPtr with "channelName" and the filtered messages from
-     *         "snapshot"
-     */
-    static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const LimitedQueueSnapshot<MessagePtr> &snapshot,
-                             FilterSetPtr filterSet);
-
-    /**
-     * @brief Checks the input for tags and registers their corresponding
-     *        predicates.
-     *
-     * @param input the string to check for tags
-     * @return a vector of MessagePredicates requested in the input
-     */
-    static std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
-        const QString &input);
-
-    LimitedQueueSnapshot<MessagePtr> snapshot_;
     QLineEdit *searchInput_{};
+    QCheckBox *searchLogs_{};
     ChannelView *channelView_{};
     QString channelName_{};
     FilterSetPtr channelFilters_;
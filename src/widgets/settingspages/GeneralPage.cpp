@@ -604,6 +604,11 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                        s.highlightInlineWhispers);
     layout.addCheckbox("Load message history on connect",
                        s.loadTwitchMessageHistoryOnConnect);
+    layout.addCheckbox("Store message history to restore it after a restart",
+                       s.storeMessageHistory);
+    layout.addCheckbox(
+        "Keep older messages compressed so searches reach further back",
+        s.keepColdHistory);
     // TODO: Change phrasing to use better english once we can tag settings, right now it's kept as history instead of historical so that the setting shows up when the user searches for history
     layout.addIntInput("Max number of history messages to load on connect",
                        s.twitchMessageHistoryLimit, 10, 800, 10);
@@ -627,6 +632,12 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                        s.askOnImageUpload);
     layout.addCheckbox("Messages in /mentions highlights tab",
                        s.highlightMentions);
+    layout.addCheckbox("Only load messages of splits in hidden tabs when shown",
+                       s.lazyLoadHiddenSplits);
+    layout.addIntInput("Unload messages of hidden splits after (seconds)",
+                       s.hiddenSplitReleaseTimeout, 30, 3600, 30);
+    layout.addCheckbox("Draw messages using multiple threads",
+                       s.threadedMessageRendering);
 
     layout.addStretch();
 
@@ -82,6 +82,9 @@ ModerationPage::ModerationPage()
     {
         logs.append(this->createCheckBox("Enable logging",
                                          getSettings()->enableLogging));
+        logs.append(this->createCheckBox(
+            "Index logs in the background to make them searchable",
+            getSettings()->enableLogIndex));
         auto logsPathLabel = logs.emplace<QLabel>();
 
         // Logs (copied from LoggingMananger)
@@ -222,7 +222,7 @@ void SplitInput::installKeyPressedEvent()
             message = message.replace('\n', ' ');
             QString sendMessage = app->commands->execCommand(message, c, false);
 
-            c->sendMessage(sendMessage);
+            c->sendMessage(sendMessage, Channel::SendPriority::Interactive);
             // don't add duplicate messages and empty message to message history
             if ((this->prevMsg_.isEmpty() ||
                  !this->prevMsg_.endsWith(message)) &&
@@ -0,0 +1,144 @@
+#include "controllers/ignores/IgnoreReplacer.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+IgnoreReplacer::Rule literal(const QString &pattern, const QString &replace,
+                             bool isCaseSensitive = false)
+{
+    return {pattern, false, isCaseSensitive, replace};
+}
+
+IgnoreReplacer::Rule regex(const QString &pattern, const QString &replace,
+                           bool isCaseSensitive = false)
+{
+    return {pattern, true, isCaseSensitive, replace};
+}
+
+QString replaced(const IgnoreReplacer &replacer, QString text)
+{
+    replacer.replace(text);
+    return text;
+}
+
+}  // namespace
+
+TEST(IgnoreReplacer, Literals)
+{
+    IgnoreReplacer replacer({
+        literal("cat", "dog"),
+        literal("Bird", "fish", true),
+        literal("he", "HE"),
+        literal("hers", "HERS"),
+    });
+
+    EXPECT_EQ(replaced(replacer, "a CAT and a cat"), "a dog and a dog");
+    EXPECT_EQ(replaced(replacer, "Bird bird"), "fish bird");
+    // both start at the same position, the rule listed first wins
+    EXPECT_EQ(replaced(replacer, "ushers"), "usHErs");
+    EXPECT_EQ(replaced(replacer, "nothing to see"), "nothing to see");
+}
+
+TEST(IgnoreReplacer, OverlappingLiterals)
+{
+    IgnoreReplacer replacer({
+        literal("aa", "b"),
+        literal("abc", "x"),
+        literal("ab", "y"),
+    });
+
+    EXPECT_EQ(replaced(replacer, "aaaa"), "bb");
+    EXPECT_EQ(replaced(replacer, "aaa"), "ba");
+    // same start, the rule listed first wins
+    EXPECT_EQ(replaced(replacer, "abc ab"), "x y");
+}
+
+TEST(IgnoreReplacer, Regexes)
+{
+    IgnoreReplacer replacer({
+        regex("\\bf+o+\\b", "bar"),
+        regex("(\\w+)@(\\w+)", "\\2 at \\1"),
+        regex("SHOUT", "shout", true),
+        regex("(a)\\1", "double a"),
+        regex("x*", "never"),
+        regex("[invalid", "never"),
+    });
+
+    EXPECT_EQ(replaced(replacer, "foo fooo afoo"), "bar bar afoo");
+    EXPECT_EQ(replaced(replacer, "user@host"), "host at user");
+    EXPECT_EQ(replaced(replacer, "SHOUT shout"), "shout shout");
+    EXPECT_EQ(replaced(replacer, "baab"), "bdouble ab");
+    EXPECT_EQ(replaced(replacer, "xx"), "never");
+}
+
+TEST(IgnoreReplacer, EmptyMatchesDontHideLaterRules)
+{
+    IgnoreReplacer replacer({
+        regex("x*", "never"),
+        regex("fo+", "bar"),
+        literal("cat", "dog"),
+        regex("(?<=a)y*", "never"),
+        regex("\\d+", "#"),
+    });
+
+    EXPECT_EQ(replaced(replacer, "foo cat 42"), "bar dog #");
+    EXPECT_EQ(replaced(replacer, "xx foo"), "never bar");
+    EXPECT_EQ(replaced(replacer, "a1 ayy"), "a# anever");
+}
+
+TEST(IgnoreReplacer, LiteralsAndRegexes)
+{
+    IgnoreReplacer replacer({
+        regex("a.c", "1"),
+        literal("abc", "2"),
+        literal("b", "3"),
+    });
+
+    EXPECT_EQ(replaced(replacer, "abc axc b"), "1 1 3");
+    // replaced text isn't matched again
+    EXPECT_EQ(replaced(IgnoreReplacer({literal("a", "b"), literal("b", "c")}),
+                       "ab"),
+              "bc");
+}
+
+TEST(IgnoreReplacer, Edits)
+{
+    IgnoreReplacer replacer({
+        literal("cat", "kitten"),
+        regex("\\d+", "#"),
+    });
+
+    QString text = "cat 123 cat";
+    auto edits = replacer.replace(text);
+
+    EXPECT_EQ(text, "kitten # kitten");
+    ASSERT_EQ(edits.size(), 3U);
+
+    EXPECT_EQ(edits[0].from, 0);
+    EXPECT_EQ(edits[0].length, 3);
+    EXPECT_EQ(edits[0].newFrom, 0);
+    EXPECT_EQ(edits[0].newLength, 6);
+    EXPECT_EQ(edits[0].rule, 0);
+
+    EXPECT_EQ(edits[1].from, 4);
+    EXPECT_EQ(edits[1].length, 3);
+    EXPECT_EQ(edits[1].newFrom, 7);
+    EXPECT_EQ(edits[1].newLength, 1);
+    EXPECT_EQ(edits[1].rule, 1);
+
+    EXPECT_EQ(edits[2].from, 8);
+    EXPECT_EQ(edits[2].newFrom, 9);
+}
+
+TEST(IgnoreReplacer, Empty)
+{
+    IgnoreReplacer replacer({literal("", "x"), regex("(", "x")});
+    EXPECT_TRUE(replacer.empty());
+
+    QString text = "unchanged";
+    EXPECT_TRUE(replacer.replace(text).empty());
+    EXPECT_EQ(text, "unchanged");
+}
@@ -0,0 +1,115 @@
+#include "singletons/helper/LogIndexSegment.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+using Postings = LogIndexSegment::Postings;
+
+std::shared_ptr<LogIndexSegment> buildSegment(
+    const QString &path, const std::vector<QStringList> &docs)
+{
+    LogIndexSegmentBuilder builder;
+    auto fileId = builder.fileId(path);
+    qint64 offset = 0;
+    for (const auto &terms : docs)
+    {
+        builder.addDoc(fileId, offset, terms);
+        offset += 10;
+    }
+    return builder.take();
+}
+
+}  // namespace
+
+TEST(LogIndexSegment, PrefixSearch)
+{
+    auto segment = buildSegment("a.log", {
+                                             {"w:hello", "w:world"},
+                                             {"w:help"},
+                                             {"w:hi"},
+                                             {"w:hello", "u:forsen"},
+                                         });
+
+    EXPECT_EQ(segment->withPrefix("w:hel"), (Postings{0, 1, 3}));
+    EXPECT_EQ(segment->withPrefix("w:hello"), (Postings{0, 3}));
+    EXPECT_EQ(segment->withPrefix("w:h"), (Postings{0, 1, 2, 3}));
+    EXPECT_EQ(segment->withPrefix("w:w"), (Postings{0}));
+    EXPECT_EQ(segment->withPrefix("u:"), (Postings{3}));
+    EXPECT_TRUE(segment->withPrefix("w:helloo").empty());
+    EXPECT_TRUE(segment->withPrefix("w:x").empty());
+}
+
+TEST(LogIndexSegment, RepeatedTermsArePostedOnce)
+{
+    auto segment = buildSegment("a.log", {
+                                             {"w:kappa", "w:kappa"},
+                                             {"w:kappa"},
+                                         });
+
+    EXPECT_EQ(segment->postings.value("w:kappa"), (QVector<quint32>{0, 1}));
+    EXPECT_EQ(segment->docOffsets, (QVector<qint64>{0, 10}));
+}
+
+TEST(LogIndexSegment, AppendShiftsDocsAndFiles)
+{
+    auto older = buildSegment("a.log", {
+                                           {"w:hello"},
+                                           {"w:world"},
+                                       });
+
+    LogIndexSegmentBuilder newerBuilder;
+    newerBuilder.addDoc(newerBuilder.fileId("b.log"), 5, {"w:hello"});
+    newerBuilder.addDoc(newerBuilder.fileId("a.log"), 20, {"w:hey"});
+    auto newer = newerBuilder.take();
+
+    LogIndexSegmentBuilder builder;
+    builder.append(*older);
+    builder.append(*newer);
+    EXPECT_EQ(builder.docCount(), 4);
+    auto merged = builder.take();
+
+    EXPECT_EQ(merged->files, (QVector<QString>{"a.log", "b.log"}));
+    EXPECT_EQ(merged->docFiles, (QVector<quint32>{0, 0, 1, 0}));
+    EXPECT_EQ(merged->docOffsets, (QVector<qint64>{0, 10, 5, 20}));
+    EXPECT_EQ(merged->postings.value("w:hello"), (QVector<quint32>{0, 2}));
+    EXPECT_EQ(merged->postings.value("w:world"), (QVector<quint32>{1}));
+    EXPECT_EQ(merged->postings.value("w:hey"), (QVector<quint32>{3}));
+    EXPECT_EQ(merged->withPrefix("w:he"), (Postings{0, 2, 3}));
+
+    // take() starts over
+    EXPECT_EQ(builder.docCount(), 0);
+    EXPECT_TRUE(builder.take()->files.isEmpty());
+}
+
+TEST(LogIndexSegment, WriteAndRead)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    auto segment = buildSegment("Twitch/Channels/forsen/forsen-2020-03-04.log",
+                                {
+                                    {"w:hello", "u:forsen"},
+                                    {"w:world", "l:"},
+                                });
+    ASSERT_TRUE(segment->write(dir.filePath("0.seg")));
+
+    auto read = LogIndexSegment::read(dir.filePath("0.seg"));
+    ASSERT_NE(read, nullptr);
+    EXPECT_EQ(read->files, segment->files);
+    EXPECT_EQ(read->docFiles, segment->docFiles);
+    EXPECT_EQ(read->docOffsets, segment->docOffsets);
+    EXPECT_EQ(read->postings, segment->postings);
+
+    EXPECT_EQ(LogIndexSegment::read(dir.filePath("missing.seg")), nullptr);
+
+    QFile damaged(dir.filePath("damaged.seg"));
+    ASSERT_TRUE(damaged.open(QIODevice::WriteOnly));
+    damaged.write("not a segment");
+    damaged.close();
+    EXPECT_EQ(LogIndexSegment::read(dir.filePath("damaged.seg")), nullptr);
+}
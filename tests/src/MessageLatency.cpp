@@ -0,0 +1,93 @@
+#include "debug/MessageLatency.hpp"
+
+#include <gtest/gtest.h>
+
+using Histogram = chatterino::MessageLatency::Histogram;
+
+TEST(MessageLatencyHistogram, Empty)
+{
+    Histogram histogram;
+
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.max(), 0);
+    EXPECT_EQ(histogram.percentile(50), 0);
+    EXPECT_EQ(histogram.percentile(99), 0);
+}
+
+TEST(MessageLatencyHistogram, SmallValuesAreExact)
+{
+    Histogram histogram;
+    for (int i = 0; i < 8; i++)
+    {
+        histogram.record(i);
+    }
+
+    EXPECT_EQ(histogram.count(), 8);
+    EXPECT_EQ(histogram.max(), 7);
+    EXPECT_EQ(histogram.percentile(50), 3);
+    EXPECT_EQ(histogram.percentile(100), 7);
+}
+
+TEST(MessageLatencyHistogram, Percentiles)
+{
+    Histogram histogram;
+    for (int i = 1; i <= 1000; i++)
+    {
+        histogram.record(i);
+    }
+
+    EXPECT_EQ(histogram.count(), 1000);
+    EXPECT_EQ(histogram.max(), 1000);
+
+    // the buckets are at most 12.5% wide
+    for (double percent : {50.0, 90.0, 99.0})
+    {
+        auto value = histogram.percentile(percent);
+        EXPECT_GE(value, percent * 10);
+        EXPECT_LE(value, percent * 10 * 1.125);
+    }
+    EXPECT_EQ(histogram.percentile(100), 1000);
+}
+
+TEST(MessageLatencyHistogram, OutOfRange)
+{
+    Histogram histogram;
+    histogram.record(-500);
+    EXPECT_EQ(histogram.percentile(100), 0);
+
+    histogram.record(int64_t(1) << 40);
+    EXPECT_EQ(histogram.count(), 2);
+    EXPECT_EQ(histogram.max(), (int64_t(1) << 22) - 1);
+}
+
+TEST(MessageLatencyTrace, Backlog)
+{
+    using chatterino::Channel;
+    using chatterino::MessageLatency;
+
+    auto before = MessageLatency::backlog();
+    auto target = reinterpret_cast<const Channel *>(&before);
+    auto other = reinterpret_cast<const Channel *>(&target);
+
+    {
+        MessageLatency::Trace trace;
+        trace.start("latency-test", target, 1, 2);
+        EXPECT_EQ(MessageLatency::backlog(), before + 1);
+
+        // only the channel the message was received in counts
+        trace.recordAdded(other);
+        EXPECT_EQ(MessageLatency::backlog(), before + 1);
+
+        trace.recordAdded(target);
+        EXPECT_EQ(MessageLatency::backlog(), before);
+    }
+    EXPECT_EQ(MessageLatency::backlog(), before);
+
+    {
+        MessageLatency::Trace trace;
+        trace.start("latency-test", target, 1, 2);
+        EXPECT_EQ(MessageLatency::backlog(), before + 1);
+    }
+    // dropped before reaching its channel
+    EXPECT_EQ(MessageLatency::backlog(), before);
+}
@@ -0,0 +1,129 @@
+#include "providers/twitch/MessageStore.hpp"
+
+#include <QDir>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+const QDate DAY(2020, 3, 4);
+
+QDateTime at(int daysBefore, int hour, int minute = 0)
+{
+    return QDateTime(DAY.addDays(-daysBefore), QTime(hour, minute));
+}
+
+std::vector<QByteArray> lines(
+    const std::vector<MessageStore::StoredMessage> &messages)
+{
+    std::vector<QByteArray> lines;
+    for (const auto &message : messages)
+    {
+        lines.push_back(message.line);
+    }
+    return lines;
+}
+
+}  // namespace
+
+TEST(MessageStore, ReadsNewestLinesOfChannel)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    MessageStore store(dir.path());
+    store.append("forsen", "a", at(0, 10));
+    store.append("pajlada", "b", at(0, 11));
+    store.append("forsen", "c", at(0, 12));
+    store.append("forsen", "d", at(0, 13));
+    store.flush();
+
+    auto end = at(0, 23).toMSecsSinceEpoch();
+    EXPECT_EQ(lines(store.readRecent("forsen", 10, end)),
+              (std::vector<QByteArray>{"a", "c", "d"}));
+    EXPECT_EQ(lines(store.readRecent("forsen", 2, end)),
+              (std::vector<QByteArray>{"c", "d"}));
+    EXPECT_EQ(lines(store.readRecent("pajlada", 10, end)),
+              (std::vector<QByteArray>{"b"}));
+    EXPECT_TRUE(store.readRecent("nymn", 10, end).empty());
+
+    // only lines received before the given time
+    auto messages =
+        store.readRecent("forsen", 10, at(0, 12).toMSecsSinceEpoch());
+    ASSERT_EQ(messages.size(), 1U);
+    EXPECT_EQ(messages[0].line, "a");
+    EXPECT_EQ(messages[0].timestamp, at(0, 10).toMSecsSinceEpoch());
+}
+
+TEST(MessageStore, EveryDayGetsASegment)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    MessageStore store(dir.path());
+    store.append("forsen", "a", at(2, 10));
+    store.append("forsen", "b", at(1, 10));
+    store.append("forsen", "c", at(0, 10));
+    store.flush();
+
+    QDir directory(dir.path());
+    EXPECT_TRUE(directory.exists("2020-03-02.dat"));
+    EXPECT_TRUE(directory.exists("2020-03-02.idx"));
+    EXPECT_TRUE(directory.exists("2020-03-03.dat"));
+    EXPECT_TRUE(directory.exists("2020-03-04.dat"));
+
+    // the newest lines come from the newest segments
+    auto end = at(0, 23).toMSecsSinceEpoch();
+    EXPECT_EQ(lines(store.readRecent("forsen", 10, end)),
+              (std::vector<QByteArray>{"a", "b", "c"}));
+    EXPECT_EQ(lines(store.readRecent("forsen", 2, end)),
+              (std::vector<QByteArray>{"b", "c"}));
+    EXPECT_EQ(
+        lines(store.readRecent("forsen", 10, at(1, 23).toMSecsSinceEpoch())),
+        (std::vector<QByteArray>{"a", "b"}));
+}
+
+TEST(MessageStore, OldSegmentsAreRemoved)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    MessageStore store(dir.path());
+    store.append("forsen", "a", at(4, 10));
+    store.append("forsen", "b", at(3, 10));
+    store.append("forsen", "c", at(0, 10));
+    store.flush();
+
+    QDir directory(dir.path());
+    EXPECT_FALSE(directory.exists("2020-02-29.dat"));
+    EXPECT_FALSE(directory.exists("2020-02-29.idx"));
+    EXPECT_TRUE(directory.exists("2020-03-01.dat"));
+    EXPECT_TRUE(directory.exists("2020-03-01.idx"));
+
+    EXPECT_EQ(lines(store.readRecent("forsen", 10,
+                                     at(0, 23).toMSecsSinceEpoch())),
+              (std::vector<QByteArray>{"b", "c"}));
+}
+
+TEST(MessageStore, AppendsToExistingSegment)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        MessageStore store(dir.path());
+        store.append("forsen", "a", at(0, 10));
+        store.flush();
+    }
+
+    // e.g. after a restart
+    MessageStore store(dir.path());
+    store.append("forsen", "b", at(0, 11));
+    store.flush();
+
+    EXPECT_EQ(lines(store.readRecent("forsen", 10,
+                                     at(0, 23).toMSecsSinceEpoch())),
+              (std::vector<QByteArray>{"a", "b"}));
+}
@@ -3,6 +3,7 @@
 #include "common/NetworkResult.hpp"
 #include "common/Outcome.hpp"
 #include "providers/twitch/api/Helix.hpp"
+#include "util/DebugCount.hpp"
 
 #include "common/Outcome.hpp"
 #include "common/QLogging.hpp"
@@ -334,3 +335,53 @@ TEST(NetworkRequest, FinallyCallbackOnTimeout)
     EXPECT_FALSE(onSuccessCalled);
     EXPECT_TRUE(NetworkManager::workerThread.isRunning());
 }
+
+TEST(NetworkRequest, Coalesced)
+{
+    EXPECT_TRUE(NetworkManager::workerThread.isRunning());
+
+    // the second request starts while the first one is still running
+    auto url = "http://httpbin.org/delay/1";
+
+    std::mutex mut;
+    int successCount = 0;
+    int doneCount = 0;
+    std::condition_variable requestDoneCondition;
+
+    auto &started = DebugCount::counter("http request started");
+    auto &coalesced = DebugCount::counter("http request coalesced");
+    auto startedBefore = started.value();
+    auto coalescedBefore = coalesced.value();
+
+    for (int i = 0; i < 2; i++)
+    {
+        NetworkRequest(url)
+            .onSuccess([&](NetworkResult result) -> Outcome {
+                EXPECT_EQ(result.status(), 200);
+
+                std::unique_lock lck(mut);
+                successCount++;
+                return Success;
+            })
+            .finally([&] {
+                {
+                    std::unique_lock lck(mut);
+                    doneCount++;
+                }
+                requestDoneCondition.notify_one();
+            })
+            .execute();
+    }
+
+    // Wait for both requests to finish
+    std::unique_lock lck(mut);
+    requestDoneCondition.wait(lck, [&doneCount] {
+        return doneCount == 2;
+    });
+
+    EXPECT_EQ(successCount, 2);
+    // the second request waited for the reply of the first one
+    EXPECT_EQ(coalesced.value(), coalescedBefore + 1);
+    EXPECT_EQ(started.value(), startedBefore + 1);
+    EXPECT_TRUE(NetworkManager::workerThread.isRunning());
+}
@@ -0,0 +1,103 @@
+#include "messages/layouts/PixmapPool.hpp"
+
+#include "util/DebugCount.hpp"
+#include "util/PostToThread.hpp"
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace chatterino;
+
+namespace {
+
+// pixmaps can only be used in the GUI thread
+template <typename F>
+void runInGuiThread(F &&function)
+{
+    std::promise<void> done;
+    postToThread([&] {
+        function();
+        done.set_value();
+    });
+    done.get_future().wait();
+}
+
+}  // namespace
+
+TEST(PixmapPool, SizeClasses)
+{
+    // multiples of 32 up to 256
+    EXPECT_EQ(PixmapPool::sizeClass({0, 1}), QSize(32, 32));
+    EXPECT_EQ(PixmapPool::sizeClass({32, 33}), QSize(32, 64));
+    EXPECT_EQ(PixmapPool::sizeClass({255, 256}), QSize(256, 256));
+
+    // 8 steps per power of two above that
+    EXPECT_EQ(PixmapPool::sizeClass({257, 300}), QSize(288, 320));
+    EXPECT_EQ(PixmapPool::sizeClass({512, 1000}), QSize(512, 1024));
+    EXPECT_EQ(PixmapPool::sizeClass({1025, 4000}), QSize(1152, 4096));
+}
+
+TEST(PixmapPool, ReusesPixmapsOfSameClass)
+{
+    runInGuiThread([] {
+        auto &allocations = DebugCount::counter("pixmap pool allocations");
+        auto &reuses = DebugCount::counter("pixmap pool reuses");
+        auto pool = std::make_shared<PixmapPool>();
+
+        auto allocationsBefore = allocations.value();
+        auto reusesBefore = reuses.value();
+
+        auto first = pool->take({100, 20}, 1);
+        EXPECT_EQ(first->size(), QSize(128, 32));
+        EXPECT_EQ(first->devicePixelRatio(), 1);
+        auto *firstPixmap = first.get();
+        first.reset();
+
+        // same size class
+        auto second = pool->take({110, 30}, 1);
+        EXPECT_EQ(second.get(), firstPixmap);
+        EXPECT_EQ(reuses.value() - reusesBefore, 1);
+
+        // taken already, or another size class or device pixel ratio
+        auto third = pool->take({110, 30}, 1);
+        auto fourth = pool->take({110, 30}, 2);
+        auto fifth = pool->take({200, 30}, 1);
+        EXPECT_EQ(fourth->devicePixelRatio(), 2);
+        EXPECT_EQ(fifth->size(), QSize(224, 32));
+        EXPECT_EQ(allocations.value() - allocationsBefore, 4);
+        EXPECT_EQ(reuses.value() - reusesBefore, 1);
+    });
+}
+
+TEST(PixmapPool, FreesIdlePixmapsBeyondLimit)
+{
+    runInGuiThread([] {
+        auto &allocations = DebugCount::counter("pixmap pool allocations");
+        auto pool = std::make_shared<PixmapPool>();
+
+        // bigger than MAX_IDLE_BYTES on its own
+        pool->take({4096, 4096}, 1);
+        auto allocationsBefore = allocations.value();
+        pool->take({4096, 4096}, 1);
+        EXPECT_EQ(allocations.value() - allocationsBefore, 1);
+
+        // small ones stay
+        pool->take({64, 64}, 1);
+        allocationsBefore = allocations.value();
+        pool->take({64, 64}, 1);
+        EXPECT_EQ(allocations.value() - allocationsBefore, 0);
+    });
+}
+
+TEST(PixmapPool, PixmapsOutliveTheirPool)
+{
+    runInGuiThread([] {
+        auto pool = std::make_shared<PixmapPool>();
+        auto pixmap = pool->take({64, 64}, 1);
+        pool.reset();
+
+        EXPECT_EQ(pixmap->size(), QSize(64, 64));
+        pixmap.reset();
+    });
+}
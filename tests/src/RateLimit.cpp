@@ -0,0 +1,38 @@
+#include "util/RateLimit.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+TEST(RateLimit, Window)
+{
+    RateLimit limit(3, 10s);
+    auto start = RateLimit::Clock::now();
+
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(limit.delay(start + i * 1s), 0s);
+        limit.record(start + i * 1s);
+    }
+
+    // the fourth has to wait until the first leaves the window
+    EXPECT_EQ(limit.delay(start + 3s), 7s);
+    EXPECT_EQ(limit.delay(start + 10s), 0s);
+    limit.record(start + 10s);
+
+    // the second and third are still in the window
+    EXPECT_EQ(limit.delay(start + 10s), 1s);
+}
+
+TEST(RateLimit, MinInterval)
+{
+    RateLimit limit(100, 10s, 2s);
+    auto start = RateLimit::Clock::now();
+
+    EXPECT_EQ(limit.delay(start), 0s);
+    limit.record(start);
+
+    EXPECT_EQ(limit.delay(start + 500ms), 1500ms);
+    EXPECT_EQ(limit.delay(start + 2s), 0s);
+}
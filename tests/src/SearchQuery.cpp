@@ -0,0 +1,82 @@
+#include "messages/search/SearchQuery.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+TEST(SearchQuery, ParsesTags)
+{
+    auto query = SearchQuery::parse(
+        "from:pajlada,Forsen in:#xqcow has:link on:2020-03-04 hello world");
+
+    EXPECT_EQ(query.authors, QStringList{"pajlada,Forsen"});
+    EXPECT_EQ(query.channels, QStringList{"#xqcow"});
+    EXPECT_TRUE(query.hasLink);
+    EXPECT_EQ(query.day, QDate(2020, 3, 4));
+    EXPECT_EQ(query.text, "hello world");
+}
+
+TEST(SearchQuery, KeepsUnknownTagsInText)
+{
+    auto query =
+        SearchQuery::parse("has:image on:2020-13-40 foo:bar  from:x baz");
+
+    EXPECT_EQ(query.authors, QStringList{"x"});
+    EXPECT_FALSE(query.hasLink);
+    EXPECT_FALSE(query.day.isValid());
+    EXPECT_EQ(query.text, "has:image on:2020-13-40 foo:bar baz");
+}
+
+TEST(SearchQuery, RemovesSurroundingQuotes)
+{
+    EXPECT_EQ(SearchQuery::parse("\"from:x hello\"").text, "from:x hello");
+    EXPECT_EQ(SearchQuery::parse("\"hello world\"").text, "hello world");
+    EXPECT_EQ(SearchQuery::parse("\"").text, "\"");
+    EXPECT_EQ(SearchQuery::parse("\"hello").text, "\"hello");
+}
+
+TEST(SearchQuery, NarrowsWhenTextGrows)
+{
+    auto previous = SearchQuery::parse("hel");
+
+    EXPECT_TRUE(SearchQuery::parse("hello").narrows(previous));
+    EXPECT_TRUE(SearchQuery::parse("HELLO").narrows(previous));
+    EXPECT_TRUE(SearchQuery::parse("hel").narrows(previous));
+    EXPECT_TRUE(SearchQuery::parse("from:x hello").narrows(previous));
+    EXPECT_TRUE(SearchQuery::parse("has:link hel").narrows(previous));
+    EXPECT_FALSE(SearchQuery::parse("he").narrows(previous));
+    EXPECT_FALSE(SearchQuery::parse("hallo").narrows(previous));
+
+    EXPECT_TRUE(SearchQuery::parse("a").narrows(SearchQuery::parse("")));
+    EXPECT_FALSE(SearchQuery::parse("").narrows(SearchQuery::parse("a")));
+}
+
+TEST(SearchQuery, NarrowsWhenTagsGetStricter)
+{
+    auto previous = SearchQuery::parse("from:pajlada,forsen in:#xqcow hi");
+
+    EXPECT_TRUE(SearchQuery::parse("from:Forsen in:#xqcow hi")
+                    .narrows(previous));
+    EXPECT_TRUE(SearchQuery::parse("from:forsen from:pajlada in:xqcow hi")
+                    .narrows(previous));
+    EXPECT_FALSE(SearchQuery::parse("in:#xqcow hi").narrows(previous));
+    EXPECT_FALSE(SearchQuery::parse("from:forsen hi").narrows(previous));
+    EXPECT_FALSE(SearchQuery::parse("from:forsen,nymn in:#xqcow hi")
+                     .narrows(previous));
+    EXPECT_FALSE(SearchQuery::parse("from:forsen in:#pajlada hi")
+                     .narrows(previous));
+}
+
+TEST(SearchQuery, DoesntNarrowWhenLinkOrDayChange)
+{
+    auto withLink = SearchQuery::parse("has:link hi");
+    EXPECT_FALSE(SearchQuery::parse("hi").narrows(withLink));
+    EXPECT_TRUE(SearchQuery::parse("has:link hi").narrows(withLink));
+
+    auto onDay = SearchQuery::parse("on:2020-03-04 hi");
+    EXPECT_TRUE(SearchQuery::parse("on:2020-03-04 hi").narrows(onDay));
+    EXPECT_FALSE(SearchQuery::parse("on:2020-03-05 hi").narrows(onDay));
+    EXPECT_FALSE(SearchQuery::parse("hi").narrows(onDay));
+    EXPECT_TRUE(SearchQuery::parse("on:2020-03-05 hi")
+                    .narrows(SearchQuery::parse("hi")));
+}
@@ -0,0 +1,75 @@
+#include "util/StringPool.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(StringPool, EqualStringsShareData)
+{
+    auto first = StringPool::intern(QString("pajlada"));
+    auto second = StringPool::intern(QString("pajlada"));
+    auto other = StringPool::intern(QString("forsen"));
+
+    EXPECT_EQ(first, "pajlada");
+    EXPECT_EQ(second, "pajlada");
+    EXPECT_EQ(first.constData(), second.constData());
+    EXPECT_NE(first.constData(), other.constData());
+
+    EXPECT_TRUE(StringPool::intern(QString()).isEmpty());
+    EXPECT_TRUE(StringPool::intern("").isEmpty());
+}
+
+TEST(StringPool, UnusedStringsAreSwept)
+{
+    auto &interned = DebugCount::counter("interned strings");
+    auto kept = StringPool::intern(QString("StringPool-kept"));
+
+    constexpr int count = 40000;
+    for (int i = 0; i < count; i++)
+    {
+        StringPool::intern(QString("StringPool-dropped-%1").arg(i));
+    }
+
+    // every shard of the pool is swept before it holds more than 1024 strings
+    EXPECT_LE(interned.value(), 16 * 1024);
+
+    // strings that are still used survive the sweeps
+    EXPECT_EQ(StringPool::intern(QString("StringPool-kept")).constData(),
+              kept.constData());
+}
+
+TEST(StringPool, InternFromThreads)
+{
+    constexpr int threadCount = 4;
+    constexpr int count = 1000;
+
+    std::vector<std::vector<QString>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&results, t] {
+            for (int i = 0; i < count; i++)
+            {
+                results[t].push_back(
+                    StringPool::intern(QString("StringPool-shared-%1").arg(i)));
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 1; t < threadCount; t++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            ASSERT_EQ(results[t][i].constData(), results[0][i].constData());
+        }
+    }
+}
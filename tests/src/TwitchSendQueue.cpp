@@ -0,0 +1,136 @@
+#include "providers/twitch/TwitchSendQueue.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = TwitchSendQueue::Clock;
+
+TwitchSendQueue::Message message(uint64_t id, const QString &channelName,
+                                 bool interactive = false,
+                                 bool highRateLimit = false)
+{
+    TwitchSendQueue::Message message;
+    message.id = id;
+    message.channelName = channelName;
+    message.text = QString::number(id);
+    message.highRateLimit = highRateLimit;
+    message.interactive = interactive;
+    message.queuedAt = Clock::now();
+    return message;
+}
+
+std::vector<uint64_t> ids(const std::vector<TwitchSendQueue::Message> &sent)
+{
+    std::vector<uint64_t> ids;
+    for (const auto &message : sent)
+    {
+        ids.push_back(message.id);
+    }
+    return ids;
+}
+
+}  // namespace
+
+TEST(TwitchSendQueue, ChannelInterval)
+{
+    TwitchSendQueue queue;
+    auto now = Clock::now();
+    Clock::duration next;
+
+    queue.push(message(0, "a"));
+    queue.push(message(1, "a"));
+    queue.push(message(2, "b"));
+
+    // the second message of a waits for the interval, b doesn't wait for it
+    EXPECT_EQ(ids(queue.takeReady(now, next)), (std::vector<uint64_t>{0, 2}));
+    EXPECT_EQ(next, 1100ms);
+    EXPECT_TRUE(queue.contains(1));
+
+    EXPECT_TRUE(queue.takeReady(now + 1s, next).empty());
+    EXPECT_EQ(ids(queue.takeReady(now + 1100ms, next)),
+              (std::vector<uint64_t>{1}));
+    EXPECT_EQ(next, Clock::duration::max());
+    EXPECT_EQ(queue.size(), 0U);
+}
+
+TEST(TwitchSendQueue, KeepsChannelOrder)
+{
+    TwitchSendQueue queue;
+    auto now = Clock::now();
+    Clock::duration next;
+
+    queue.push(message(0, "a"));
+    EXPECT_EQ(ids(queue.takeReady(now, next)), (std::vector<uint64_t>{0}));
+
+    // 1 waits for a, 2 must not overtake it, 3 may
+    queue.push(message(1, "a"));
+    queue.push(message(2, "a"));
+    queue.push(message(3, "b"));
+    EXPECT_EQ(ids(queue.takeReady(now + 100ms, next)),
+              (std::vector<uint64_t>{3}));
+
+    EXPECT_EQ(ids(queue.takeReady(now + 1100ms, next)),
+              (std::vector<uint64_t>{1}));
+    EXPECT_EQ(ids(queue.takeReady(now + 2200ms, next)),
+              (std::vector<uint64_t>{2}));
+}
+
+TEST(TwitchSendQueue, InteractiveFirst)
+{
+    TwitchSendQueue queue;
+    auto now = Clock::now();
+    Clock::duration next;
+
+    queue.push(message(0, "a"));
+    queue.push(message(1, "a", true));
+
+    EXPECT_EQ(ids(queue.takeReady(now, next)), (std::vector<uint64_t>{1}));
+    EXPECT_EQ(ids(queue.takeReady(now + 1100ms, next)),
+              (std::vector<uint64_t>{0}));
+}
+
+TEST(TwitchSendQueue, Window)
+{
+    TwitchSendQueue queue;
+    auto now = Clock::now();
+    Clock::duration next;
+
+    // 19 messages per 32 seconds, unless the user is a moderator
+    for (uint64_t i = 0; i < 20; i++)
+    {
+        queue.push(message(i, QString::number(i)));
+    }
+    queue.push(message(20, "mod", false, true));
+
+    auto sent = ids(queue.takeReady(now, next));
+    EXPECT_EQ(sent.size(), 20U);
+    EXPECT_TRUE(queue.contains(19));
+    EXPECT_FALSE(queue.contains(20));
+    EXPECT_EQ(next, 32s);
+
+    EXPECT_TRUE(queue.takeReady(now + 31s, next).empty());
+    EXPECT_EQ(ids(queue.takeReady(now + 32s, next)),
+              (std::vector<uint64_t>{19}));
+}
+
+TEST(TwitchSendQueue, QueueFull)
+{
+    TwitchSendQueue queue;
+
+    for (uint64_t i = 0; i < TwitchSendQueue::MAX_SIZE; i++)
+    {
+        EXPECT_TRUE(queue.push(message(i, "a")));
+    }
+    EXPECT_FALSE(queue.push(message(100, "b", true)));
+    EXPECT_EQ(queue.size(), TwitchSendQueue::MAX_SIZE);
+
+    queue.removeIf([](const auto &message) {
+        return message.id % 2 == 0;
+    });
+    EXPECT_EQ(queue.size(), TwitchSendQueue::MAX_SIZE / 2);
+    EXPECT_TRUE(queue.push(message(100, "b", true)));
+}
@@ -0,0 +1,80 @@
+#include "common/UserColorCache.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+TEST(UserColorCache, SetAndGet)
+{
+    UserColorCache cache;
+
+    EXPECT_FALSE(cache.get("pajlada").isValid());
+
+    cache.set("pajlada", QColor(255, 0, 0));
+    EXPECT_EQ(cache.get("pajlada"), QColor(255, 0, 0));
+    EXPECT_EQ(cache.size(), 1U);
+
+    cache.set("pajlada", QColor(0, 0, 255));
+    EXPECT_EQ(cache.get("pajlada"), QColor(0, 0, 255));
+    EXPECT_EQ(cache.size(), 1U);
+}
+
+TEST(UserColorCache, CaseInsensitive)
+{
+    UserColorCache cache;
+
+    cache.set("Pajlada", QColor(0, 0, 0));
+    EXPECT_EQ(cache.get("pajlada"), QColor(0, 0, 0));
+    EXPECT_EQ(cache.get("PAJLADA"), QColor(0, 0, 0));
+}
+
+TEST(UserColorCache, InvalidColorRemoves)
+{
+    UserColorCache cache;
+
+    cache.set("pajlada", QColor(255, 0, 0));
+    cache.set("pajlada", QColor());
+    EXPECT_FALSE(cache.get("pajlada").isValid());
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST(UserColorCache, Bounded)
+{
+    UserColorCache cache(64);
+    EXPECT_EQ(cache.capacity(), 64U);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        cache.set(QString("user%1").arg(i), QColor(i % 256, 0, 0));
+    }
+    EXPECT_LE(cache.size(), 64U);
+
+    // the last user is always kept
+    EXPECT_EQ(cache.get("user999"), QColor(999 % 256, 0, 0));
+}
+
+TEST(UserColorCache, GrowsUpToTheBound)
+{
+    UserColorCache cache(1024);
+    EXPECT_EQ(cache.capacity(), UserColorCache::INITIAL_CAPACITY);
+
+    for (int i = 0; i < 200; i++)
+    {
+        cache.set(QString("user%1").arg(i), QColor(i % 256, 0, 0));
+    }
+    EXPECT_GT(cache.capacity(), UserColorCache::INITIAL_CAPACITY);
+    EXPECT_LE(cache.capacity(), 1024U);
+
+    // nothing had to be evicted while there was room to grow
+    for (int i = 0; i < 200; i++)
+    {
+        EXPECT_EQ(cache.get(QString("user%1").arg(i)), QColor(i % 256, 0, 0));
+    }
+
+    for (int i = 200; i < 5000; i++)
+    {
+        cache.set(QString("user%1").arg(i), QColor(i % 256, 0, 0));
+    }
+    EXPECT_EQ(cache.capacity(), 1024U);
+    EXPECT_LE(cache.size(), 1024U);
+}
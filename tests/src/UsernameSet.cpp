@@ -159,3 +159,45 @@ TEST(UsernameSet, CollisionTest)
     }
 }
 
+TEST(UsernameSet, DiffAndApply)
+{
+    chatterino::UsernameSet set;
+
+    set.insert("Chancu");
+    set.insert("chief_tony");
+    set.insert("pajlada");
+    set.insert("randers");
+
+    // sorted, "chancu" only differs in case
+    std::vector<QString> names{"chancu", "ChatAbuser", "mullo2500",
+                               "pajlada"};
+
+    auto diff = set.diff(names);
+    EXPECT_EQ(diff.joined, (std::vector<QString>{"ChatAbuser", "mullo2500"}));
+    EXPECT_EQ(diff.parted, (std::vector<QString>{"chief_tony", "randers"}));
+
+    set.apply(std::move(diff));
+
+    EXPECT_EQ(set.size(), 4);
+    EXPECT_TRUE(set.contains("Chancu"));
+    EXPECT_FALSE(set.contains("chief_tony"));
+    EXPECT_FALSE(set.contains("randers"));
+
+    {
+        QStringList result;
+        QStringList expectation{"Chancu", "ChatAbuser"};
+        auto subrange = set.subrange(QString("ch"));
+        std::copy(subrange.begin(), subrange.end(), std::back_inserter(result));
+        EXPECT_EQ(expectation, result);
+    }
+
+    {
+        QStringList result;
+        auto subrange = set.subrange(QString("ra"));
+        std::copy(subrange.begin(), subrange.end(), std::back_inserter(result));
+        EXPECT_TRUE(result.isEmpty());
+    }
+
+    EXPECT_TRUE(set.diff(names).joined.empty());
+    EXPECT_TRUE(set.diff(names).parted.empty());
+}
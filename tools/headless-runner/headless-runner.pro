@@ -0,0 +1,14 @@
+# Runs the message pipeline of chatterino without any windows, see main.cpp.
+# Build it with chatterino-headless.pro from the root of the repository, or
+# pass the directory containing chatterino-core with CHATTERINO_CORE_DIR.
+
+CONFIG += console link_chatterino_core
+CONFIG -= app_bundle
+
+TARGET = headless-runner
+TEMPLATE = app
+
+include(../../chatterino.pri)
+
+SOURCES += \
+    main.cpp
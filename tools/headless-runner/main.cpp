@@ -0,0 +1,212 @@
+// Runs the message pipeline of chatterino (irc connection, message handling
+// and building, channels, logging, highlights and filters) without any
+// windows. It joins the given channels, processes their messages and prints
+// the throughput and memory usage, which makes soak tests and profiling with
+// perf or heaptrack possible on machines without a display.
+//
+// Example, against tools/replay-server:
+//   headless-runner --server 127.0.0.1:6667 --insecure --offline \
+//       --channels replay1,replay2 --report report.json --duration 600
+
+#include "Application.hpp"
+#include "common/Channel.hpp"
+#include "common/NetworkManager.hpp"
+#include "debug/LoadTest.hpp"
+#include "debug/MemoryReport.hpp"
+#include "debug/MessageLatency.hpp"
+#include "providers/IvrApi.hpp"
+#include "providers/twitch/TwitchIrcServer.hpp"
+#include "providers/twitch/api/Helix.hpp"
+#include "providers/twitch/api/Kraken.hpp"
+#include "singletons/Paths.hpp"
+#include "singletons/Resources.hpp"
+#include "singletons/Settings.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+    void print(const QString &text)
+    {
+        static QTextStream stream(stdout);
+        stream << text << '\n';
+        stream.flush();
+    }
+
+    QString megabytes(int64_t bytes)
+    {
+        if (bytes < 0)
+        {
+            return "?";
+        }
+        return QString::number(double(bytes) / (1024 * 1024), 'f', 1) + " MiB";
+    }
+
+    // Env reads these once, they have to be set before anything uses it
+    void applyServerOptions(const QCommandLineParser &parser)
+    {
+        if (parser.isSet("server"))
+        {
+            auto server = parser.value("server");
+            auto colon = server.lastIndexOf(':');
+            qputenv("CHATTERINO2_TWITCH_SERVER_HOST",
+                    server.left(colon).toUtf8());
+            if (colon != -1)
+            {
+                qputenv("CHATTERINO2_TWITCH_SERVER_PORT",
+                        server.mid(colon + 1).toUtf8());
+            }
+        }
+        if (parser.isSet("insecure"))
+        {
+            qputenv("CHATTERINO2_TWITCH_SERVER_SECURE", "false");
+        }
+        if (parser.isSet("offline"))
+        {
+            qputenv("CHATTERINO2_OFFLINE", "true");
+        }
+    }
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    // nothing is shown, but building messages needs fonts and pixmaps
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    // keeps the settings apart from the ones of the app
+    QCoreApplication::setApplicationName("chatterino-headless");
+
+    Q_INIT_RESOURCE(resources);
+    Q_INIT_RESOURCE(resources_autogenerated);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Runs the message pipeline of chatterino without any windows and "
+        "prints the throughput and memory usage.");
+    parser.addHelpOption();
+    parser.addOption({"channels", "Twitch channels to join.",
+                      "channel1,channel2,..."});
+    parser.addOption(
+        {"server", "Twitch irc server, irc.chat.twitch.tv:443 by default.",
+         "host:port"});
+    parser.addOption({"insecure", "Connect to the server without TLS."});
+    parser.addOption(
+        {"offline", "Don't make any requests besides the irc connection."});
+    parser.addOption(
+        {"duration", "Quit after the given amount of seconds.", "seconds"});
+    parser.addOption(
+        {"report",
+         "Write a load test report to the given file when quitting, see "
+         "--load-test of chatterino. Runs for 60 seconds unless --duration is "
+         "given.",
+         "file"});
+    parser.addOption(
+        {"interval", "Print the stats every given seconds, 10 by default.",
+         "seconds"});
+    parser.process(app);
+
+    applyServerOptions(parser);
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    auto channelNames = parser.value("channels").split(
+        QRegularExpression("[,;]"), Qt::SkipEmptyParts);
+#else
+    auto channelNames = parser.value("channels").split(
+        QRegularExpression("[,;]"), QString::SkipEmptyParts);
+#endif
+    if (channelNames.isEmpty())
+    {
+        print("No channels to join, see --help");
+        return 1;
+    }
+
+    IvrApi::initialize();
+    Helix::initialize();
+    Kraken::initialize();
+    NetworkManager::init();
+
+    Paths *paths{};
+    try
+    {
+        paths = new Paths;
+    }
+    catch (std::runtime_error &error)
+    {
+        print(error.what());
+        return 1;
+    }
+
+    Settings settings(paths->settingsDirectory);
+    initResources();
+
+    Application chatterino(settings, *paths);
+    chatterino.initializeHeadless(settings, *paths);
+
+    // channels are only kept alive as long as someone holds them
+    std::vector<ChannelPtr> channels;
+    for (const auto &name : channelNames)
+    {
+        channels.push_back(chatterino.twitch2->getOrAddChannel(name));
+    }
+    chatterino.twitch2->connect();
+
+    auto &received = DebugCount::counter("twitch irc messages received");
+    auto &messages = DebugCount::counter("messages");
+    auto interval = parser.isSet("interval")
+                        ? std::max(1, parser.value("interval").toInt())
+                        : 10;
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    auto lastReceived = received.value();
+
+    QTimer statsTimer;
+    QObject::connect(&statsTimer, &QTimer::timeout, [&] {
+        auto total = received.value();
+        print(QString("%1 s: %2 messages/s, %3 received, %4 alive, %5 "
+                      "resident")
+                  .arg(elapsed.elapsed() / 1000)
+                  .arg(double(total - lastReceived) / interval, 0, 'f', 0)
+                  .arg(total)
+                  .arg(messages.value())
+                  .arg(megabytes(MemoryReport::residentBytes())));
+        lastReceived = total;
+    });
+    statsTimer.start(interval * 1000);
+
+    auto duration = std::max(1, parser.value("duration").toInt());
+    if (parser.isSet("report"))
+    {
+        LoadTest::start(parser.value("report"),
+                        parser.isSet("duration") ? duration : 60);
+    }
+    else if (parser.isSet("duration"))
+    {
+        QTimer::singleShot(duration * 1000, &app, &QCoreApplication::quit);
+    }
+
+    app.exec();
+
+    print(MemoryReport::getText());
+    print(MessageLatency::getText());
+
+    NetworkManager::deinit();
+
+    // like the app, don't wait for the singletons to be destroyed
+    std::_Exit(0);
+}
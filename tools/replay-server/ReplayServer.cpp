@@ -0,0 +1,474 @@
+#include "ReplayServer.hpp"
+
+#include <QDateTime>
+#include <QFile>
+#include <QTcpSocket>
+#include <QTextStream>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+namespace chatterino {
+namespace {
+    constexpr int REPLAY_INTERVAL = 10;
+    // lines for clients that can't keep up are dropped beyond this
+    constexpr qint64 MAX_PENDING_BYTES = 16 * 1024 * 1024;
+    constexpr int SYNTHETIC_CORPUS_SIZE = 5000;
+
+    void print(const QString &text)
+    {
+        static QTextStream stream(stdout);
+        stream << text << '\n';
+        stream.flush();
+    }
+
+    // the word after the command if it is a channel, e.g.
+    // "@tags :prefix PRIVMSG #channel :text"
+    int channelStart(const QByteArray &line)
+    {
+        int index = 0;
+        if (line.startsWith('@'))
+        {
+            index = line.indexOf(' ') + 1;
+            if (index == 0)
+            {
+                return -1;
+            }
+        }
+        if (index < line.size() && line[index] == ':')
+        {
+            index = line.indexOf(' ', index) + 1;
+            if (index == 0)
+            {
+                return -1;
+            }
+        }
+
+        // skip the command
+        index = line.indexOf(' ', index);
+        if (index == -1 || index + 1 >= line.size() || line[index + 1] != '#')
+        {
+            return -1;
+        }
+        return index + 2;
+    }
+
+    // Cuts the value of the tmi-sent-ts tag out of the tags, returns where it
+    // was or -1
+    int cutSentAt(QByteArray &line)
+    {
+        static const QByteArray tag("tmi-sent-ts=");
+
+        if (!line.startsWith('@'))
+        {
+            return -1;
+        }
+        auto tagsEnd = line.indexOf(' ');
+        if (tagsEnd == -1)
+        {
+            tagsEnd = line.size();
+        }
+
+        auto index = line.indexOf(tag);
+        while (index != -1 && line[index - 1] != ';' && line[index - 1] != '@')
+        {
+            index = line.indexOf(tag, index + 1);
+        }
+        if (index == -1 || index > tagsEnd)
+        {
+            return -1;
+        }
+
+        auto start = index + tag.size();
+        auto end = line.indexOf(';', start);
+        if (end == -1 || end > tagsEnd)
+        {
+            end = tagsEnd;
+        }
+        line.remove(start, end - start);
+        return start;
+    }
+}  // namespace
+
+ReplayServer::CorpusLine::CorpusLine(QByteArray beforeChannel,
+                                     QByteArray afterChannel)
+    : beforeChannel(std::move(beforeChannel))
+    , afterChannel(std::move(afterChannel))
+    , sentAtIndex(cutSentAt(this->beforeChannel))
+{
+}
+
+struct ReplayServer::Client {
+    QTcpSocket *socket;
+    QByteArray nick = "justinfan";
+    QByteArray buffer;
+    QList<QByteArray> channels;
+    QByteArray pending;
+
+    void send(const QByteArray &line)
+    {
+        this->socket->write(line + "\r\n");
+    }
+};
+
+ReplayServer::ReplayServer(Options options, QObject *parent)
+    : QObject(parent)
+    , options_(std::move(options))
+{
+    QObject::connect(&this->server_, &QTcpServer::newConnection, this,
+                     [this] {
+                         this->acceptClients();
+                     });
+
+    this->replayTimer_.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&this->replayTimer_, &QTimer::timeout, this, [this] {
+        this->replay();
+    });
+    QObject::connect(&this->statsTimer_, &QTimer::timeout, this, [this] {
+        this->printStats();
+    });
+}
+
+ReplayServer::~ReplayServer() = default;
+
+bool ReplayServer::start()
+{
+    if (this->options_.corpusFiles.isEmpty())
+    {
+        this->generateCorpus();
+    }
+    else if (!this->loadCorpus())
+    {
+        return false;
+    }
+
+    if (!this->server_.listen(QHostAddress::LocalHost, this->options_.port))
+    {
+        print(QString("Unable to listen on port %1: %2")
+                  .arg(this->options_.port)
+                  .arg(this->server_.errorString()));
+        return false;
+    }
+
+    print(QString("Replaying %1 lines at %2 lines/s on port %3")
+              .arg(this->corpus_.size())
+              .arg(this->options_.rate)
+              .arg(this->options_.port));
+
+    this->elapsed_.start();
+    this->replayTimer_.start(REPLAY_INTERVAL);
+    this->statsTimer_.start(1000);
+    return true;
+}
+
+bool ReplayServer::loadCorpus()
+{
+    for (const auto &path : this->options_.corpusFiles)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            print("Unable to open " + path);
+            return false;
+        }
+
+        while (!file.atEnd())
+        {
+            auto line = file.readLine().trimmed();
+            auto start = channelStart(line);
+            if (start == -1)
+            {
+                continue;
+            }
+
+            auto end = line.indexOf(' ', start);
+            if (end == -1)
+            {
+                end = line.size();
+            }
+            this->corpus_.emplace_back(line.left(start), line.mid(end));
+        }
+    }
+
+    if (this->corpus_.empty())
+    {
+        print("The corpus doesn't contain any channel messages");
+        return false;
+    }
+    return true;
+}
+
+void ReplayServer::generateCorpus()
+{
+    // fixed seed, every run replays the same messages
+    std::mt19937 random(4);
+
+    const QList<QByteArray> words{
+        "hello", "chat", "LUL", "Kappa", "PogChamp", "what", "is", "this",
+        "game", "nice", "play", "@streamer", "www.example.com", "xD", "gg",
+        "KEKW", "monkaS", "widepeepoHappy", "the", "clip", "it", "5Head"};
+    const QList<QByteArray> badges{"", "subscriber/12", "moderator/1",
+                                   "vip/1", "premium/1", "bits/1000"};
+
+    auto pick = [&random](int count) {
+        return int(std::uniform_int_distribution<>(0, count - 1)(random));
+    };
+
+    for (int i = 0; i < SYNTHETIC_CORPUS_SIZE; i++)
+    {
+        auto user = "user" + QByteArray::number(pick(2000));
+
+        QByteArray text;
+        QByteArray emotes;
+        int wordCount = 1 + pick(15);
+        for (int w = 0; w < wordCount; w++)
+        {
+            const auto &word = words[pick(words.size())];
+            if (!text.isEmpty())
+            {
+                text += ' ';
+            }
+            if (word == "Kappa")
+            {
+                emotes += QByteArray(emotes.isEmpty() ? "25:" : ",") +
+                          QByteArray::number(text.size()) + "-" +
+                          QByteArray::number(text.size() + word.size() - 1);
+            }
+            text += word;
+        }
+
+        auto tags = "@badge-info=;badges=" + badges[pick(badges.size())] +
+                    ";color=#" + QByteArray::number(pick(0xffffff), 16) +
+                    ";display-name=" + user + ";emotes=" + emotes +
+                    ";flags=;id=replay-" + QByteArray::number(i) +
+                    ";mod=0;room-id=1;subscriber=0;tmi-sent-ts=;turbo=0"
+                    ";user-id=" +
+                    QByteArray::number(i) + ";user-type=";
+
+        this->corpus_.emplace_back(tags + " :" + user + "!" + user + "@" +
+                                       user + ".tmi.twitch.tv PRIVMSG #",
+                                   " :" + text);
+    }
+}
+
+void ReplayServer::acceptClients()
+{
+    while (auto *socket = this->server_.nextPendingConnection())
+    {
+        auto client = std::make_unique<Client>();
+        client->socket = socket;
+        auto *raw = client.get();
+
+        QObject::connect(socket, &QTcpSocket::readyRead, this, [this, raw] {
+            this->readLines(*raw);
+        });
+        QObject::connect(socket, &QTcpSocket::disconnected, this,
+                         [this, socket] {
+                             this->removeClient(socket);
+                         });
+
+        this->clients_.push_back(std::move(client));
+    }
+}
+
+void ReplayServer::removeClient(QTcpSocket *socket)
+{
+    this->clients_.erase(
+        std::remove_if(this->clients_.begin(), this->clients_.end(),
+                       [socket](const auto &client) {
+                           return client->socket == socket;
+                       }),
+        this->clients_.end());
+    socket->deleteLater();
+}
+
+void ReplayServer::readLines(Client &client)
+{
+    client.buffer += client.socket->readAll();
+
+    int end;
+    while ((end = client.buffer.indexOf('\n')) != -1)
+    {
+        auto line = client.buffer.left(end).trimmed();
+        client.buffer.remove(0, end + 1);
+
+        if (!line.isEmpty())
+        {
+            this->handleLine(client, line);
+        }
+    }
+}
+
+void ReplayServer::handleLine(Client &client, const QByteArray &line)
+{
+    auto space = line.indexOf(' ');
+    auto command = line.left(space).toUpper();
+    auto params = space == -1 ? QByteArray() : line.mid(space + 1);
+
+    if (command == "CAP")
+    {
+        if (params.startsWith("LS"))
+        {
+            client.send(":tmi.twitch.tv CAP * LS :twitch.tv/membership "
+                        "twitch.tv/tags twitch.tv/commands");
+        }
+        else if (params.startsWith("REQ"))
+        {
+            client.send(":tmi.twitch.tv CAP * ACK " + params.mid(4));
+        }
+    }
+    else if (command == "NICK")
+    {
+        client.nick = params.toLower();
+        for (const auto &welcome :
+             {"001 " + client.nick + " :Welcome, GLHF!",
+              "002 " + client.nick + " :Your host is tmi.twitch.tv",
+              "003 " + client.nick + " :This server is rather new",
+              "004 " + client.nick + " :-", "375 " + client.nick + " :-",
+              "372 " + client.nick + " :You are in a maze of twisty passages",
+              "376 " + client.nick + " :>"})
+        {
+            client.send(":tmi.twitch.tv " + welcome);
+        }
+    }
+    else if (command == "JOIN")
+    {
+        for (const auto &target : params.split(','))
+        {
+            auto channel = target.trimmed();
+            if (!channel.startsWith('#') || client.channels.contains(channel))
+            {
+                continue;
+            }
+            client.channels.push_back(channel);
+
+            auto prefix = ":" + client.nick + "!" + client.nick + "@" +
+                          client.nick + ".tmi.twitch.tv";
+            client.send(prefix + " JOIN " + channel);
+            client.send(":" + client.nick + ".tmi.twitch.tv 353 " +
+                        client.nick + " = " + channel + " :" + client.nick);
+            client.send(":" + client.nick + ".tmi.twitch.tv 366 " +
+                        client.nick + " " + channel + " :End of /NAMES list");
+            client.send("@emote-only=0;followers-only=-1;r9k=0;rituals=0;"
+                        "room-id=1;slow=0;subs-only=0 :tmi.twitch.tv "
+                        "ROOMSTATE " +
+                        channel);
+        }
+    }
+    else if (command == "PART")
+    {
+        for (const auto &target : params.split(','))
+        {
+            auto channel = target.trimmed();
+            client.channels.removeAll(channel);
+            client.send(":" + client.nick + "!" + client.nick + "@" +
+                        client.nick + ".tmi.twitch.tv PART " + channel);
+        }
+    }
+    else if (command == "PING")
+    {
+        client.send(":tmi.twitch.tv PONG tmi.twitch.tv " + params);
+    }
+    else if (command == "PRIVMSG")
+    {
+        client.send("@badge-info=;badges=;color=;display-name=" + client.nick +
+                    ";emote-sets=0;mod=0;subscriber=0;user-type= "
+                    ":tmi.twitch.tv USERSTATE " +
+                    params.left(params.indexOf(' ')));
+    }
+}
+
+void ReplayServer::replay()
+{
+    auto now = this->elapsed_.elapsed();
+    auto due = this->carry_ +
+               double(this->options_.rate) * (now - this->lastReplay_) / 1000;
+    this->lastReplay_ = now;
+
+    // don't make up for more than a second after a stall
+    due = std::min(due, double(this->options_.rate));
+    auto count = qint64(due);
+    this->carry_ = due - double(count);
+
+    std::vector<std::pair<Client *, QByteArray>> channels;
+    for (const auto &client : this->clients_)
+    {
+        for (const auto &channel : client->channels)
+        {
+            channels.emplace_back(client.get(), channel);
+        }
+    }
+    if (channels.empty())
+    {
+        this->carry_ = 0;
+        return;
+    }
+
+    // every line is stamped with the time it is sent at
+    auto sentAt = QByteArray::number(QDateTime::currentMSecsSinceEpoch());
+
+    for (qint64 i = 0; i < count; i++)
+    {
+        const auto &line = this->corpus_[this->nextLine_++ %
+                                         this->corpus_.size()];
+        const auto &target =
+            channels[this->nextChannel_++ % channels.size()];
+
+        auto *client = target.first;
+        if (client->socket->bytesToWrite() + client->pending.size() >
+            MAX_PENDING_BYTES)
+        {
+            this->dropped_++;
+            continue;
+        }
+
+        const auto &before = line.beforeChannel;
+        if (line.sentAtIndex == -1)
+        {
+            client->pending += before;
+        }
+        else
+        {
+            client->pending.append(before.constData(), line.sentAtIndex);
+            client->pending += sentAt;
+            client->pending.append(before.constData() + line.sentAtIndex,
+                                   before.size() - line.sentAtIndex);
+        }
+        client->pending += target.second.mid(1) + line.afterChannel + "\r\n";
+        this->sent_++;
+    }
+
+    for (const auto &client : this->clients_)
+    {
+        if (!client->pending.isEmpty())
+        {
+            client->socket->write(client->pending);
+            client->pending.clear();
+        }
+    }
+}
+
+void ReplayServer::printStats()
+{
+    int channelCount = 0;
+    for (const auto &client : this->clients_)
+    {
+        channelCount += client->channels.size();
+    }
+
+    auto text = QString("sent %1 lines/s to %2 channels of %3 clients")
+                    .arg(this->sent_)
+                    .arg(channelCount)
+                    .arg(this->clients_.size());
+    if (this->dropped_ > 0)
+    {
+        text += QString(", dropped %1 lines").arg(this->dropped_);
+    }
+    print(text);
+
+    this->sent_ = 0;
+    this->dropped_ = 0;
+}
+
+}  // namespace chatterino
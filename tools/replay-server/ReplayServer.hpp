@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QTcpServer>
+#include <QTimer>
+
+#include <memory>
+#include <vector>
+
+class QTcpSocket;
+
+namespace chatterino {
+
+// ReplayServer is a stand-in for the twitch irc servers. It accepts any
+// login, answers the requests chatterino makes while connecting and joining
+// and replays a corpus of raw irc lines into the joined channels at a fixed
+// rate.
+// The channel of every corpus line is replaced with one of the joined
+// channels, in turn, so any corpus can be spread across any amount of
+// channels. The tmi-sent-ts tag is set to the time the line is sent, which
+// keeps the latencies measured by the client meaningful.
+class ReplayServer : public QObject
+{
+public:
+    struct Options {
+        quint16 port = 6667;
+        // lines per second over all channels
+        int rate = 1000;
+        // files with one raw irc line each, a synthetic corpus is generated
+        // if this is empty
+        QStringList corpusFiles;
+    };
+
+    explicit ReplayServer(Options options, QObject *parent = nullptr);
+    ~ReplayServer() override;
+
+    bool start();
+
+private:
+    struct Client;
+
+    // a corpus line split around its channel
+    struct CorpusLine {
+        CorpusLine(QByteArray beforeChannel, QByteArray afterChannel);
+
+        QByteArray beforeChannel;
+        QByteArray afterChannel;
+        // where the value of tmi-sent-ts was cut out of beforeChannel, -1 if
+        // the line doesn't have one
+        int sentAtIndex = -1;
+    };
+
+    bool loadCorpus();
+    void generateCorpus();
+
+    void acceptClients();
+    void readLines(Client &client);
+    void handleLine(Client &client, const QByteArray &line);
+    void removeClient(QTcpSocket *socket);
+
+    void replay();
+    void printStats();
+
+    Options options_;
+    QTcpServer server_;
+    std::vector<std::unique_ptr<Client>> clients_;
+
+    std::vector<CorpusLine> corpus_;
+    size_t nextLine_ = 0;
+    size_t nextChannel_ = 0;
+
+    QTimer replayTimer_;
+    QElapsedTimer elapsed_;
+    qint64 lastReplay_ = 0;
+    // fraction of a line that was due in the last tick
+    double carry_ = 0;
+
+    QTimer statsTimer_;
+    qint64 sent_ = 0;
+    qint64 dropped_ = 0;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,57 @@
+#include "ReplayServer.hpp"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTimer>
+
+#include <algorithm>
+
+using namespace chatterino;
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Stand-in for the twitch irc servers which replays recorded irc lines "
+        "into the joined channels.");
+    parser.addHelpOption();
+    parser.addOption({"port", "Port to listen on, 6667 by default.", "port"});
+    parser.addOption(
+        {"rate", "Lines per second over all channels, 1000 by default.",
+         "lines"});
+    parser.addOption(
+        {"duration", "Quit after the given amount of seconds.", "seconds"});
+    parser.addPositionalArgument(
+        "corpus",
+        "Files with one raw irc line per line. A synthetic corpus is used if "
+        "none are given.",
+        "[corpus...]");
+    parser.process(app);
+
+    ReplayServer::Options options;
+    if (parser.isSet("port"))
+    {
+        options.port = parser.value("port").toUShort();
+    }
+    if (parser.isSet("rate"))
+    {
+        options.rate = std::max(1, parser.value("rate").toInt());
+    }
+    options.corpusFiles = parser.positionalArguments();
+
+    ReplayServer server(options);
+    if (!server.start())
+    {
+        return 1;
+    }
+
+    if (parser.isSet("duration"))
+    {
+        QTimer::singleShot(parser.value("duration").toInt() * 1000, &app,
+                           &QCoreApplication::quit);
+    }
+
+    return app.exec();
+}
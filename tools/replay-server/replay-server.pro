@@ -0,0 +1,17 @@
+# Stand-in for the twitch irc servers used for load tests, see
+# tools/run-load-test.sh
+
+QT -= gui
+QT += network
+
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+TARGET = replay-server
+
+SOURCES += \
+    main.cpp \
+    ReplayServer.cpp
+
+HEADERS += \
+    ReplayServer.hpp
@@ -0,0 +1,45 @@
+#!/bin/bash
+
+# Runs chatterino against the local replay server and prints the load test
+# report. Nothing but the twitch irc connection reaches the network.
+#
+# Usage: run-load-test.sh <chatterino> <replay-server> [rate] [channels] [seconds] [corpus...]
+# Example: run-load-test.sh ./bin/chatterino ./tools/replay-server/replay-server 5000 20 60
+
+set -eu
+
+if [ "$#" -lt 2 ]; then
+    echo "Usage: $0 <chatterino> <replay-server> [rate] [channels] [seconds] [corpus...]"
+    exit 1
+fi
+
+chatterino="$1"
+replay_server="$2"
+rate="${3:-1000}"
+channel_count="${4:-10}"
+duration="${5:-60}"
+shift $(( $# < 5 ? $# : 5 ))
+
+port="${REPLAY_PORT:-6667}"
+report="${REPORT:-load-test-report.json}"
+
+channels=""
+for i in $(seq 1 "$channel_count"); do
+    channels="${channels}t:replay${i};"
+done
+
+"$replay_server" --port "$port" --rate "$rate" "$@" &
+server_pid=$!
+trap 'kill "$server_pid" 2>/dev/null || true' EXIT
+
+# give the server a moment to start listening
+sleep 1
+
+CHATTERINO2_TWITCH_SERVER_HOST=127.0.0.1 \
+CHATTERINO2_TWITCH_SERVER_PORT="$port" \
+CHATTERINO2_TWITCH_SERVER_SECURE=false \
+CHATTERINO2_OFFLINE=true \
+    "$chatterino" --channels "${channels%;}" \
+    --load-test "$report" --load-test-duration "$duration"
+
+cat "$report"
@@ -5,12 +5,13 @@ import re
 import subprocess
 
 dir_path = os.path.dirname(os.path.realpath(__file__))
-filename = 'chatterino.pro'
+# everything but src/main.cpp, which only chatterino.pro builds
+filename = 'chatterino-sources.pri'
 data = ""
 
 with open(filename, 'r') as project:
     data = project.read()
-    sources_list = subprocess.getoutput("find ./src -type f -regex '.*\.cpp' | sed 's_\./_    _g'").splitlines()
+    sources_list = subprocess.getoutput("find ./src -type f -regex '.*\.cpp' ! -path ./src/main.cpp | sed 's_\./_    _g'").splitlines()
     sources_list.sort(key=str.lower)
     sources = "\n".join(sources_list)
     sources = re.sub(r'$', r' \\\\', sources, flags=re.MULTILINE)